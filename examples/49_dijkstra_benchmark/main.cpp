@@ -0,0 +1,155 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/dijkstra.h>
+#include <cinolib/dijkstra_engine.h>
+#include <cinolib/indexed_heap.h>
+#include <chrono>
+#include <queue>
+#include <set>
+
+// Compares the priority queues one can use to compute exhaustive
+// Dijkstra distances from many seeds on the same mesh
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// priority update as erase + insert in a balanced tree
+void dijkstra_set(const Trimesh<> & m, const uint source, std::vector<double> & dist)
+{
+    dist.assign(m.num_verts(), inf_double);
+    dist[source] = 0.0;
+    std::set<std::pair<double,uint>> q;
+    q.insert(std::make_pair(0.0,source));
+    while(!q.empty())
+    {
+        uint vid = q.begin()->second;
+        q.erase(q.begin());
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist[vid] + m.vert(vid).dist(m.vert(nbr));
+            if(dist[nbr] > new_dist)
+            {
+                if(dist[nbr] < inf_double) q.erase(std::make_pair(dist[nbr],nbr));
+                dist[nbr] = new_dist;
+                q.insert(std::make_pair(new_dist,nbr));
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// priority update as insertion of a new copy (stale copies skipped when popped)
+void dijkstra_lazy(const Trimesh<> & m, const uint source, std::vector<double> & dist)
+{
+    typedef std::pair<double,uint> Entry;
+    dist.assign(m.num_verts(), inf_double);
+    dist[source] = 0.0;
+    std::priority_queue<Entry,std::vector<Entry>,std::greater<Entry>> q;
+    q.push(std::make_pair(0.0,source));
+    while(!q.empty())
+    {
+        Entry e = q.top();
+        q.pop();
+        uint vid = e.second;
+        if(e.first > dist[vid]) continue; // stale copy
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist[vid] + m.vert(vid).dist(m.vert(nbr));
+            if(dist[nbr] > new_dist)
+            {
+                dist[nbr] = new_dist;
+                q.push(std::make_pair(new_dist,nbr));
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// priority update in place, on a D-ary heap allocated once and reused
+template<uint D>
+void dijkstra_heap(const Trimesh<> & m, const uint source, std::vector<double> & dist, IndexedHeap<D> & q)
+{
+    dist.assign(m.num_verts(), inf_double);
+    dist[source] = 0.0;
+    q.clear();
+    q.push(source,0.0);
+    while(!q.empty())
+    {
+        uint vid = q.pop();
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist[vid] + m.vert(vid).dist(m.vert(nbr));
+            if(dist[nbr] > new_dist)
+            {
+                dist[nbr] = new_dist;
+                q.push_or_decrease(nbr,new_dist);
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+double seconds(const F & f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint n_seeds  = (argc>2) ? atoi(argv[2]) : 100;
+
+    Trimesh<> m(s.c_str());
+
+    std::vector<uint> seeds(n_seeds);
+    for(uint i=0; i<n_seeds; ++i) seeds[i] = uint((uint64_t(i)*m.num_verts())/n_seeds);
+
+    // all variants must return the same distances
+    std::vector<double> ref, dist;
+    double checksum = 0;
+
+    auto check = [&](const char *name, const double t)
+    {
+        std::cout << "  " << name << "\t" << t << "s\t(" << 1000.0*t/n_seeds << "ms per seed)";
+        if(dist!=ref) std::cout << "\tWRONG RESULTS";
+        std::cout << std::endl;
+    };
+
+    std::cout << "\n" << n_seeds << " exhaustive Dijkstra from " << m.num_verts() << " verts\n" << std::endl;
+
+    double t = seconds([&]{ for(uint v : seeds) { dijkstra_set(m,v,dist); checksum+=dist.back(); } });
+    ref = dist;
+    check("std::set           ", t);
+
+    t = seconds([&]{ for(uint v : seeds) { dijkstra_lazy(m,v,dist); checksum+=dist.back(); } });
+    check("std::priority_queue", t);
+
+    IndexedHeap<2> q2(m.num_verts());
+    IndexedHeap<4> q4(m.num_verts());
+    IndexedHeap<8> q8(m.num_verts());
+    t = seconds([&]{ for(uint v : seeds) { dijkstra_heap(m,v,dist,q2); checksum+=dist.back(); } });
+    check("IndexedHeap<2>     ", t);
+    t = seconds([&]{ for(uint v : seeds) { dijkstra_heap(m,v,dist,q4); checksum+=dist.back(); } });
+    check("IndexedHeap<4>     ", t);
+    t = seconds([&]{ for(uint v : seeds) { dijkstra_heap(m,v,dist,q8); checksum+=dist.back(); } });
+    check("IndexedHeap<8>     ", t);
+
+    t = seconds([&]{ for(uint v : seeds) { dijkstra_exhaustive(m,v,dist); checksum+=dist.back(); } });
+    check("dijkstra_exhaustive", t);
+
+    DijkstraEngine engine(m.num_verts());
+    t = seconds([&]{ for(uint v : seeds) { engine.run(m,{v}); engine.copy_dist(dist); checksum+=dist.back(); } });
+    check("DijkstraEngine     ", t);
+
+    std::cout << "\n(checksum " << checksum << ")\n" << std::endl;
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/QEM_decimation.h>
+#include <cinolib/subdivision_1_to_4.h>
+#include <cinolib/octree.h>
+#include <chrono>
+
+// Decimates a (possibly refined) triangle mesh with the quadric error metric,
+// comparing the serial and parallel collapse schemes in terms of running time
+// and distance between the input and the decimated surface
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+double seconds(const F & f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s   = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint min_polys  = (argc>2) ? atoi(argv[2]) : 1000000; // refine the input until it has at least this many triangles
+    uint target     = (argc>3) ? atoi(argv[3]) : 10000;
+
+    Trimesh<> input(s.c_str());
+    while(input.num_polys()<min_polys) subdivision_1_to_4(input);
+
+    std::vector<vec3d> samples = input.vector_verts();
+    std::cout << "\ndecimating " << input.num_polys() << " triangles down to " << target << "\n" << std::endl;
+
+    for(bool parallel : {false, true})
+    {
+        Trimesh<> m = input;
+        QEMDecimationOptions opt;
+        opt.target_polys = target;
+        opt.parallel     = parallel;
+
+        uint n_collapses = 0;
+        double t = seconds([&]{ n_collapses = QEM_decimation(m,opt); });
+
+        // one sided distance from the input vertices to the decimated surface
+        Octree octree;
+        octree.build_from_mesh_polys(m);
+        double avg = 0, max = 0;
+        for(const vec3d & p : samples)
+        {
+            double d = p.dist(octree.closest_point(p));
+            avg += d;
+            max  = std::max(max,d);
+        }
+        avg /= samples.size();
+        double diag = input.bbox().diag();
+
+        std::cout << "  " << (parallel ? "parallel" : "serial  ") << "\t" << t << "s\t("
+                  << 1e6*t/n_collapses << "us per collapse)\t"
+                  << m.num_polys() << " triangles\t"
+                  << "avg/max distance " << avg/diag << "/" << max/diag << " (bbox diagonal units)" << std::endl;
+    }
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/subdivision_1_to_4.h>
+#include <cinolib/octree.h>
+#include <cinolib/vector_serialization.h>
+#include <chrono>
+
+// Measures the cost of the basic 3D vector operations on large meshes: per
+// vertex normals, octree construction and a normal accumulation kernel run
+// on both vec3d and a replica of the former vec3d layout, which carried a
+// vtable pointer. Build the *_no_simd target to compare against the generic
+// (non SSE2) kernels
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a vec3d plus the vtable pointer added by a virtual destructor (former layout)
+struct LegacyVec3 : public vec3d
+{
+    LegacyVec3() {}
+    LegacyVec3(const vec3d & v) : vec3d(v) {}
+    virtual ~LegacyVec3() {}
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// accumulates (unnormalized) triangle normals at vertices
+template<class Vec>
+void accumulate_normals(const std::vector<Vec>  & verts,
+                        const std::vector<uint> & tris,
+                              std::vector<Vec>  & normals)
+{
+    normals.assign(verts.size(), Vec(vec3d(0,0,0)));
+    for(uint i=0; i<tris.size(); i+=3)
+    {
+        const Vec & a = verts[tris[i  ]];
+        const Vec & b = verts[tris[i+1]];
+        const Vec & c = verts[tris[i+2]];
+        vec3d n = (b-a).cross(c-a);
+        normals[tris[i  ]] += n;
+        normals[tris[i+1]] += n;
+        normals[tris[i+2]] += n;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+double seconds(const F & f, const uint n_runs)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for(uint i=0; i<n_runs; ++i) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()/n_runs;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s  = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint min_polys = (argc>2) ? atoi(argv[2]) : 1000000; // refine the input until it has at least this many triangles
+    uint n_runs    = (argc>3) ? atoi(argv[3]) : 5;
+
+    Trimesh<> m(s.c_str());
+    while(m.num_polys()<min_polys) subdivision_1_to_4(m);
+
+#ifdef CINOLIB_NO_SIMD
+    std::cout << "\ngeneric kernels (CINOLIB_NO_SIMD)";
+#else
+    std::cout << "\nSSE2 kernels";
+#endif
+    std::cout << ", " << m.num_verts() << " verts, " << m.num_polys() << " triangles, average of " << n_runs << " runs\n" << std::endl;
+
+    std::cout << "  sizeof(vec3d)      \t" << sizeof(vec3d)      << " bytes" << std::endl;
+    std::cout << "  sizeof(LegacyVec3) \t" << sizeof(LegacyVec3) << " bytes\n" << std::endl;
+
+    double t = seconds([&]{ m.update_normals(); }, n_runs);
+    std::cout << "  update_normals     \t" << t << "s" << std::endl;
+
+    t = seconds([&]{ Octree o; o.build_from_mesh_polys(m); }, n_runs);
+    std::cout << "  Octree::build      \t" << t << "s" << std::endl;
+
+    std::vector<uint> tris = serialized_vids_from_polys(m.vector_polys());
+    std::vector<vec3d> verts = m.vector_verts(), normals;
+    std::vector<LegacyVec3> legacy_verts, legacy_normals;
+    for(const vec3d & p : verts) legacy_verts.emplace_back(p);
+
+    t = seconds([&]{ accumulate_normals(verts, tris, normals); }, n_runs);
+    std::cout << "  normals (vec3d)    \t" << t << "s" << std::endl;
+
+    double t_legacy = seconds([&]{ accumulate_normals(legacy_verts, tris, legacy_normals); }, n_runs);
+    std::cout << "  normals (legacy)   \t" << t_legacy << "s" << std::endl;
+
+    t = seconds([&]{ std::vector<vec3d> copy(verts); }, n_runs);
+    std::cout << "  copy verts (vec3d) \t" << t << "s" << std::endl;
+
+    t_legacy = seconds([&]{ std::vector<LegacyVec3> copy(legacy_verts); }, n_runs);
+    std::cout << "  copy verts (legacy)\t" << t_legacy << "s\n" << std::endl;
+
+    return 0;
+}
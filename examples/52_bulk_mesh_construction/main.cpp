@@ -0,0 +1,98 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/subdivision_1_to_4.h>
+#include <chrono>
+
+// Compares the two ways polygon mesh connectivity can be built: in bulk, as
+// done by the mesh constructors, and incrementally, with a poly_add for each
+// polygon. The test runs on a (refined) input mesh, and on a triangle fan with
+// a single vertex shared by all triangles (plus some duplicated triangles)
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best of a few runs, to factor out the cost of page faults on freshly allocated memory
+template<class F>
+double seconds(const F & f, const uint n_runs = 3)
+{
+    double best = inf_double;
+    for(uint i=0; i<n_runs; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1-t0).count());
+    }
+    return best;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void compare(const char                           * name,
+             const std::vector<vec3d>             & verts,
+             const std::vector<std::vector<uint>> & polys)
+{
+    // silence the warnings for duplicated polygons
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+
+    Trimesh<> bulk;
+    double t_bulk = seconds([&]{ bulk = Trimesh<>(verts,polys); });
+
+    Trimesh<> incr;
+    double t_incr = seconds([&]
+    {
+        incr = Trimesh<>();
+        for(const vec3d & p : verts) incr.vert_add(p);
+        for(const auto  & p : polys) incr.poly_add(p);
+        incr.update_v_normals();
+    });
+
+    std::cout.rdbuf(buf);
+
+    // the two paths must produce the very same mesh (same element ids too)
+    bool same = (bulk.vector_polys()==incr.vector_polys() && bulk.vector_edges()==incr.vector_edges());
+    for(uint pid=0; same && pid<bulk.num_polys(); ++pid)
+    {
+        same = std::equal(bulk.adj_p2e(pid).begin(), bulk.adj_p2e(pid).end(), incr.adj_p2e(pid).begin()) &&
+               std::equal(bulk.adj_p2p(pid).begin(), bulk.adj_p2p(pid).end(), incr.adj_p2p(pid).begin());
+    }
+
+    std::cout << "  " << name << "\t" << bulk.num_polys() << " polys\t"
+              << "bulk "        << t_bulk << "s\t"
+              << "incremental " << t_incr << "s\t"
+              << "speedup "     << t_incr/t_bulk << "x";
+    if(!same) std::cout << "\tDIFFERENT MESHES";
+    std::cout << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s  = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint min_polys = (argc>2) ? atoi(argv[2]) : 1000000; // refine the input until it has at least this many triangles
+    uint fan_size  = (argc>3) ? atoi(argv[3]) : 10000; 
+
+    Trimesh<> m(s.c_str());
+    while(m.num_polys()<min_polys) subdivision_1_to_4(m);
+
+    std::cout << std::endl;
+    compare("input mesh", m.vector_verts(), m.vector_polys());
+
+    // a fan of triangles around the origin, with every tenth triangle repeated twice
+    std::vector<vec3d> verts(1, vec3d(0,0,0));
+    std::vector<std::vector<uint>> polys;
+    for(uint i=0; i<fan_size; ++i)
+    {
+        double a = 2.0*M_PI*i/fan_size;
+        verts.push_back(vec3d(cos(a), sin(a), 0));
+    }
+    for(uint i=0; i<fan_size; ++i)
+    {
+        polys.push_back({0, 1+i, 1+(i+1)%fan_size});
+        if(i%10==0) polys.push_back(polys.back());
+    }
+    compare("fan       ", verts, polys);
+    std::cout << std::endl;
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/3d_printing/overhangs.h>
+#include <cinolib/find_intersections.h>
+#include <cinolib/voxelize.h>
+#include <cinolib/octree.h>
+#include <cinolib/parallel_for.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+#include <cinolib/ambient_occlusion.h>
+#endif
+
+// Runs the library functions that use PARALLEL_FOR and PARALLEL_REDUCE both in
+// parallel and serially, and checks that they produce the same output. The
+// program is built with ThreadSanitizer (see CMakeLists.txt), which reports any
+// data race it observes on stderr. To stress the thread pool on machines with
+// few cores, run it on a large mesh and/or repeat the tests a few times
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a PARALLEL_FOR called from inside the body of another parallel loop is executed
+// serially, hence running f as the body of a parallel loop serializes all its loops
+template<class F>
+void serially(const F & f)
+{
+    PARALLEL_FOR(0, 2, 0, [&](const uint i)
+    {
+        if(i==0) f();
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+bool same_as_serial(const char * name, const F & f)
+{
+    auto par = f();
+    decltype(par) ser;
+    serially([&](){ ser = f(); });
+    bool ok = (par==ser);
+    std::cout << "  " << name << (ok ? " OK" : " MISMATCH") << std::endl;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint n_runs   = (argc>2) ? atoi(argv[2]) : 3;
+
+    // input mesh, plus a shifted copy of itself to have plenty of intersections
+    Trimesh<> tmp(s.c_str());
+    std::vector<vec3d> verts = tmp.vector_verts();
+    std::vector<uint>  tris  = serialized_vids_from_polys(tmp.vector_polys());
+    vec3d shift = tmp.bbox().delta() * 0.1;
+    for(uint vid=0; vid<tmp.num_verts(); ++vid) verts.push_back(tmp.vert(vid) + shift);
+    for(uint i=0, n=tris.size(); i<n; ++i) tris.push_back(tris.at(i) + tmp.num_verts());
+    Trimesh<> m(verts, tris);
+    std::cout << m.num_verts() << " verts, " << m.num_polys() << " polys" << std::endl;
+
+    // ray and closest point queries, sampled on a grid covering the bounding box
+    std::vector<vec3d> p, d;
+    AABB box = m.bbox();
+    for(uint i=0; i<64; ++i)
+    for(uint j=0; j<64; ++j)
+    {
+        p.push_back(box.min + vec3d(box.delta().x()*i/63.0, box.delta().y()*j/63.0, -box.delta().z()));
+        d.push_back(vec3d(0,0,1));
+    }
+
+    bool ok = true;
+    for(uint run=0; run<n_runs; ++run)
+    {
+        std::cout << "run " << run << std::endl;
+
+        ok &= same_as_serial("PARALLEL_REDUCE", [&]()
+        {
+            return PARALLEL_REDUCE(0, m.num_verts(), 1000, AABB(), [&](const uint vid, AABB & acc)
+            {
+                acc.push(m.vert(vid));
+            },
+            [](AABB b0, const AABB & b1)
+            {
+                // note: b0.push(b1) would break if b1 is empty (i.e. min=inf, max=-inf)
+                b0.min = b0.min.min(b1.min);
+                b0.max = b0.max.max(b1.max);
+                return b0;
+            }).delta();
+        });
+
+        ok &= same_as_serial("Octree", [&]()
+        {
+            Octree o;
+            o.build_from_mesh_polys(m);
+            std::vector<double> min_t;
+            std::vector<uint>   ids;
+            o.intersects_rays(p, d, {}, min_t, ids);
+            for(const vec3d & q : p) ids.push_back(o.closest_point(q).dist(q) < 1e-3 ? 1 : 0);
+            return std::make_pair(min_t, ids);
+        });
+
+        ok &= same_as_serial("overhangs", [&]()
+        {
+            std::vector<uint> polys_hanging;
+            overhangs(m, 45.f, vec3d(0,1,0), polys_hanging);
+            return polys_hanging;
+        });
+
+        ok &= same_as_serial("overhangs (with supports)", [&]()
+        {
+            std::vector<std::pair<uint,uint>> polys_hanging;
+            overhangs(m, 45.f, vec3d(0,1,0), polys_hanging);
+            return polys_hanging;
+        });
+
+        ok &= same_as_serial("find_intersections", [&]()
+        {
+            std::set<ipair> intersections;
+            find_intersections(m, intersections);
+            return intersections;
+        });
+
+        ok &= same_as_serial("voxelize", [&]()
+        {
+            VoxelGrid g;
+            voxelize(m, 64, g);
+            return std::vector<int>(g.voxels, g.voxels + g.dim[0]*g.dim[1]*g.dim[2]);
+        });
+
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+        ok &= same_as_serial("ambient_occlusion", [&]()
+        {
+            AO_data data;
+            ambient_occlusion(m, data);
+            std::vector<float> ao(m.num_polys());
+            for(uint pid=0; pid<m.num_polys(); ++pid) ao.at(pid) = m.poly_data(pid).AO;
+            return ao;
+        });
+#endif
+    }
+
+    std::cout << (ok ? "all outputs match" : "some outputs differ") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
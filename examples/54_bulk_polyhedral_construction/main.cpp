@@ -0,0 +1,170 @@
+#include <cinolib/meshes/meshes.h>
+#include <chrono>
+#include <random>
+
+// Compares the two ways polyhedral mesh connectivity can be built: in bulk, as
+// done by the mesh constructors, and incrementally, with a poly_add for each
+// element (which looks for its faces with face_id). The test runs on a grid of
+// jittered cubes, split into tetrahedra or kept as hexahedra, and on the same
+// hexahedra given as a general polyhedral mesh (list of faces + polys as lists
+// of faces with winding)
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best of a few runs, to factor out the cost of page faults on freshly allocated memory
+template<class F>
+double seconds(const F & f, const uint n_runs = 3)
+{
+    double best = inf_double;
+    for(uint i=0; i<n_runs; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1-t0).count());
+    }
+    return best;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the two paths must produce the very same mesh (same element ids too)
+template<class Mesh>
+bool same_mesh(const Mesh & a, const Mesh & b)
+{
+    if(a.vector_faces()!=b.vector_faces() || a.vector_edges()!=b.vector_edges() || a.num_polys()!=b.num_polys()) return false;
+    for(uint pid=0; pid<a.num_polys(); ++pid)
+    {
+        if(a.adj_p2f(pid)!=b.adj_p2f(pid) ||
+           a.adj_p2v(pid)!=b.adj_p2v(pid) ||
+           a.adj_p2e(pid)!=b.adj_p2e(pid) ||
+           a.adj_p2p(pid)!=b.adj_p2p(pid) ||
+           a.poly_faces_winding(pid)!=b.poly_faces_winding(pid)) return false;
+    }
+    for(uint fid=0; fid<a.num_faces(); ++fid)
+    {
+        if(a.adj_f2e(fid)!=b.adj_f2e(fid) || a.adj_f2p(fid)!=b.adj_f2p(fid)) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+void report(const char * name, const Mesh & bulk, const Mesh & incr, const double t_bulk, const double t_incr)
+{
+    std::cout << "  " << name << "\t" << bulk.num_polys() << " polys\t"
+              << "bulk "        << t_bulk << "s\t"
+              << "incremental " << t_incr << "s\t"
+              << "speedup "     << t_incr/t_bulk << "x";
+    if(!same_mesh(bulk,incr)) std::cout << "\tDIFFERENT MESHES";
+    std::cout << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys given as lists of vertices (tets, hexas)
+template<class Mesh>
+void compare(const char                           * name,
+             const std::vector<vec3d>             & verts,
+             const std::vector<std::vector<uint>> & polys)
+{
+    // silence the logs printed by the mesh constructors
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+
+    Mesh bulk;
+    double t_bulk = seconds([&]{ bulk = Mesh(verts,polys); });
+
+    Mesh incr;
+    double t_incr = seconds([&]
+    {
+        incr = Mesh();
+        for(const vec3d & p : verts) incr.vert_add(p);
+        for(const auto  & p : polys) incr.poly_add(p);
+        incr.update_v_normals();
+    });
+
+    std::cout.rdbuf(buf);
+    report(name, bulk, incr, t_bulk, t_incr);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polys given as lists of faces, with winding
+void compare(const char                           * name,
+             const std::vector<vec3d>             & verts,
+             const std::vector<std::vector<uint>> & faces,
+             const std::vector<std::vector<uint>> & polys,
+             const std::vector<std::vector<bool>> & winding)
+{
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+
+    Polyhedralmesh<> bulk;
+    double t_bulk = seconds([&]{ bulk = Polyhedralmesh<>(verts,faces,polys,winding); });
+
+    Polyhedralmesh<> incr;
+    double t_incr = seconds([&]
+    {
+        incr = Polyhedralmesh<>();
+        for(const vec3d & p : verts) incr.vert_add(p);
+        for(const auto  & f : faces) incr.face_add(f);
+        for(uint pid=0; pid<polys.size(); ++pid) incr.poly_add(polys.at(pid), winding.at(pid));
+        incr.update_v_normals();
+    });
+
+    std::cout.rdbuf(buf);
+    report(name, bulk, incr, t_bulk, t_incr);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    uint n = (argc>1) ? atoi(argv[1]) : 30; // number of cubes per side
+
+    // grid of (n+1)^3 vertices, randomly displaced so that no two elements are alike
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> jitter(-0.2,0.2);
+    std::vector<vec3d> verts;
+    for(uint i=0; i<=n; ++i)
+    for(uint j=0; j<=n; ++j)
+    for(uint k=0; k<=n; ++k)
+    {
+        verts.push_back(vec3d(i+jitter(rng), j+jitter(rng), k+jitter(rng)));
+    }
+    auto vid = [n](const uint i, const uint j, const uint k) { return (i*(n+1)+j)*(n+1)+k; };
+
+    std::vector<std::vector<uint>> hexas, tets;
+    for(uint i=0; i<n; ++i)
+    for(uint j=0; j<n; ++j)
+    for(uint k=0; k<n; ++k)
+    {
+        uint c[8] = { vid(i,j,k),   vid(i+1,j,k),   vid(i+1,j+1,k),   vid(i,j+1,k),
+                      vid(i,j,k+1), vid(i+1,j,k+1), vid(i+1,j+1,k+1), vid(i,j+1,k+1) };
+        hexas.push_back(std::vector<uint>(c,c+8));
+        // six tets around the diagonal 0-6
+        uint t[6][4] = {{0,1,2,6},{0,2,3,6},{0,3,7,6},{0,7,4,6},{0,4,5,6},{0,5,1,6}};
+        for(auto & tet : t) tets.push_back({c[tet[0]], c[tet[1]], c[tet[2]], c[tet[3]]});
+    }
+
+    std::cout << std::endl;
+    compare<Tetmesh<>>("tetmesh       ", verts, tets);
+    compare<Hexmesh<>>("hexmesh       ", verts, hexas);
+
+    // the same hexahedra, as a general polyhedral mesh
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+    Hexmesh<> h(verts, hexas);
+    std::cout.rdbuf(buf);
+    std::vector<std::vector<uint>> polys(h.num_polys());
+    std::vector<std::vector<bool>> winding(h.num_polys());
+    for(uint pid=0; pid<h.num_polys(); ++pid)
+    {
+        polys.at(pid)   = h.adj_p2f(pid);
+        winding.at(pid) = h.poly_faces_winding(pid);
+    }
+    compare("polyhedralmesh", h.vector_verts(), h.vector_faces(), polys, winding);
+    std::cout << std::endl;
+    return 0;
+}
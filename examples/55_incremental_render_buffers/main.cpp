@@ -0,0 +1,138 @@
+#include <cinolib/meshes/meshes.h>
+#include <chrono>
+#include <functional>
+#include <random>
+
+// Drawable surface meshes can regenerate only the portion of their render buffers
+// affected by a change (see the mark_dirty_* methods). For a few typical edits,
+// this program checks that the buffers obtained with an incremental update are
+// identical to the ones obtained rebuilding them from scratch, and compares the
+// time taken by the two. No window is opened: the buffers are generated on the
+// CPU and never uploaded to the GPU, hence the program runs headless
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best of a few runs, to factor out the cost of page faults on freshly allocated memory
+template<class F>
+double seconds(const F & f, const uint n_runs = 3)
+{
+    double best = inf_double;
+    for(uint i=0; i<n_runs; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1-t0).count());
+    }
+    return best;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+bool same_buffers(const DrawableTrimesh<> & a, const DrawableTrimesh<> & b)
+{
+    return a.drawlist.tris         == b.drawlist.tris         &&
+           a.drawlist.tri_coords   == b.drawlist.tri_coords   &&
+           a.drawlist.tri_v_norms  == b.drawlist.tri_v_norms  &&
+           a.drawlist.tri_v_colors == b.drawlist.tri_v_colors &&
+           a.drawlist.tri_text     == b.drawlist.tri_text     &&
+           a.drawlist.segs         == b.drawlist.segs         &&
+           a.drawlist.seg_coords   == b.drawlist.seg_coords   &&
+           a.drawlist.seg_colors   == b.drawlist.seg_colors   &&
+           static_cast<const std::vector<vec3d>&>(a.marked_edges) ==
+           static_cast<const std::vector<vec3d>&>(b.marked_edges);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// edit changes the mesh and records what it did with the mark_dirty_* methods.
+// Only the update is timed, not the edit, and the best of a few runs is taken
+bool compare(const char * name, DrawableTrimesh<> & m, const std::function<void()> & edit)
+{
+    double t_incr = inf_double;
+    for(uint i=0; i<3; ++i)
+    {
+        edit();
+        t_incr = std::min(t_incr, seconds([&]{ m.updateGL(); }, 1));
+    }
+
+    DrawableTrimesh<> full = m;
+    double t_full = seconds([&]{ full.updateGL_mesh(); full.updateGL_marked(); });
+
+    bool ok = same_buffers(m, full);
+    std::cout << "  " << name << "\t"
+              << "incremental " << t_incr << "s\t"
+              << "full "        << t_full << "s\t"
+              << "speedup "     << t_full/t_incr << "x"
+              << (ok ? "" : "\tDIFFERENT BUFFERS") << std::endl;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+    DrawableTrimesh<> m(s.c_str());
+    std::cout.rdbuf(buf);
+    std::cout << std::endl << m.num_verts() << " verts, " << m.num_polys() << " polys" << std::endl;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> rnd(0.f,1.f);
+    std::uniform_int_distribution<uint>   rnd_vid(0, m.num_verts()-1);
+    std::uniform_int_distribution<uint>   rnd_pid(0, m.num_polys()-1);
+
+    // mark a few edges, so that marked edges are regenerated and compared too
+    for(uint eid=0; eid<m.num_edges(); eid+=50) m.edge_data(eid).flags[MARKED] = true;
+    m.updateGL();
+
+    bool ok = true;
+
+    ok &= compare("poly colors     ", m, [&]
+    {
+        for(uint pid=0; pid<m.num_polys(); ++pid) m.poly_data(pid).color = Color(rnd(rng), rnd(rng), rnd(rng));
+        m.mark_dirty_colors();
+    });
+
+    ok &= compare("ambient occlusion", m, [&]
+    {
+        m.AO_alpha = rnd(rng);
+        m.mark_dirty_colors();
+    });
+
+    ok &= compare("a few polys     ", m, [&]
+    {
+        std::vector<uint> pids;
+        for(uint i=0; i<10; ++i) pids.push_back(rnd_pid(rng));
+        for(uint pid : pids) m.poly_data(pid).color = Color(rnd(rng), rnd(rng), rnd(rng));
+        m.mark_dirty_polys(pids);
+    });
+
+    ok &= compare("a few verts     ", m, [&]
+    {
+        std::vector<uint> vids;
+        double delta = m.edge_avg_length()*0.1;
+        for(uint i=0; i<10; ++i) vids.push_back(rnd_vid(rng));
+        for(uint vid : vids) m.vert(vid) += vec3d(delta*rnd(rng), delta*rnd(rng), delta*rnd(rng));
+        for(uint vid : vids) for(uint pid : m.adj_v2p(vid)) m.update_p_normal(pid);
+        for(uint vid : vids) for(uint pid : m.adj_v2p(vid)) for(uint nbr : m.adj_p2v(pid)) m.update_v_normal(nbr);
+        m.mark_dirty_verts(vids);
+    });
+
+    // alternate between two slices, otherwise repeated updates have nothing to do
+    bool flip = false;
+    ok &= compare("slicing         ", m, [&]
+    {
+        double x = m.bbox().center().x() + (flip ? 0.1 : -0.1) * m.bbox().delta_x();
+        for(uint pid=0; pid<m.num_polys(); ++pid) m.poly_data(pid).flags[HIDDEN] = m.poly_centroid(pid).x() > x;
+        m.mark_dirty_visibility();
+        flip = !flip;
+    });
+
+    std::cout << (ok ? "all buffers match" : "some buffers differ") << std::endl << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
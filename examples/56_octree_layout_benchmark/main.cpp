@@ -0,0 +1,285 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/octree.h>
+#include <cinolib/geometry/triangle.h>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+
+// Compares the Octree with the layout it had before items were stored by value
+// and nodes were flattened into a single array. The previous layout is replicated
+// below (PointerOctree): each node is a separate heap allocation that owns the
+// list of its item indices, and each item is a separate heap allocation too,
+// accessed through virtual calls. The two trees are built on the same triangles,
+// and queried for closest points and first hits along rays. Results must match
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best of a few runs, to factor out the cost of page faults on freshly allocated memory
+template<class F>
+double seconds(const F & f, const uint n_runs = 3)
+{
+    double best = inf_double;
+    for(uint i=0; i<n_runs; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1-t0).count());
+    }
+    return best;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct PointerNode
+{
+    PointerNode(const AABB & bbox) : bbox(bbox) {}
+   ~PointerNode() { for(auto c : children) delete c; }
+    AABB              bbox;
+    std::vector<uint> item_indices;
+    PointerNode      *children[8] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+    bool              is_inner() const { return children[0]!=nullptr; }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class PointerOctree
+{
+    public:
+
+        PointerOctree(const uint max_depth = 7, const uint items_per_leaf = 50)
+        : max_depth(max_depth), items_per_leaf(items_per_leaf) {}
+
+       ~PointerOctree()
+        {
+            delete root;
+            for(auto it : items) delete it;
+        }
+
+        void push_triangle(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2)
+        {
+            items.push_back(new Triangle(id,v0,v1,v2));
+        }
+
+        void build()
+        {
+            root = new PointerNode(AABB());
+            root->item_indices.resize(items.size());
+            std::iota(root->item_indices.begin(), root->item_indices.end(), 0);
+            for(auto it : items) root->bbox.push(it->aabb);
+            root->bbox.scale(1.5);
+            if(root->item_indices.size()<items_per_leaf || max_depth==1) return;
+            subdivide(root);
+            if(max_depth==2) return;
+
+            // as the previous implementation did, each octant is refined by its own thread
+            PARALLEL_FOR(0, 8, 0, [&](uint i)
+            {
+                std::queue<std::pair<PointerNode*,uint>> splitlist;
+                if(root->children[i]->item_indices.size()>items_per_leaf) splitlist.push(std::make_pair(root->children[i],2));
+                while(!splitlist.empty())
+                {
+                    PointerNode *node  = splitlist.front().first;
+                    uint         depth = splitlist.front().second + 1;
+                    splitlist.pop();
+                    subdivide(node);
+                    for(auto c : node->children)
+                    {
+                        if(depth<max_depth && c->item_indices.size()>items_per_leaf) splitlist.push(std::make_pair(c,depth));
+                    }
+                }
+            });
+        }
+
+        void subdivide(PointerNode *node)
+        {
+            vec3d min = node->bbox.min;
+            vec3d max = node->bbox.max;
+            vec3d avg = node->bbox.center();
+            node->children[0] = new PointerNode(AABB(vec3d(min[0], min[1], min[2]), vec3d(avg[0], avg[1], avg[2])));
+            node->children[1] = new PointerNode(AABB(vec3d(avg[0], min[1], min[2]), vec3d(max[0], avg[1], avg[2])));
+            node->children[2] = new PointerNode(AABB(vec3d(avg[0], avg[1], min[2]), vec3d(max[0], max[1], avg[2])));
+            node->children[3] = new PointerNode(AABB(vec3d(min[0], avg[1], min[2]), vec3d(avg[0], max[1], avg[2])));
+            node->children[4] = new PointerNode(AABB(vec3d(min[0], min[1], avg[2]), vec3d(avg[0], avg[1], max[2])));
+            node->children[5] = new PointerNode(AABB(vec3d(avg[0], min[1], avg[2]), vec3d(max[0], avg[1], max[2])));
+            node->children[6] = new PointerNode(AABB(vec3d(avg[0], avg[1], avg[2]), vec3d(max[0], max[1], max[2])));
+            node->children[7] = new PointerNode(AABB(vec3d(min[0], avg[1], avg[2]), vec3d(avg[0], max[1], max[2])));
+            for(uint it : node->item_indices)
+            {
+                for(auto c : node->children)
+                {
+                    if(c->bbox.intersects_box(items.at(it)->aabb)) c->item_indices.push_back(it);
+                }
+            }
+            node->item_indices.clear();
+            node->item_indices.shrink_to_fit();
+        }
+
+        struct Obj
+        {
+            double             dist  = inf_double;
+            const PointerNode *node  = nullptr;
+            int                index = -1;
+            vec3d              pos;
+            bool operator>(const Obj & o) const { return dist > o.dist; }
+        };
+        typedef std::priority_queue<Obj,std::vector<Obj>,std::greater<Obj>> PrioQueue;
+
+        // the queries follow the very same steps of the Octree ones, only the data layout differs
+
+        double closest_point_dist_sqrd(const vec3d & p) const
+        {
+            PrioQueue q;
+            Obj obj;
+            obj.node = root;
+            obj.dist = root->bbox.dist_sqrd(p);
+            q.push(obj);
+            while(q.top().node->is_inner())
+            {
+                const PointerNode *node = q.top().node;
+                q.pop();
+                for(auto c : node->children)
+                {
+                    if(c->is_inner())
+                    {
+                        Obj obj;
+                        obj.node = c;
+                        obj.dist = c->bbox.dist_sqrd(p);
+                        q.push(obj);
+                    }
+                    else for(uint index : c->item_indices)
+                    {
+                        Obj obj;
+                        obj.node  = c;
+                        obj.index = index;
+                        obj.pos   = items.at(index)->point_closest_to(p);
+                        obj.dist  = obj.pos.dist_sqrd(p);
+                        q.push(obj);
+                    }
+                }
+            }
+            return q.top().dist;
+        }
+
+        bool intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const
+        {
+            vec3d  pos;
+            double t;
+            if(!root->bbox.intersects_ray(p, dir, t, pos)) return false;
+            PrioQueue q;
+            Obj obj;
+            obj.node = root;
+            obj.dist = t;
+            q.push(obj);
+            while(!q.empty() && q.top().node->is_inner())
+            {
+                const PointerNode *node = q.top().node;
+                q.pop();
+                for(auto c : node->children)
+                {
+                    if(!c->bbox.intersects_ray(p, dir, t, pos)) continue;
+                    if(c->is_inner())
+                    {
+                        Obj obj;
+                        obj.node = c;
+                        obj.dist = t;
+                        q.push(obj);
+                    }
+                    else for(uint index : c->item_indices)
+                    {
+                        if(!items.at(index)->intersects_ray(p, dir, t, pos)) continue;
+                        Obj obj;
+                        obj.node  = c;
+                        obj.index = index;
+                        obj.dist  = t;
+                        q.push(obj);
+                    }
+                }
+            }
+            if(q.empty()) return false;
+            min_t = q.top().dist;
+            id    = items.at(q.top().index)->id;
+            return true;
+        }
+
+        uint max_depth;
+        uint items_per_leaf;
+        PointerNode *root = nullptr;
+        std::vector<SpatialDataStructureItem*> items;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void report(const char * name, const double t_old, const double t_new)
+{
+    std::cout << "  " << name << "\t"
+              << "previous layout " << t_old << "s\t"
+              << "current layout "  << t_new << "s\t"
+              << "speedup "         << t_old/t_new << "x" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    std::string s  = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    uint n_queries = (argc>2) ? atoi(argv[2]) : 100000;
+
+    std::streambuf *buf = std::cout.rdbuf(nullptr);
+    Trimesh<> m(s.c_str());
+    std::cout.rdbuf(buf);
+    std::cout << std::endl << m.num_polys() << " triangles, " << n_queries << " queries" << std::endl;
+
+    // build each tree a few times, and keep the last one for the queries
+    std::unique_ptr<PointerOctree> o_old;
+    std::unique_ptr<Octree>        o_new;
+    double t_old = seconds([&]
+    {
+        o_old.reset(new PointerOctree());
+        for(uint pid=0; pid<m.num_polys(); ++pid) o_old->push_triangle(pid, m.poly_vert(pid,0), m.poly_vert(pid,1), m.poly_vert(pid,2));
+        o_old->build();
+    });
+    double t_new = seconds([&]
+    {
+        o_new.reset(new Octree());
+        o_new->build_from_mesh_polys(m);
+    });
+    report("build        ", t_old, t_new);
+
+    // query points sampled in the (slightly enlarged) bounding box,
+    // and rays shot from them towards the center of the mesh
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> rnd(-0.1,1.1);
+    AABB box = m.bbox();
+    std::vector<vec3d> p(n_queries), dir(n_queries);
+    for(uint i=0; i<n_queries; ++i)
+    {
+        p[i]   = box.min + vec3d(rnd(rng)*box.delta_x(), rnd(rng)*box.delta_y(), rnd(rng)*box.delta_z());
+        dir[i] = box.center() - p[i];
+        dir[i].normalize();
+    }
+
+    std::vector<double> d_old(n_queries), d_new(n_queries);
+    t_old = seconds([&]{ for(uint i=0; i<n_queries; ++i) d_old[i] = o_old->closest_point_dist_sqrd(p[i]); }, 1);
+    t_new = seconds([&]
+    {
+        uint   id;
+        vec3d  pos;
+        for(uint i=0; i<n_queries; ++i) o_new->closest_point(p[i], id, pos, d_new[i]);
+    }, 1);
+    report("closest point", t_old, t_new);
+    bool ok = (d_old==d_new);
+
+    std::vector<double> t_hit_old(n_queries, inf_double), t_hit_new(n_queries, inf_double);
+    std::vector<uint>   id_old(n_queries, max_uint), id_new(n_queries, max_uint);
+    t_old = seconds([&]{ for(uint i=0; i<n_queries; ++i) o_old->intersects_ray(p[i], dir[i], t_hit_old[i], id_old[i]); }, 1);
+    t_new = seconds([&]{ for(uint i=0; i<n_queries; ++i) o_new->intersects_ray(p[i], dir[i], t_hit_new[i], id_new[i]); }, 1);
+    report("first hit    ", t_old, t_new);
+    ok &= (t_hit_old==t_hit_new && id_old==id_new);
+
+    std::cout << (ok ? "all query results match" : "some query results differ") << std::endl << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+#include <cinolib/octree.h>
+#include <cinolib/parallel_for.h>
+#include <chrono>
+#include <random>
+
+// Times the construction of an Octree on triangle meshes of increasing size,
+// both using the thread pool and serially. Meshes are tessellated tori with
+// randomly displaced vertices, so that triangles have various sizes and
+// orientations, and are traversed by the octree planes in all possible ways
+
+using namespace cinolib;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// best of a few runs, to factor out the cost of page faults on freshly allocated memory
+template<class F>
+double seconds(const F & f, const uint n_runs = 3)
+{
+    double best = inf_double;
+    for(uint i=0; i<n_runs; ++i)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1-t0).count());
+    }
+    return best;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// a PARALLEL_FOR called from inside the body of another parallel loop is executed
+// serially, hence running f as the body of a parallel loop serializes all its loops
+template<class F>
+void serially(const F & f)
+{
+    PARALLEL_FOR(0, 2, 0, [&](const uint i)
+    {
+        if(i==0) f();
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// torus with n x 2n quads, each split into two triangles
+void torus(const uint n, std::vector<vec3d> & verts, std::vector<uint> & tris)
+{
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> jitter(-0.3,0.3);
+    const uint nu = 2*n;
+    const uint nv = n;
+    verts.clear();
+    tris.clear();
+    for(uint i=0; i<nu; ++i)
+    for(uint j=0; j<nv; ++j)
+    {
+        double u = 2*M_PI*(i+jitter(rng))/nu;
+        double v = 2*M_PI*(j+jitter(rng))/nv;
+        verts.push_back(vec3d((2+cos(v))*cos(u), (2+cos(v))*sin(u), sin(v)));
+    }
+    auto vid = [&](const uint i, const uint j) { return (i%nu)*nv + (j%nv); };
+    for(uint i=0; i<nu; ++i)
+    for(uint j=0; j<nv; ++j)
+    {
+        tris.insert(tris.end(), { vid(i,j), vid(i+1,j), vid(i+1,j+1) });
+        tris.insert(tris.end(), { vid(i,j), vid(i+1,j+1), vid(i,j+1) });
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    uint max_tris = (argc>1) ? atoi(argv[1]) : 1<<20;
+
+    std::cout << std::endl;
+    for(uint n=32; 4*n*n<=max_tris; n*=2)
+    {
+        std::vector<vec3d> verts;
+        std::vector<uint>  tris;
+        torus(n, verts, tris);
+
+        Octree o;
+        o.items.reserve(tris.size()/3);
+        for(uint i=0; i<tris.size(); i+=3)
+        {
+            o.push_triangle(i/3, verts.at(tris.at(i)), verts.at(tris.at(i+1)), verts.at(tris.at(i+2)));
+        }
+
+        // build() clears the tree, but keeps the items
+        double t_par = seconds([&]{ o.build(); });
+        double t_ser = seconds([&]{ serially([&]{ o.build(); }); });
+
+        std::cout << "  " << o.items.size() << " tris\t"
+                  << o.nodes.size()  << " nodes\t"
+                  << o.leaves.size() << " leaves\t"
+                  << "parallel " << t_par << "s\t"
+                  << "serial "   << t_ser << "s\t"
+                  << "(" << 1e9*t_par/o.items.size() << "ns per item)" << std::endl;
+    }
+    std::cout << std::endl;
+    return 0;
+}
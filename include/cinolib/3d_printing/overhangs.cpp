@@ -35,9 +35,9 @@
 *********************************************************************************/
 #include <cinolib/3d_printing/overhangs.h>
 #include <cinolib/parallel_for.h>
-#include <cinolib/octree.h>
 #include <cinolib/find_intersections.h>
-#include <mutex>
+#include <cinolib/geometry/point_utils.h>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -49,54 +49,94 @@ void overhangs(const Trimesh<M,V,E,P>  & m,
                const vec3d             & build_dir,
                      std::vector<uint> & polys_hanging)
 {
-    std::mutex mutex;
-    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    // each thread collects its own list, then lists are merged and sorted
+    // so that the output does not depend on thread scheduling
+    typedef std::vector<uint> list;
+    list res = PARALLEL_REDUCE(0, m.num_polys(), 1000, list(), [&](const uint pid, list & acc)
     {
         float ang = build_dir.angle_deg(m.poly_data(pid).normal);
-        if(ang-90.f > thresh)
-        {
-            std::lock_guard<std::mutex> guard(mutex);
-            polys_hanging.push_back(pid);
-        }
+        if(ang-90.f > thresh) acc.push_back(pid);
+    },
+    [](list l0, const list & l1)
+    {
+        l0.insert(l0.end(), l1.begin(), l1.end());
+        return l0;
     });
+    std::sort(res.begin(), res.end());
+    polys_hanging.insert(polys_hanging.end(), res.begin(), res.end());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class P>
+// shared by the Octree and BVH variants below, which only differ in the spatial data structure used for ray casting
+template<class M, class V, class E, class P, class Tree>
 CINO_INLINE
-void overhangs(const Trimesh<M,V,E,P>                  & m,
-               const float                               thresh, // degrees
-               const vec3d                             & build_dir,
-                     std::vector<std::pair<uint,uint>> & polys_hanging,
-               const Octree                            & octree) // cached
+void overhangs_with_tree(const Trimesh<M,V,E,P>                  & m,
+                         const float                               thresh, // degrees
+                         const vec3d                             & build_dir,
+                               std::vector<std::pair<uint,uint>> & polys_hanging,
+                         const Tree                              & tree)
 {
     // find overhanging triangles
     std::vector<uint> tmp;
     overhangs(m, thresh, build_dir, tmp);
 
-    // cast a ray from each overhang to find the first triangle below it
-    std::mutex mutex;
+    // cast a ray from each overhang to find the first triangle below it.
+    // Rays are parallel, and sorting their origins along a Z-order curve
+    // makes coherent packets for the batched query
+    std::vector<vec3d> c(tmp.size());
     PARALLEL_FOR(0, tmp.size(), 1000, [&](const uint i)
     {
-        uint pid  = tmp[i];
-        auto pair = std::make_pair(pid,pid);
-        std::set<std::pair<double,uint>> hits;
-        if(octree.intersects_ray(m.poly_centroid(pid), -build_dir, hits))
-        {
-            auto hit = hits.begin();
-            if(hit->second==pid) ++hit; // skip the first hit, it's the starting polygon
-            if(hit!=hits.end())
-            {
-                pair.second = hit->second;
-            }
-        }
-        // critical section
-        {
-            std::lock_guard<std::mutex> guard(mutex);
-            polys_hanging.push_back(pair);
-        }
+        c[i] = m.poly_centroid(tmp[i]);
     });
+    std::vector<uint> order;
+    Z_order(c, order);
+
+    std::vector<vec3d> p(tmp.size()), dir(tmp.size(), -build_dir);
+    std::vector<uint>  skip(tmp.size());
+    for(uint i=0; i<tmp.size(); ++i)
+    {
+        p[i]    = c[order[i]];
+        skip[i] = tmp[order[i]]; // skip the starting polygon
+    }
+    std::vector<double> min_t;
+    std::vector<uint>   ids;
+    tree.intersects_rays(p, dir, skip, min_t, ids);
+
+    typedef std::pair<uint,uint> hang;
+    std::vector<hang> res(tmp.size());
+    for(uint i=0; i<tmp.size(); ++i)
+    {
+        res[i] = hang(skip[i], (min_t[i]<inf_double) ? ids[i] : skip[i]);
+    }
+    std::sort(res.begin(), res.end());
+    polys_hanging.insert(polys_hanging.end(), res.begin(), res.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void overhangs(const Trimesh<M,V,E,P>                  & m,
+               const float                               thresh, // degrees
+               const vec3d                             & build_dir,
+                     std::vector<std::pair<uint,uint>> & polys_hanging,
+               const Octree                            & octree) // cached
+{
+    overhangs_with_tree(m, thresh, build_dir, polys_hanging, octree);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void overhangs(const Trimesh<M,V,E,P>                  & m,
+               const float                               thresh, // degrees
+               const vec3d                             & build_dir,
+                     std::vector<std::pair<uint,uint>> & polys_hanging,
+               const BVH                               & bvh) // cached
+{
+    overhangs_with_tree(m, thresh, build_dir, polys_hanging, bvh);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -108,9 +148,9 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
                const vec3d                             & build_dir,
                      std::vector<std::pair<uint,uint>> & polys_hanging)
 {
-    Octree octree;
-    octree.build_from_mesh_polys(m);
-    overhangs(m, thresh, build_dir, polys_hanging, octree);
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+    overhangs(m, thresh, build_dir, polys_hanging, bvh);
 }
 
 }
@@ -69,21 +69,28 @@ Eigen::MatrixXd HKS(      AbstractMesh<M,V,E,P> & m,
     std::vector<double> timesteps = sample_within_interval(log(0.005), log(0.2), n_timesteps);
     for(uint i=0; i<n_timesteps; ++i) timesteps[i] = exp(timesteps[i]);
 
+    // all systems share the same sparsity pattern, which is analyzed only once,
+    // and all landmarks are solved together, as multiple right hand sides
+    LinearSolver solver(SIMPLICIAL_LLT);
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(m.num_verts(), landmarks.size());
+    for(uint i=0; i<landmarks.size(); ++i) rhs(landmarks[i],i) = 1.0;
+
     uint col = 0;
     for(auto t : timesteps)
     {
-        Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> solver(MM - t*L);
-        assert(solver.info() == Eigen::Success);
+        bool ok = solver.factorize(MM - t*L);
+        assert(ok); (void)ok;
+
+        Eigen::MatrixXd X;
+        solver.solve(rhs, X);
 
-        for(auto v : landmarks)
+        for(uint i=0; i<landmarks.size(); ++i)
         {
-            if(verbose) std::cout << "column " << col << ": time step " << t << ", landmark " << v << std::endl;
+            if(verbose) std::cout << "column " << col << ": time step " << t << ", landmark " << landmarks[i] << std::endl;
 
-            Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
-            rhs[v] = 1.0;
-            ScalarField f = solver.solve(rhs).eval();
+            ScalarField f = X.col(i);
             if(normalize_columns) f.normalize_in_01(); // Useful for visualization but "physically wrong"...
-            for(uint vid=0; vid<m.num_verts(); ++vid) A.coeffRef(vid,col) = f[vid];
+            A.col(col) = f;
             ++col;
         }
     }
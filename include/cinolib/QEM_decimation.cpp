@@ -0,0 +1,415 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/QEM_decimation.h>
+#include <cinolib/indexed_heap.h>
+#include <cinolib/parallel_for.h>
+#include <array>
+
+namespace cinolib
+{
+
+// symmetric 4x4 matrix, stored as its upper triangle
+//
+// | q[0] q[1] q[2] q[3] |
+// |      q[4] q[5] q[6] |
+// |           q[7] q[8] |
+// |                q[9] |
+//
+typedef std::array<double,10> QEM_quadric;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// quadric measuring the (weighted) squared distance from the plane n.x + d = 0
+CINO_INLINE
+static QEM_quadric QEM_plane(const vec3d & n, const double d, const double w)
+{
+    QEM_quadric q;
+    q[0] = w*n[0]*n[0]; q[1] = w*n[0]*n[1]; q[2] = w*n[0]*n[2]; q[3] = w*n[0]*d;
+                        q[4] = w*n[1]*n[1]; q[5] = w*n[1]*n[2]; q[6] = w*n[1]*d;
+                                            q[7] = w*n[2]*n[2]; q[8] = w*n[2]*d;
+                                                                q[9] = w*d*d;
+    return q;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static void QEM_add(QEM_quadric & a, const QEM_quadric & b)
+{
+    for(uint i=0; i<10; ++i) a[i] += b[i];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static double QEM_error(const QEM_quadric & q, const vec3d & p)
+{
+    double x = p[0], y = p[1], z = p[2];
+    double e =   q[0]*x*x + 2*q[1]*x*y + 2*q[2]*x*z + 2*q[3]*x
+               + q[4]*y*y + 2*q[5]*y*z + 2*q[6]*y
+               + q[7]*z*z + 2*q[8]*z
+               + q[9];
+    return std::max(0.0, e); // clamp round off
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// point minimizing the quadric error. Returns false if the linear system is
+// ill conditioned (e.g. in flat or cylindrical regions, where the minimizer
+// is not unique)
+CINO_INLINE
+static bool QEM_optimum(const QEM_quadric & q, vec3d & p)
+{
+    mat3d A({q[0], q[1], q[2],
+             q[1], q[4], q[5],
+             q[2], q[5], q[7]});
+    double s = (q[0]+q[4]+q[7])/3.0;
+    double d = A.det();
+    if(s<=0 || std::fabs(d) < 1e-8*s*s*s) return false;
+    p = A.inverse() * vec3d(-q[3],-q[6],-q[8]);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// point of segment ab minimizing the quadric error. Used for feature edges, where
+// the unconstrained optimum may drift away from the feature line (e.g. at sharp
+// turns, where the constraint planes of the incident edges are almost parallel)
+CINO_INLINE
+static vec3d QEM_segment_optimum(const QEM_quadric & q, const vec3d & a, const vec3d & b)
+{
+    vec3d d  = b-a;
+    vec3d Ad(q[0]*d[0] + q[1]*d[1] + q[2]*d[2],
+             q[1]*d[0] + q[4]*d[1] + q[5]*d[2],
+             q[2]*d[0] + q[5]*d[1] + q[7]*d[2]);
+    double den = Ad.dot(d);
+    if(den<=0) return (a+b)*0.5;
+    double num = Ad.dot(a) + d.dot(vec3d(q[3],q[6],q[8]));
+    double t   = std::min(1.0, std::max(0.0, -num/den));
+    return a + d*t;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the link condition (see Trimesh::edge_is_topologically_collapsible) holds also
+// for edges whose endpoints both belong to a single triangle (e.g. an isolated
+// triangle, or an ear). Collapsing them would leave a dangling edge, which the
+// decimation cannot process any further
+template<class M, class V, class E, class P>
+CINO_INLINE
+static bool QEM_edge_is_topologically_collapsible(const Trimesh<M,V,E,P> & m, const uint eid)
+{
+    uint v0 = m.edge_vert_id(eid,0);
+    uint v1 = m.edge_vert_id(eid,1);
+    if(m.adj_v2p(v0).size()==1 && m.adj_v2p(v1).size()==1) return false;
+    return m.edge_is_topologically_collapsible(eid);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint QEM_decimation(Trimesh<M,V,E,P> & m, const QEMDecimationOptions & opt)
+{
+    // batched editing with deferred deletion (see AbstractPolygonMesh::deferred_delete_begin)
+    bool deferred = m.deferred_delete_is_active();
+    if(!deferred) m.deferred_delete_begin();
+
+    auto is_feature = [&](const uint eid) -> bool
+    {
+        if(opt.preserve_boundary && m.edge_is_boundary(eid)) return true;
+        if(opt.preserve_features && (m.edge_data(eid).flags[MARKED] ||
+                                     m.edge_data(eid).flags[CREASE])) return true;
+        return false;
+    };
+
+    auto feature_valence = [&](const uint vid) -> uint
+    {
+        uint count = 0;
+        for(uint eid : m.adj_v2e(vid)) if(is_feature(eid)) ++count;
+        return count;
+    };
+
+    // 1) initialize per vertex quadrics with the planes of the incident triangles,
+    //    plus planes orthogonal to them along feature edges, which penalize any
+    //    movement of feature vertices away from their feature lines
+    //
+    std::vector<QEM_quadric> p_quad(m.num_polys());
+    std::vector<QEM_quadric> e_quad(m.num_edges());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        p_quad.at(pid).fill(0);
+        if(m.poly_is_dead(pid)) return;
+        vec3d  n = m.poly_data(pid).normal;
+        double w = m.poly_area(pid);
+        p_quad.at(pid) = QEM_plane(n, -n.dot(m.poly_vert(pid,0)), w);
+    });
+    PARALLEL_FOR(0, m.num_edges(), 1000, [&](const uint eid)
+    {
+        e_quad.at(eid).fill(0);
+        if(m.edge_is_dead(eid) || !is_feature(eid)) return;
+        vec3d  v0 = m.edge_vert(eid,0);
+        vec3d  v1 = m.edge_vert(eid,1);
+        double w  = opt.feature_weight * v0.dist_sqrd(v1);
+        for(uint pid : m.adj_e2p(eid))
+        {
+            vec3d n = (v1-v0).cross(m.poly_data(pid).normal);
+            if(n.norm()==0) continue;
+            n.normalize();
+            QEM_add(e_quad.at(eid), QEM_plane(n, -n.dot(v0), w));
+        }
+    });
+    std::vector<QEM_quadric> Q(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+    {
+        Q.at(vid).fill(0);
+        if(m.vert_is_dead(vid)) return;
+        for(uint pid : m.adj_v2p(vid)) QEM_add(Q.at(vid), p_quad.at(pid));
+        for(uint eid : m.adj_v2e(vid)) QEM_add(Q.at(vid), e_quad.at(eid));
+    });
+    p_quad.clear();
+    e_quad.clear();
+
+    // the link condition does not guarantee that collapses around non manifold
+    // vertices preserve the topology, hence these vertices are left untouched
+    std::vector<char> non_manifold(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+    {
+        non_manifold.at(vid) = !m.vert_is_dead(vid) && !m.vert_is_manifold(vid);
+    });
+
+    // 2) cost of each collapse, and position of the surviving vertex.
+    //    Returns inf if the edge cannot be collapsed without damaging
+    //    feature lines
+    //
+    auto edge_cost = [&](const uint eid, vec3d & p) -> double
+    {
+        uint v0 = m.edge_vert_id(eid,0);
+        uint v1 = m.edge_vert_id(eid,1);
+        if(non_manifold.at(v0) || non_manifold.at(v1)) return inf_double;
+
+        uint f0 = feature_valence(v0);
+        uint f1 = feature_valence(v1);
+        bool c0 = (f0>0 && f0!=2); // corners never move
+        bool c1 = (f1>0 && f1!=2);
+
+        QEM_quadric q = Q.at(v0);
+        QEM_add(q, Q.at(v1));
+
+        if(is_feature(eid))
+        {
+            if(c0 && c1) return inf_double;
+            if(c0) { p = m.vert(v0); return QEM_error(q,p); }
+            if(c1) { p = m.vert(v1); return QEM_error(q,p); }
+            p = QEM_segment_optimum(q, m.vert(v0), m.vert(v1));
+            return QEM_error(q,p);
+        }
+        else
+        {
+            if(f0>0 && f1>0) return inf_double; // would shortcut a feature line
+            if(f0>0) { p = m.vert(v0); return QEM_error(q,p); }
+            if(f1>0) { p = m.vert(v1); return QEM_error(q,p); }
+        }
+
+        if(QEM_optimum(q,p)) return QEM_error(q,p);
+
+        // ill conditioned system: pick the best among endpoints and midpoint
+        vec3d  cand[3] = { m.vert(v0), m.vert(v1), (m.vert(v0)+m.vert(v1))*0.5 };
+        double best    = inf_double;
+        for(const vec3d & c : cand)
+        {
+            double err = QEM_error(q,c);
+            if(err<best) { best = err; p = c; }
+        }
+        return best;
+    };
+
+    std::vector<vec3d>  target(m.num_edges());
+    std::vector<double> cost(m.num_edges());
+    PARALLEL_FOR(0, m.num_edges(), 1000, [&](const uint eid)
+    {
+        cost.at(eid) = m.edge_is_dead(eid) ? inf_double : edge_cost(eid, target.at(eid));
+    });
+
+    IndexedHeap<> heap(m.num_edges());
+    for(uint eid=0; eid<m.num_edges(); ++eid)
+    {
+        if(cost.at(eid)<inf_double) heap.push(eid, cost.at(eid));
+    }
+
+    uint n_polys = 0;
+    for(uint pid=0; pid<m.num_polys(); ++pid) if(!m.poly_is_dead(pid)) ++n_polys;
+
+    // 3) greedily collapse the cheapest edges, in batches of edges with pairwise
+    //    disjoint neighborhoods (which also makes their costs independent). In
+    //    serial mode batches have size one, and the algorithm reduces to the
+    //    classical greedy scheme
+    //
+    uint max_batch = opt.parallel ? 1024 : 1;
+    uint n_collapses = 0;
+    uint round = 0;
+    std::vector<uint> stamp(m.num_verts(),0);
+    std::vector<uint> batch;
+    std::vector<std::pair<uint,double>> postponed;
+    std::vector<char> ok;
+    std::vector<uint> to_update;
+
+    auto mark_ring = [&](const uint vid)
+    {
+        stamp.at(vid) = round;
+        for(uint nbr : m.adj_v2v(vid)) stamp.at(nbr) = round;
+    };
+    auto ring_is_free = [&](const uint vid) -> bool
+    {
+        if(stamp.at(vid)==round) return false;
+        for(uint nbr : m.adj_v2v(vid)) if(stamp.at(nbr)==round) return false;
+        return true;
+    };
+
+    while(!heap.empty() && n_polys>opt.target_polys)
+    {
+        // select a batch of independent edges, in increasing order of cost
+        ++round;
+        batch.clear();
+        postponed.clear();
+        uint n_removed = 0;
+        while(!heap.empty() && batch.size()<max_batch && postponed.size()<max_batch)
+        {
+            if(n_polys - std::min(n_polys,n_removed) <= opt.target_polys) break;
+            if(heap.top_key() > opt.max_error) break;
+
+            uint   eid = heap.top();
+            double key = heap.top_key();
+            heap.pop();
+            if(m.edge_is_dead(eid)) continue;
+
+            uint v0 = m.edge_vert_id(eid,0);
+            uint v1 = m.edge_vert_id(eid,1);
+            if(!ring_is_free(v0) || !ring_is_free(v1))
+            {
+                postponed.push_back(std::make_pair(eid,key));
+                continue;
+            }
+
+            // costs are updated only around collapsed edges, but the validity of
+            // a collapse also depends on the feature edges in the neighborhood,
+            // which may have changed. Refresh the cost, and postpone if it grew
+            double c = edge_cost(eid, target.at(eid));
+            if(c==inf_double) continue;
+            if(c>key) { heap.push(eid,c); continue; }
+
+            mark_ring(v0);
+            mark_ring(v1);
+            batch.push_back(eid);
+            n_removed += m.adj_e2p(eid).size();
+        }
+        for(const auto & e : postponed) heap.push(e.first, e.second);
+        if(batch.empty()) break;
+
+        // validity checks only read the neighborhood of each edge, which is not
+        // touched by the other collapses in the batch
+        ok.resize(batch.size());
+        PARALLEL_FOR(0, batch.size(), 64, [&](const uint i)
+        {
+            uint eid = batch.at(i);
+            ok.at(i) = QEM_edge_is_topologically_collapsible(m, eid) &&
+                       m.edge_is_geometrically_collapsible(eid, target.at(eid));
+        });
+
+        to_update.clear();
+        for(uint i=0; i<batch.size(); ++i)
+        {
+            if(!ok.at(i)) continue; // will be reconsidered if its neighborhood changes
+
+            uint eid = batch.at(i);
+            uint v0  = m.edge_vert_id(eid,0);
+            uint v1  = m.edge_vert_id(eid,1);
+            uint n_p = m.adj_e2p(eid).size();
+
+            // edge ids around the removed vertex die with the collapse: keep track of
+            // them, to transfer feature flags to the edges that replace them
+            uint vr = std::max(v0,v1);
+            std::vector<std::pair<uint,uint>> old_edges; // (eid, opposite vert)
+            for(uint e : m.adj_v2e(vr)) old_edges.push_back(std::make_pair(e, m.vert_opposite_to(e,vr)));
+
+            QEM_quadric q = Q.at(v0);
+            QEM_add(q, Q.at(v1));
+
+            int vid = m.edge_collapse(eid, target.at(eid), false, false);
+            assert(vid>=0);
+            Q.at(vid) = q;
+            n_polys  -= n_p;
+            ++n_collapses;
+
+            for(const auto & old_e : old_edges)
+            {
+                uint old = old_e.first;
+                heap.remove(old);
+                if(old==eid) continue;
+                int e = m.edge_id(vid, old_e.second);
+                if(e<0) continue; // (vid,nbr) was only incident to collapsed triangles
+                m.edge_data(e).flags[MARKED] = m.edge_data(e).flags[MARKED] || m.edge_data(old).flags[MARKED];
+                m.edge_data(e).flags[CREASE] = m.edge_data(e).flags[CREASE] || m.edge_data(old).flags[CREASE];
+            }
+            for(uint e : m.adj_v2e(vid)) to_update.push_back(e);
+            if(m.mesh_data().update_normals)
+            {
+                for(uint nbr : m.adj_v2v(vid)) m.update_v_normal(nbr);
+            }
+        }
+
+        // refresh the cost of all edges incident to the surviving vertices
+        heap.grow(m.num_edges());
+        target.resize(m.num_edges());
+        cost.resize(m.num_edges());
+        PARALLEL_FOR(0, to_update.size(), 256, [&](const uint i)
+        {
+            uint eid = to_update.at(i);
+            cost.at(eid) = edge_cost(eid, target.at(eid));
+        });
+        for(uint eid : to_update)
+        {
+            if(cost.at(eid)<inf_double) heap.update(eid, cost.at(eid));
+            else                        heap.remove(eid);
+        }
+    }
+
+    if(!deferred) m.deferred_delete_end();
+
+    return n_collapses;
+}
+
+}
@@ -0,0 +1,106 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_QEM_DECIMATION_H
+#define CINO_QEM_DECIMATION_H
+
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/min_max_inf.h>
+
+namespace cinolib
+{
+
+/* Simplifies a triangle mesh with a sequence of edge collapses, driven by the
+ * quadric error metric described in:
+ *
+ *   Surface Simplification Using Quadric Error Metrics
+ *   Michael Garland, Paul S. Heckbert
+ *   SIGGRAPH 1997
+ *
+ * Each vertex stores the (area weighted) sum of the squared distances from the
+ * planes of its incident triangles. Collapses are kept in a priority queue
+ * sorted by quadric error, which is updated after each collapse, and the
+ * cheapest one is always executed first. Collapses are executed with
+ * Trimesh::edge_collapse, which rejects moves that would change the topology
+ * of the mesh or flip some triangle.
+ *
+ * Boundary edges and edges flagged as MARKED or CREASE are feature edges.
+ * Feature lines can be simplified along their direction, but never crossed:
+ * corners (i.e. vertices with a number of incident feature edges other than
+ * two) do not move, and vertices on a feature line only move along it.
+ * Non manifold vertices are never touched.
+ *
+ * In parallel mode, collapses are executed in batches of edges with disjoint
+ * neighborhoods, picked in increasing order of error (see
+ * AbstractPolygonMesh::deferred_delete_begin). Error updates are also computed
+ * in parallel for all the edges in a batch. The result is close to, but not
+ * the same as, the one of the serial greedy process.
+ *
+ * Parallel mode is off by default, as it is usually slower. Only validity
+ * checks and error updates run in parallel, whereas collapses are applied
+ * serially, and forming the batches costs about a third of the serial running
+ * time (measured on one core). In example 50 (1M triangles down to 10K) it was
+ * slower than the serial mode also on a multi core machine (35.4s vs 27.3s).
+ * It can only pay off on machines with many cores, where the parallel error
+ * updates outweigh the batching overhead: measure before enabling it.
+ *
+ * Returns the number of collapses performed.
+*/
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct QEMDecimationOptions
+{
+    uint   target_polys      = 0;       // stop when the mesh has no more than target_polys triangles...
+    double max_error         = inf_double; // ...or when the cheapest collapse has a larger quadric error
+    bool   preserve_boundary = true;    // treat boundary edges as feature lines
+    bool   preserve_features = true;    // treat MARKED and CREASE edges as feature lines
+    double feature_weight    = 1000.0;  // weight of the planes that keep feature vertices on their lines
+    bool   parallel          = false;   // collapse batches of independent edges (usually slower, see above)
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint QEM_decimation(Trimesh<M,V,E,P>           & m,
+                    const QEMDecimationOptions & opt = QEMDecimationOptions());
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "QEM_decimation.cpp"
+#endif
+
+#endif // CINO_QEM_DECIMATION_H
@@ -36,42 +36,86 @@
 #include <cinolib/ambient_occlusion.h>
 #include <cinolib/sphere_coverage.h>
 #include <cinolib/parallel_for.h>
-#include <cinolib/octree.h>
+#include <cinolib/bvh.h>
+#include <cinolib/geometry/point_utils.h>
 
 namespace cinolib
 {
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// AO of each polygon of m. Rays are cast in batches: polygons are sorted in Z-order and
+// taken in groups of RAY_PACKET_SIZE consecutive elements, and each packet contains the
+// (coherent) rays shot by the polygons in a group along the same direction
 template<class M, class V, class E, class P>
 CINO_INLINE
-float ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m,
-                        const uint                     pid,
-                        const Octree                 & o,
-                        const std::vector<vec3d>     & dirs,
-                        const float                    len)
+void ambient_occlusion(const AbstractPolygonMesh<M,V,E,P> & m,
+                       const BVH                          & o,
+                       const std::vector<vec3d>           & dirs,
+                       const float                          len,
+                             std::vector<float>           & ao)
 {
-    uint  total  = 0;
-    uint  shadow = 0;
-    vec3d c      = m.poly_centroid(pid);
-    for(const vec3d & d : dirs)
-    {
-        std::set<std::pair<double,uint>> hits;
-        o.intersects_ray(c,d,hits);
-
-        // for numerical stability, discard intersections with the current element (if any)
-        while(!hits.empty() && hits.begin()->second==pid) hits.erase(hits.begin());
-
-        // interior ray, discard
-        if(hits.size()%2!=0) continue;
+    ao.assign(m.num_polys(), 1.f);
 
-        ++total;
+    std::vector<vec3d> c(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        c[pid] = m.poly_centroid(pid);
+    });
+    std::vector<uint> order;
+    Z_order(c, order);
+
+    // bound the memory used for the batch (about 64 bytes per ray)
+    const uint max_rays = 1 << 18;
+    uint       n_dirs   = dirs.size();
+    uint       n_groups = std::max(1u, max_rays / std::max(1u, n_dirs*RAY_PACKET_SIZE));
+    uint       chunk    = n_groups * RAY_PACKET_SIZE;
+
+    std::vector<vec3d>  p, d;
+    std::vector<uint>   skip, ids, n_hits;
+    std::vector<double> min_t;
+    for(uint beg=0; beg<m.num_polys(); beg+=chunk)
+    {
+        uint end = std::min(m.num_polys(), beg+chunk);
+        p.clear();
+        d.clear();
+        skip.clear();
+        for(uint g=beg; g<end; g+=RAY_PACKET_SIZE)
+        {
+            uint g_end = std::min(end, g+RAY_PACKET_SIZE);
+            for(const vec3d & dir : dirs)
+            for(uint i=g; i<g_end; ++i)
+            {
+                p.push_back(c[order[i]]);
+                d.push_back(dir);
+                skip.push_back(order[i]); // for numerical stability, discard intersections with the current element (if any)
+            }
+        }
+        o.intersects_rays(p, d, skip, min_t, ids, n_hits);
 
-        // first hit is beyond ray length, count as shadow
-        if(!hits.empty() && hits.begin()->first<len) ++shadow;
+        uint ray = 0;
+        for(uint g=beg; g<end; g+=RAY_PACKET_SIZE)
+        {
+            uint g_end  = std::min(end, g+RAY_PACKET_SIZE);
+            uint total [RAY_PACKET_SIZE] = {0};
+            uint shadow[RAY_PACKET_SIZE] = {0};
+            for(uint k=0; k<n_dirs; ++k)
+            for(uint i=g; i<g_end; ++i, ++ray)
+            {
+                // interior ray, discard
+                if(n_hits[ray]%2!=0) continue;
+
+                ++total[i-g];
+
+                // first hit is beyond ray length, count as shadow
+                if(n_hits[ray]>0 && min_t[ray]<len) ++shadow[i-g];
+            }
+            for(uint i=g; i<g_end; ++i)
+            {
+                if(shadow[i-g]>0) ao[order[i]] = 1.f - float(shadow[i-g])/total[i-g];
+            }
+        }
     }
-    if(shadow>0) return 1.f - float(shadow)/total;
-    return 1.f;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -82,22 +126,26 @@ void ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m, AO_data & data)
 {
     float len = data.ray_length * m.bbox().diag();
 
-    Octree o;
+    BVH o;
     o.build_from_mesh_polys(m);
     if(data.with_floor) o.build_from_mesh_polys(data.floor);
 
     std::vector<vec3d> dirs;
     sphere_coverage(data.n_samples,dirs);
 
-    std::vector<float> ao_m(m.num_polys(),1.0);
-    float min = inf_float;
-    float max = 0.f;
-    PARALLEL_FOR(0,m.num_polys(),100,[&](const uint pid)
+    // per thread (min,max) of AO values, merged at the end
+    typedef std::pair<float,float> range;
+    auto range_add   = [](range & r, const float val) { r.first = std::min(r.first,val); r.second = std::max(r.second,val); };
+    auto range_merge = [](const range & r0, const range & r1) { return range(std::min(r0.first,r1.first), std::max(r0.second,r1.second)); };
+
+    std::vector<float> ao_m;
+    ambient_occlusion(m,o,dirs,len,ao_m);
+    range r = PARALLEL_REDUCE(0,m.num_polys(),1000,range(inf_float,0.f),[&](const uint pid, range & acc)
     {
-        ao_m.at(pid) = ambient_occlusion(m,pid,o,dirs,len);
-        min = std::min(min,ao_m.at(pid));
-        max = std::max(max,ao_m.at(pid));
-    });
+        range_add(acc,ao_m.at(pid));
+    }, range_merge);
+    float min = r.first;
+    float max = r.second;
     // normalize
     float delta = max-min;
     if(delta!=0) for(float & val : ao_m) val = (val-min)/delta;
@@ -109,13 +157,14 @@ void ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m, AO_data & data)
 
     if(data.with_floor)
     {
-        std::vector<float> ao_f(data.floor.num_polys(),1.0);
-        PARALLEL_FOR(0,data.floor.num_polys(),100,[&](const uint pid)
+        std::vector<float> ao_f;
+        ambient_occlusion(data.floor,o,dirs,len,ao_f);
+        r = PARALLEL_REDUCE(0,data.floor.num_polys(),1000,range(min,max),[&](const uint pid, range & acc)
         {
-            ao_f.at(pid) = ambient_occlusion(data.floor,pid,o,dirs,len);
-            min = std::min(min,ao_f.at(pid));
-            max = std::max(max,ao_f.at(pid));
-        });
+            range_add(acc,ao_f.at(pid));
+        }, range_merge);
+        min = r.first;
+        max = r.second;
         if(delta!=0) for(float & val : ao_f) val = (val-min)/delta;
         for(uint pid=0; pid<data.floor.num_polys(); ++pid)
         {
@@ -0,0 +1,1046 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/bvh.h>
+#include <cinolib/how_many_seconds.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace cinolib
+{
+
+// rounds towards -inf/+inf, so that float boxes always enclose their double counterpart
+CINO_INLINE
+static float float_round_down(const double d)
+{
+    float f = static_cast<float>(d);
+    if(static_cast<double>(f)>d) f = std::nextafter(f, -inf_float);
+    return f;
+}
+
+CINO_INLINE
+static float float_round_up(const double d)
+{
+    float f = static_cast<float>(d);
+    if(static_cast<double>(f)<d) f = std::nextafter(f, inf_float);
+    return f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVHNode::set_bbox(const AABB & b)
+{
+    for(int i=0; i<3; ++i)
+    {
+        bmin[i] = float_round_down(b.min[i]);
+        bmax[i] = float_round_up  (b.max[i]);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double BVHNode::dist_sqrd(const vec3d & p) const
+{
+    double d = 0.0;
+    for(int i=0; i<3; ++i)
+    {
+        double delta = 0.0;
+        if(p[i]<bmin[i]) delta = bmin[i]-p[i]; else
+        if(p[i]>bmax[i]) delta = p[i]-bmax[i];
+        d += delta*delta;
+    }
+    return d;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVHNode::contains(const vec3d & p) const
+{
+    return p[0]>=bmin[0] && p[0]<=bmax[0] &&
+           p[1]>=bmin[1] && p[1]<=bmax[1] &&
+           p[2]>=bmin[2] && p[2]<=bmax[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVHNode::intersects_box(const AABB & b) const
+{
+    for(int i=0; i<3; ++i)
+    {
+        if(bmax[i]<b.min[i] || bmin[i]>b.max[i]) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// slab test, same as AABB::intersects_ray but with the reciprocal of dir precomputed by the caller
+CINO_INLINE
+bool BVHNode::intersects_ray(const vec3d & p, const vec3d & dir, const vec3d & inv_dir, double & t_min) const
+{
+           t_min = 0.0;
+    double t_max = inf_double;
+    for(int i=0; i<3; ++i)
+    {
+        if(std::fabs(dir[i]) < 1e-15)
+        {
+            if(p[i]<bmin[i] || p[i]>bmax[i]) return false;
+        }
+        else
+        {
+            double t_near = (bmin[i] - p[i]) * inv_dir[i];
+            double t_far  = (bmax[i] - p[i]) * inv_dir[i];
+            if(t_near > t_far) std::swap(t_near, t_far);
+            t_min = std::max(t_min, t_near);
+            t_max = std::min(t_max, t_far);
+            if(t_min>t_max) return false;
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BVH::BVH(const uint items_per_leaf)
+: items_per_leaf(std::max(items_per_leaf,1u))
+{}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::build()
+{
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    nodes.clear();
+    tree_depth = 0;
+    if(items.empty()) return;
+
+    build_items.resize(items.size());
+    PARALLEL_FOR(0, items.size(), 10000, [&](const uint i)
+    {
+        const AABB & bb = items.aabb(i);
+        build_items[i].min      = bb.min;
+        build_items[i].max      = bb.max;
+        build_items[i].centroid = bb.center();
+    });
+
+    item_order.resize(items.size());
+    std::iota(item_order.begin(), item_order.end(), 0);
+
+    // SPLIT THE TOP LEVELS SERIALLY
+    // Ranges that are small enough, or deep enough to give a good
+    // number of independent subtrees, become tasks for the threads.
+    // Tasks operate on disjoint ranges of item_order, hence they need
+    // no synchronization
+
+    const uint task_depth = 6;
+    const uint task_size  = 4096;
+
+    std::vector<TopNode> top(1);
+    top[0].beg   = 0;
+    top[0].end   = items.size();
+    top[0].depth = 1;
+    std::vector<uint> tasks;
+    for(uint i=0; i<top.size(); ++i)
+    {
+        if(top[i].depth<task_depth && top[i].end-top[i].beg>task_size)
+        {
+            top[i].bbox = range_bbox(top[i].beg, top[i].end);
+            uint mid = split(top[i].beg, top[i].end);
+            assert(mid>top[i].beg && mid<top[i].end);
+            TopNode l, r;
+            l.beg = top[i].beg; l.end = mid;        l.depth = top[i].depth+1;
+            r.beg = mid;        r.end = top[i].end; r.depth = top[i].depth+1;
+            top[i].left  = top.size(); top.push_back(l);
+            top[i].right = top.size(); top.push_back(r);
+        }
+        else
+        {
+            top[i].task = tasks.size();
+            tasks.push_back(i);
+        }
+    }
+
+    // BUILD SUBTREES IN PARALLEL
+    std::vector<std::vector<BVHNode>> subtrees(tasks.size());
+    std::vector<uint>                 depths  (tasks.size());
+    PARALLEL_FOR(0, tasks.size(), 2, 0, 1, [&](const uint i)
+    {
+        const TopNode & n = top[tasks[i]];
+        depths[i] = build_subtree(n.beg, n.end, n.depth, subtrees[i]);
+    });
+
+    // STITCH EVERYTHING IN DEPTH-FIRST ORDER
+    uint n_nodes = top.size() - tasks.size();
+    for(const auto & s : subtrees) n_nodes += s.size();
+    nodes.reserve(n_nodes);
+    std::vector<int> stack = { 0 };
+    std::vector<std::pair<uint,int>> right_links; // (parent node, right child in top)
+    while(!stack.empty())
+    {
+        int i = stack.back();
+        stack.pop_back();
+
+        // link the right child of an inner top node to the node being emitted
+        while(!right_links.empty() && right_links.back().second==i)
+        {
+            nodes[right_links.back().first].offset = nodes.size();
+            right_links.pop_back();
+        }
+
+        const TopNode & n = top[i];
+        if(n.task>=0)
+        {
+            uint base = nodes.size();
+            for(BVHNode node : subtrees[n.task])
+            {
+                if(!node.is_leaf()) node.offset += base;
+                nodes.push_back(node);
+            }
+            std::vector<BVHNode>().swap(subtrees[n.task]);
+            tree_depth = std::max(tree_depth, depths[n.task]);
+        }
+        else
+        {
+            BVHNode node;
+            node.set_bbox(n.bbox);
+            node.offset = 0;
+            node.count  = 0;
+            right_links.push_back(std::make_pair(nodes.size(), n.right));
+            nodes.push_back(node);
+            stack.push_back(n.right);
+            stack.push_back(n.left);
+        }
+    }
+    assert(right_links.empty());
+    assert(nodes.size()==n_nodes);
+    std::vector<BuildItem>().swap(build_items);
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        double t = how_many_seconds(t0,t1);
+        std::cout << ":::::::::::::::::::::::::::::::::::::::::::::::::::" << std::endl;
+        std::cout << "BVH created (" << t << "s)                         " << std::endl;
+        std::cout << "#Items                   : " << items.size()         << std::endl;
+        std::cout << "#Nodes                   : " << nodes.size()         << std::endl;
+        std::cout << "Depth                    : " << tree_depth           << std::endl;
+        std::cout << "Prescribed items per leaf: " << items_per_leaf       << std::endl;
+        std::cout << "Max items per leaf       : " << max_items_per_leaf() << std::endl;
+        std::cout << ":::::::::::::::::::::::::::::::::::::::::::::::::::" << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+AABB BVH::range_bbox(const uint beg, const uint end) const
+{
+    AABB bbox;
+    for(uint i=beg; i<end; ++i)
+    {
+        const BuildItem & it = build_items[item_order[i]];
+        bbox.min = bbox.min.min(it.min);
+        bbox.max = bbox.max.max(it.max);
+    }
+    return bbox;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Partitions item_order[beg,end) according to the best binned SAH split, and returns the
+// position of the first item in the right child. If all centroids coincide, the range is
+// simply split in half
+CINO_INLINE
+uint BVH::split(const uint beg, const uint end)
+{
+    const uint max_bins = 16; // SAH bins per axis
+
+    struct Bin
+    {
+        double min[3] = {  inf_double,  inf_double,  inf_double };
+        double max[3] = { -inf_double, -inf_double, -inf_double };
+        uint   count  = 0;
+        double half_area() const
+        {
+            double dx = max[0]-min[0];
+            double dy = max[1]-min[1];
+            double dz = max[2]-min[2];
+            return dx*dy + dy*dz + dz*dx;
+        }
+        void push(const double bmin[], const double bmax[])
+        {
+            for(int i=0; i<3; ++i)
+            {
+                min[i] = std::min(min[i], bmin[i]);
+                max[i] = std::max(max[i], bmax[i]);
+            }
+        }
+    };
+
+    double cmin[3] = {  inf_double,  inf_double,  inf_double };
+    double cmax[3] = { -inf_double, -inf_double, -inf_double };
+    for(uint i=beg; i<end; ++i)
+    {
+        const vec3d & c = build_items[item_order[i]].centroid;
+        for(int axis=0; axis<3; ++axis)
+        {
+            cmin[axis] = std::min(cmin[axis], c[axis]);
+            cmax[axis] = std::max(cmax[axis], c[axis]);
+        }
+    }
+
+    // small ranges do not need many bins
+    const uint n_bins = std::min(max_bins, end-beg);
+    double scale[3];
+    for(int axis=0; axis<3; ++axis)
+    {
+        double extent = cmax[axis] - cmin[axis];
+        scale[axis] = (extent>0) ? n_bins/extent : 0.0;
+    }
+
+    Bin bins[3][max_bins];
+    for(uint i=beg; i<end; ++i)
+    {
+        const BuildItem & it = build_items[item_order[i]];
+        for(int axis=0; axis<3; ++axis)
+        {
+            uint b = std::min(n_bins-1, uint((it.centroid[axis]-cmin[axis])*scale[axis]));
+            ++bins[axis][b].count;
+            bins[axis][b].push(it.min.ptr(), it.max.ptr());
+        }
+    }
+
+    double best_cost = inf_double;
+    int    best_axis = -1;
+    uint   best_bin  = 0;
+    for(int axis=0; axis<3; ++axis)
+    {
+        if(scale[axis]==0) continue;
+
+        // sweep from the right to collect areas of the right sides
+        double area_r [max_bins];
+        uint   count_r[max_bins];
+        Bin    acc;
+        for(uint b=n_bins-1; b>0; --b)
+        {
+            acc.push(bins[axis][b].min, bins[axis][b].max);
+            acc.count += bins[axis][b].count;
+            area_r [b] = (acc.count>0) ? acc.half_area() : 0.0;
+            count_r[b] = acc.count;
+        }
+
+        // sweep from the left and evaluate the cost of splitting after bin b
+        acc = Bin();
+        for(uint b=0; b<n_bins-1; ++b)
+        {
+            acc.push(bins[axis][b].min, bins[axis][b].max);
+            acc.count += bins[axis][b].count;
+            if(acc.count==0 || count_r[b+1]==0) continue;
+            double cost = acc.count*acc.half_area() + count_r[b+1]*area_r[b+1];
+            if(cost<best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_bin  = b;
+            }
+        }
+    }
+
+    uint mid = beg + (end-beg)/2;
+    if(best_axis>=0)
+    {
+        auto it = std::partition(item_order.begin()+beg, item_order.begin()+end, [&](const uint id)
+        {
+            double c = build_items[id].centroid[best_axis];
+            return std::min(n_bins-1, uint((c-cmin[best_axis])*scale[best_axis])) <= best_bin;
+        });
+        uint pos = std::distance(item_order.begin(), it);
+        if(pos>beg && pos<end) mid = pos;
+    }
+    return mid;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Serially builds the subtree spanning item_order[beg,end), appending its nodes to subtree in depth-first
+// order. Offsets of inner nodes are relative to the beginning of subtree. Returns the depth of the deepest leaf
+CINO_INLINE
+uint BVH::build_subtree(const uint             beg,
+                        const uint             end,
+                        const uint             depth,
+                        std::vector<BVHNode> & subtree)
+{
+    AABB bbox = range_bbox(beg,end);
+
+    BVHNode node;
+    node.set_bbox(bbox);
+    uint pos = subtree.size();
+
+    if(end-beg<=items_per_leaf)
+    {
+        node.offset = beg;
+        node.count  = end-beg;
+        subtree.push_back(node);
+        return depth;
+    }
+
+    node.offset = 0;
+    node.count  = 0;
+    subtree.push_back(node);
+
+    uint mid     = split(beg, end);
+    uint depth_l = build_subtree(beg, mid, depth+1, subtree);
+    subtree[pos].offset = subtree.size();
+    uint depth_r = build_subtree(mid, end, depth+1, subtree);
+    return std::max(depth_l, depth_r);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_point(const uint id, const vec3d & v)
+{
+    items.push_point(id,v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_sphere(const uint id, const vec3d & c, const double r)
+{
+    items.push_sphere(id,c,r);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_segment(const uint id, const vec3d & v0, const vec3d & v1)
+{
+    items.push_segment(id,v0,v1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_triangle(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2)
+{
+    items.push_triangle(id,v0,v1,v2);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_tetrahedron(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & v3)
+{
+    items.push_tetrahedron(id,v0,v1,v2,v3);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint BVH::max_items_per_leaf() const
+{
+    uint max=0;
+    for(const BVHNode & n : nodes) max = std::max(max,n.count);
+    return max;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::debug_mode(const bool b)
+{
+    print_debug_info = b;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d BVH::closest_point(const vec3d & p) const
+{
+    uint   id;
+    vec3d  pos;
+    double dist;
+    closest_point(p, id, pos, dist);
+    return pos;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::closest_point(const vec3d  & p,            // query point
+                              uint   & id,           // id of the item T closest to p
+                              vec3d  & pos,          // point in T closest to p
+                              double & d_sqrd) const // SQUARED distance between pos and p
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    d_sqrd = inf_double;
+
+    // depth-first traversal, visiting the closest child first
+    // and discarding nodes farther than the best item found so far
+    std::vector<std::pair<uint,double>> stack;
+    stack.reserve(64);
+    stack.push_back(std::make_pair(0,nodes[0].dist_sqrd(p)));
+    while(!stack.empty())
+    {
+        uint   nid = stack.back().first;
+        double d   = stack.back().second;
+        stack.pop_back();
+        if(d>=d_sqrd) continue;
+
+        const BVHNode & n = nodes[nid];
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                uint   it = item_order[i];
+                vec3d  q  = items.point_closest_to(it,p);
+                double dq = q.dist_sqrd(p);
+                if(dq<d_sqrd)
+                {
+                    d_sqrd = dq;
+                    pos    = q;
+                    id     = items.id(it);
+                }
+            }
+        }
+        else
+        {
+            uint   l  = nid+1;
+            uint   r  = n.offset;
+            double dl = nodes[l].dist_sqrd(p);
+            double dr = nodes[r].dist_sqrd(p);
+            if(dl<dr)
+            {
+                std::swap(l,r);
+                std::swap(dl,dr);
+            }
+            // push the farthest child first, so that the closest one is popped first
+            if(dl<d_sqrd) stack.push_back(std::make_pair(l,dl));
+            if(dr<d_sqrd) stack.push_back(std::make_pair(r,dr));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Closest point\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+CINO_INLINE
+bool BVH::contains(const vec3d & p, const bool strict, uint & id) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    if(nodes[0].contains(p)) stack.push_back(0);
+    while(!stack.empty())
+    {
+        const BVHNode & n = nodes[stack.back()];
+        uint nid = stack.back();
+        stack.pop_back();
+
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                uint it = item_order[i];
+                if(items.contains(it,p,strict))
+                {
+                    id = items.id(it);
+                    if(print_debug_info)
+                    {
+                        Time::time_point t1 = Time::now();
+                        std::cout << "Contains query (first item)\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+                    }
+                    return true;
+                }
+            }
+        }
+        else
+        {
+            if(nodes[n.offset].contains(p)) stack.push_back(n.offset);
+            if(nodes[nid+1   ].contains(p)) stack.push_back(nid+1);
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+CINO_INLINE
+bool BVH::contains(const vec3d & p, const bool strict, std::unordered_set<uint> & ids) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    if(nodes[0].contains(p)) stack.push_back(0);
+    while(!stack.empty())
+    {
+        const BVHNode & n = nodes[stack.back()];
+        uint nid = stack.back();
+        stack.pop_back();
+
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                uint it = item_order[i];
+                if(items.contains(it,p,strict)) ids.insert(items.id(it));
+            }
+        }
+        else
+        {
+            if(nodes[n.offset].contains(p)) stack.push_back(n.offset);
+            if(nodes[nid+1   ].contains(p)) stack.push_back(nid+1);
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Contains query (all items)\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    vec3d inv_dir(1.0/dir[0], 1.0/dir[1], 1.0/dir[2]);
+    min_t = inf_double;
+
+    // front-to-back traversal: nodes farther than the closest hit found so far are discarded
+    std::vector<std::pair<uint,double>> stack;
+    stack.reserve(64);
+    double t;
+    if(nodes[0].intersects_ray(p, dir, inv_dir, t)) stack.push_back(std::make_pair(0,t));
+    while(!stack.empty())
+    {
+        uint nid = stack.back().first;
+        t        = stack.back().second;
+        stack.pop_back();
+        if(t>min_t) continue;
+
+        const BVHNode & n = nodes[nid];
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                uint  it = item_order[i];
+                vec3d pos;
+                if(items.intersects_ray(it, p, dir, t, pos) && t<min_t)
+                {
+                    min_t = t;
+                    id    = items.id(it);
+                }
+            }
+        }
+        else
+        {
+            double tl, tr;
+            bool hit_l = nodes[nid+1   ].intersects_ray(p, dir, inv_dir, tl) && tl<=min_t;
+            bool hit_r = nodes[n.offset].intersects_ray(p, dir, inv_dir, tr) && tr<=min_t;
+            if(hit_l && hit_r)
+            {
+                // push the farthest child first, so that the closest one is popped first
+                if(tl<tr)
+                {
+                    stack.push_back(std::make_pair(n.offset,tr));
+                    stack.push_back(std::make_pair(nid+1,tl));
+                }
+                else
+                {
+                    stack.push_back(std::make_pair(nid+1,tl));
+                    stack.push_back(std::make_pair(n.offset,tr));
+                }
+            }
+            else if(hit_l) stack.push_back(std::make_pair(nid+1,tl));
+            else if(hit_r) stack.push_back(std::make_pair(n.offset,tr));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects ray\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return min_t<inf_double;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,uint>> & all_hits) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    vec3d inv_dir(1.0/dir[0], 1.0/dir[1], 1.0/dir[2]);
+
+    std::vector<uint> stack;
+    stack.reserve(64);
+    double t;
+    if(nodes[0].intersects_ray(p, dir, inv_dir, t)) stack.push_back(0);
+    while(!stack.empty())
+    {
+        uint nid = stack.back();
+        stack.pop_back();
+
+        const BVHNode & n = nodes[nid];
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                uint  it = item_order[i];
+                vec3d pos;
+                if(items.intersects_ray(it, p, dir, t, pos))
+                {
+                    all_hits.insert(std::make_pair(t,items.id(it)));
+                }
+            }
+        }
+        else
+        {
+            if(nodes[n.offset].intersects_ray(p, dir, inv_dir, t)) stack.push_back(n.offset);
+            if(nodes[nid+1   ].intersects_ray(p, dir, inv_dir, t)) stack.push_back(nid+1);
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects ray\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !all_hits.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::intersects_rays(const std::vector<vec3d>  & p,
+                          const std::vector<vec3d>  & dir,
+                          const std::vector<uint>   & skip_ids,
+                                std::vector<double> & min_t,
+                                std::vector<uint>   & ids) const
+{
+    trace_rays(p, dir, skip_ids, min_t, ids, nullptr);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::intersects_rays(const std::vector<vec3d>  & p,
+                          const std::vector<vec3d>  & dir,
+                          const std::vector<uint>   & skip_ids,
+                                std::vector<double> & min_t,
+                                std::vector<uint>   & ids,
+                                std::vector<uint>   & n_hits) const
+{
+    trace_rays(p, dir, skip_ids, min_t, ids, &n_hits);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+CINO_INLINE
+bool BVH::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<uint> list;
+    items_in_box(AABB(std::vector<vec3d>{t[0],t[1],t[2]}), list);
+
+    for(uint i : list)
+    {
+        if(items.intersects_triangle(i, t, ignore_if_valid_complex))
+        {
+            ids.insert(items.id(i));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects triangle\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+CINO_INLINE
+bool BVH::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<uint> list;
+    items_in_box(AABB(s[0],s[1]), list);
+
+    for(uint i : list)
+    {
+        if(items.intersects_segment(i, s, ignore_if_valid_complex))
+        {
+            ids.insert(items.id(i));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects segment\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// WARNING: this function may return false positives because it only checks intersection between
+// the box b and the AABB of the items in the tree. This is a partial result that it is useful for
+// some of the queries above, where a more expensive test between the geometric entity approximated
+// by box b and the actual items will be performed
+CINO_INLINE
+bool BVH::intersects_box(const AABB & b, std::unordered_set<uint> & ids) const
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<uint> list;
+    items_in_box(b, list);
+    for(uint i : list) ids.insert(items.id(i));
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects box\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// appends to list the indices (in the item pool) of all items with AABB intersecting box b
+CINO_INLINE
+void BVH::items_in_box(const AABB & b, std::vector<uint> & list) const
+{
+    std::vector<uint> stack;
+    stack.reserve(64);
+    if(nodes[0].intersects_box(b)) stack.push_back(0);
+    while(!stack.empty())
+    {
+        uint nid = stack.back();
+        stack.pop_back();
+
+        const BVHNode & n = nodes[nid];
+        if(n.is_leaf())
+        {
+            for(uint i=n.offset; i<n.offset+n.count; ++i)
+            {
+                if(items.aabb(item_order[i]).intersects_box(b)) list.push_back(item_order[i]);
+            }
+        }
+        else
+        {
+            if(nodes[n.offset].intersects_box(b)) stack.push_back(n.offset);
+            if(nodes[nid+1   ].intersects_box(b)) stack.push_back(nid+1);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// in first hit mode nodes are visited front to back, and nodes are tested again when popped from the
+// stack if, in the meantime, rays have been clipped by a closer hit
+CINO_INLINE
+void BVH::trace_packet(RayPacket & packet, std::vector<RayPacket::StackEntry<uint>> & stack) const
+{
+    typedef RayPacket::StackEntry<uint> Entry;
+    double t[RAY_PACKET_SIZE], tl[RAY_PACKET_SIZE], tr[RAY_PACKET_SIZE];
+
+    stack.clear();
+    uint mask = packet.intersects_box(nodes[0].bmin, nodes[0].bmax, packet.rays(), t);
+    if(mask) stack.push_back(Entry{0, mask, 0});
+    while(!stack.empty())
+    {
+        Entry e = stack.back();
+        stack.pop_back();
+
+        const BVHNode & n = nodes[e.node];
+        mask = e.mask;
+        if(e.clips!=packet.clips)
+        {
+            mask = packet.intersects_box(n.bmin, n.bmax, mask, t);
+            if(!mask) continue;
+        }
+
+        if(n.is_leaf())
+        {
+            packet.intersects_items(items, &item_order[n.offset], n.count, mask);
+        }
+        else
+        {
+            uint l  = e.node+1;
+            uint r  = n.offset;
+            uint ml = packet.intersects_box(nodes[l].bmin, nodes[l].bmax, mask, tl);
+            uint mr = packet.intersects_box(nodes[r].bmin, nodes[r].bmax, mask, tr);
+
+            // push the farthest child first, so that the closest one is popped first
+            double dl = inf_double, dr = inf_double;
+            for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+            {
+                if(ml & (1u << i)) dl = std::min(dl, tl[i]);
+                if(mr & (1u << i)) dr = std::min(dr, tr[i]);
+            }
+            if(dl<dr)
+            {
+                if(mr) stack.push_back(Entry{r, mr, packet.clips});
+                if(ml) stack.push_back(Entry{l, ml, packet.clips});
+            }
+            else
+            {
+                if(ml) stack.push_back(Entry{l, ml, packet.clips});
+                if(mr) stack.push_back(Entry{r, mr, packet.clips});
+            }
+        }
+    }
+    packet.finalize();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// if n_hits is null only first hits are searched, otherwise all hits are collected and counted
+CINO_INLINE
+void BVH::trace_rays(const std::vector<vec3d>  & p,
+                     const std::vector<vec3d>  & dir,
+                     const std::vector<uint>   & skip_ids,
+                           std::vector<double> & min_t,
+                           std::vector<uint>   & ids,
+                           std::vector<uint>   * n_hits) const
+{
+    assert(p.size()==dir.size());
+    assert(skip_ids.empty() || skip_ids.size()==p.size());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    uint n_rays = p.size();
+    min_t.assign(n_rays, inf_double);
+    ids.assign(n_rays, max_uint);
+    if(n_hits) n_hits->assign(n_rays, 0);
+    if(n_rays==0 || nodes.empty()) return;
+
+    // threads process blocks of packets, reusing the same scratch buffers
+    const uint block_size = 16*RAY_PACKET_SIZE;
+    uint n_blocks = (n_rays + block_size - 1) / block_size;
+    PARALLEL_FOR(0, n_blocks, 2, 0, 1, [&](const uint b)
+    {
+        RayPacket packet;
+        std::vector<RayPacket::StackEntry<uint>> stack;
+        stack.reserve(tree_depth+2);
+        uint end = std::min(n_rays, (b+1)*block_size);
+        for(uint beg=b*block_size; beg<end; beg+=RAY_PACKET_SIZE)
+        {
+            uint size = std::min(RAY_PACKET_SIZE, end-beg);
+            packet.set(&p[beg], &dir[beg], skip_ids.empty() ? nullptr : &skip_ids[beg], size, n_hits!=nullptr);
+            trace_packet(packet, stack);
+            for(uint i=0; i<size; ++i)
+            {
+                min_t[beg+i] = packet.min_t[i];
+                ids  [beg+i] = packet.id[i];
+                if(n_hits) n_hits->at(beg+i) = packet.n_hits[i];
+            }
+        }
+    });
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects " << n_rays << " rays\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+}
+
+}
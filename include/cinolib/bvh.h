@@ -0,0 +1,298 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BVH_H
+#define CINO_BVH_H
+
+#include <cinolib/geometry/spatial_item_pool.h>
+#include <cinolib/geometry/ray_packet.h>
+#include <cinolib/meshes/meshes.h>
+#include <set>
+#include <unordered_set>
+
+namespace cinolib
+{
+
+/* Nodes of the BVH are stored in a flat array, in depth-first order. The left
+ * child of an inner node immediately follows its parent, whereas the position
+ * of the right child is stored in the node. Leaves store a contiguous range of
+ * BVH::item_order. Bounding boxes are stored in single precision (rounded
+ * outwards, hence conservative) so that each node fits in 32 bytes, and two
+ * nodes share the same cache line.
+*/
+
+struct BVHNode
+{
+    float bmin[3];
+    uint  offset; // inner nodes: index of the right child. leaves: first entry in BVH::item_order
+    float bmax[3];
+    uint  count;  // number of items in the leaf (zero for inner nodes)
+
+    bool is_leaf() const { return count>0; }
+
+    void   set_bbox      (const AABB & b);
+    double dist_sqrd     (const vec3d & p) const;
+    bool   contains      (const vec3d & p) const;
+    bool   intersects_box(const AABB  & b) const;
+    bool   intersects_ray(const vec3d & p, const vec3d & dir, const vec3d & inv_dir, double & t_min) const;
+};
+static_assert(sizeof(BVHNode)==32, "BVHNode is expected to be 32 bytes long");
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Bounding Volume Hierarchy built with the binned Surface Area Heuristic.
+ * Differently from the Octree, each item is referenced by exactly one leaf,
+ * hence queries never process the same item twice and the memory footprint
+ * is linear in the number of items. Construction is parallel: the top levels
+ * of the tree are split serially, and the resulting subtrees are then built
+ * concurrently and stitched together in depth-first order. The tree does not
+ * depend on the number of threads used to build it.
+ *
+ * Usage is the same as for the Octree:
+ *
+ *  i)   Create an empty BVH
+ *  ii)  Use the push_segment/triangle/tetrahedron facilities to populate it
+ *  iii) Call build to make the tree
+ *
+ * Refs:
+ * On fast Construction of SAH-based Bounding Volume Hierarchies
+ * I. Wald
+ * IEEE Symposium on Interactive Ray Tracing, 2007
+*/
+
+class BVH
+{
+    public:
+
+        explicit BVH(const uint items_per_leaf = 4);
+
+        virtual ~BVH() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push_point      (const uint id, const vec3d &  v);
+        void push_sphere     (const uint id, const vec3d &  c, const double   r);
+        void push_segment    (const uint id, const vec3d & v0, const vec3d & v1);
+        void push_triangle   (const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2);
+        void push_tetrahedron(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & v3);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_polys(const AbstractPolygonMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            items.reserve(m.num_polys());
+            for(uint pid=0; pid<m.num_polys(); ++pid)
+            {
+                for(uint i=0; i<m.poly_tessellation(pid).size()/3; ++i)
+                {
+                    vec3d v0 = m.vert(m.poly_tessellation(pid).at(3*i+0));
+                    vec3d v1 = m.vert(m.poly_tessellation(pid).at(3*i+1));
+                    vec3d v2 = m.vert(m.poly_tessellation(pid).at(3*i+2));
+                    push_triangle(pid,v0,v1,v2);
+                }
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class F, class P>
+        void build_from_mesh_polys(const AbstractPolyhedralMesh<M,V,E,F,P> & m)
+        {
+            assert(items.empty());
+            items.reserve(m.num_polys(), TETRAHEDRON);
+            for(uint pid=0; pid<m.num_polys(); ++pid)
+            {
+                switch(m.mesh_type())
+                {
+                    case TETMESH : push_tetrahedron(pid,
+                                                    m.poly_vert(pid,0),
+                                                    m.poly_vert(pid,1),
+                                                    m.poly_vert(pid,2),
+                                                    m.poly_vert(pid,3)); break;
+                    default: assert(false && "Unsupported element");
+                }
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build_from_vectors(const std::vector<vec3d> & verts,
+                                const std::vector<uint>  & tris)
+        {
+            assert(items.empty());
+            items.reserve(tris.size()/3);
+            for(uint i=0; i<tris.size(); i+=3)
+            {
+                push_triangle(i/3, verts.at(tris.at(i  )),
+                                   verts.at(tris.at(i+1)),
+                                   verts.at(tris.at(i+2)));
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_edges(const AbstractMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            items.reserve(m.num_edges(), SEGMENT);
+            for(uint eid=0; eid<m.num_edges(); ++eid)
+            {
+                push_segment(eid, m.edge_vert(eid,0),
+                                  m.edge_vert(eid,1));
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_points(const AbstractMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            items.reserve(m.num_verts(), POINT);
+            for(uint vid=0; vid<m.num_verts(); ++vid)
+            {
+                push_point(vid, m.vert(vid));
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint max_items_per_leaf() const;
+        uint depth() const { return tree_depth; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void debug_mode(const bool b);
+
+        // QUERIES :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // returns pos, id and distance of the item that is closest to query point p
+        void  closest_point(const vec3d & p, uint & id, vec3d & pos, double & d_sqrd) const;
+        vec3d closest_point(const vec3d & p) const;
+
+        // returns respectively the first item and the full list of items containing query point p
+        // note: this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+        bool contains(const vec3d & p, const bool strict, uint & id) const;
+        bool contains(const vec3d & p, const bool strict, std::unordered_set<uint> & ids) const;
+
+        // returns respectively the first and the full list of intersections
+        // between items in the BVH and a ray R(t) := p + t * dir
+        bool intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const; // first hit
+        bool intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,uint>> & all_hits) const;
+
+        // batched ray queries, traced in packets of coherent rays (see Octree::intersects_rays)
+        void intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,   // first hit
+                                   std::vector<uint>   & ids) const;
+        // also returns the number of hits along each ray, at the price of a full traversal
+        void intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,   // first hit
+                                   std::vector<uint>   & ids,
+                                   std::vector<uint>   & n_hits) const;
+
+        // note: these queries become exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
+        bool intersects_segment (const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
+        bool intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
+
+        // WARNING: this function may return false positives because it only checks intersection between
+        // the box b and the AABB of the items in the tree (see Octree::intersects_box)
+        bool intersects_box(const AABB & b, std::unordered_set<uint> & ids) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // all items live here. Leaves index a range of item_order, which in turn indexes items
+        SpatialItemPool      items;
+        std::vector<uint>    item_order;
+        std::vector<BVHNode> nodes; // nodes[0] is the root
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        protected:
+
+        uint items_per_leaf;  // nodes with at most this number of items are not split
+        uint tree_depth = 0;  // actual depth of the tree
+        bool print_debug_info = false;
+
+        // SUPPORT STRUCTURES ::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // node of the top levels of the tree, split serially before spawning parallel subtrees
+        struct TopNode
+        {
+            uint beg, end, depth;
+            int  left  = -1;
+            int  right = -1;
+            int  task  = -1;
+            AABB bbox;
+        };
+
+        // compact copy of the item bounds, only alive during build()
+        struct BuildItem
+        {
+            vec3d min, max, centroid;
+        };
+        std::vector<BuildItem> build_items;
+
+        AABB range_bbox   (const uint beg, const uint end) const;
+        uint split        (const uint beg, const uint end);
+        uint build_subtree(const uint beg, const uint end, const uint depth, std::vector<BVHNode> & subtree);
+        void items_in_box (const AABB & b, std::vector<uint> & list) const;
+        void trace_packet (RayPacket & packet, std::vector<RayPacket::StackEntry<uint>> & stack) const;
+        void trace_rays   (const std::vector<vec3d> & p, const std::vector<vec3d> & dir, const std::vector<uint> & skip_ids,
+                           std::vector<double> & min_t, std::vector<uint> & ids, std::vector<uint> * n_hits) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "bvh.cpp"
+#endif
+
+#endif // CINO_BVH_H
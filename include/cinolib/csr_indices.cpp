@@ -0,0 +1,182 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/csr_indices.h>
+#include <stdexcept>
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace cinolib
+{
+
+CINO_INLINE
+const uint & IndexSpan::at(const uint i) const
+{
+    if(i >= len) throw std::out_of_range("IndexSpan::at");
+    return ptr[i];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator==(const IndexSpan & s0, const IndexSpan & s1)
+{
+    return s0.size() == s1.size() && std::equal(s0.begin(), s0.end(), s1.begin());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator!=(const IndexSpan & s0, const IndexSpan & s1)
+{
+    return !(s0 == s1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+CSRIndices::CSRIndices(const std::vector<std::vector<uint>> & lists)
+{
+    assign(lists);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CSRIndices::assign(const std::vector<std::vector<uint>> & lists)
+{
+    offsets.resize(lists.size()+1);
+    offsets[0] = 0;
+    for(uint i=0; i<lists.size(); ++i)
+    {
+        offsets[i+1] = offsets[i] + uint(lists[i].size());
+    }
+
+    ids.resize(offsets.back());
+    ids.shrink_to_fit();
+    for(uint i=0; i<lists.size(); ++i)
+    {
+        std::copy(lists[i].begin(), lists[i].end(), ids.begin() + offsets[i]);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+CSRIndices::CSRIndices(std::vector<uint> && offsets, std::vector<uint> && ids)
+{
+    assign(std::move(offsets), std::move(ids));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CSRIndices::assign(std::vector<uint> && offsets, std::vector<uint> && ids)
+{
+    assert(!offsets.empty() && offsets.front()==0 && offsets.back()==ids.size());
+    this->offsets = std::move(offsets);
+    this->ids     = std::move(ids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CSRIndices::clear()
+{
+    // swap with empty containers to actually release memory
+    std::vector<uint>().swap(offsets);
+    std::vector<uint>().swap(ids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+IndexSpan CSRIndices::at(const uint i) const
+{
+    if(i >= size()) throw std::out_of_range("CSRIndices::at");
+    return operator[](i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<uint>> CSRIndices::to_nested() const
+{
+    std::vector<std::vector<uint>> lists(size());
+    for(uint i=0; i<size(); ++i)
+    {
+        lists[i].assign(ids.begin() + offsets[i], ids.begin() + offsets[i+1]);
+    }
+    return lists;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CSRIndices::ids_below(const uint n) const
+{
+    for(uint id : ids) if(id >= n) return false;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const std::vector<std::vector<uint>> & CSRNestedCache::get(const CSRIndices & csr) const
+{
+    if(valid.load(std::memory_order_acquire)) return lists;
+    std::lock_guard<std::mutex> lock(mtx);
+    if(!valid.load(std::memory_order_relaxed))
+    {
+        lists = csr.to_nested();
+        valid.store(true, std::memory_order_release);
+    }
+    return lists;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CSRNestedCache::reset()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    valid.store(false, std::memory_order_relaxed);
+    std::vector<std::vector<uint>>().swap(lists);
+}
+
+}
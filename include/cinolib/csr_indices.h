@@ -0,0 +1,178 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_CSR_INDICES_H
+#define CINO_CSR_INDICES_H
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Read-only view of a contiguous list of indices. Mesh adjacency accessors
+ * return spans, so that callers do not depend on whether connectivity is
+ * stored as a vector of vectors (editable) or in compressed form (frozen).
+ * Like a reference to a std::vector, a span is invalidated by any edit of the
+ * container it refers to. Use to_vector() to get a standalone copy.
+*/
+
+class IndexSpan
+{
+    public:
+
+        IndexSpan() : ptr(nullptr), len(0) {}
+        IndexSpan(const uint * ptr, const uint len) : ptr(ptr), len(len) {}
+        IndexSpan(const std::vector<uint> & v) : ptr(v.data()), len(uint(v.size())) {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const uint * begin() const { return ptr;       }
+        const uint * end()   const { return ptr + len; }
+        const uint * data()  const { return ptr;       }
+              uint   size()  const { return len;       }
+              bool   empty() const { return len == 0;  }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const uint & operator[](const uint i) const { return ptr[i];       }
+        const uint & front()                  const { return ptr[0];       }
+        const uint & back()                   const { return ptr[len - 1]; }
+        const uint & at(const uint i)         const; // throws std::out_of_range, as std::vector::at
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<uint> to_vector() const { return std::vector<uint>(begin(), end()); }
+        operator std::vector<uint>()  const { return to_vector(); }
+
+    private:
+
+        const uint * ptr;
+              uint   len;
+};
+
+CINO_INLINE bool operator==(const IndexSpan & s0, const IndexSpan & s1);
+CINO_INLINE bool operator!=(const IndexSpan & s0, const IndexSpan & s1);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Compressed Sparse Row storage for a list of index lists. All lists are
+ * serialized in a single buffer, and the i-th list spans the range
+ * [offsets[i], offsets[i+1]). Compared to a std::vector<std::vector<uint>>
+ * it costs one heap allocation overall (instead of one per list) and 4 bytes
+ * of header per list (instead of 24). Lists cannot be resized after creation.
+*/
+
+class CSRIndices
+{
+    public:
+
+        explicit CSRIndices() {}
+        explicit CSRIndices(const std::vector<std::vector<uint>> & lists);
+        explicit CSRIndices(std::vector<uint> && offsets, std::vector<uint> && ids);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void assign(const std::vector<std::vector<uint>> & lists);
+        void assign(std::vector<uint> && offsets, std::vector<uint> && ids); // adopts already serialized lists
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint size()  const { return offsets.empty() ? 0 : uint(offsets.size()-1); }
+        bool empty() const { return size() == 0; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        IndexSpan operator[](const uint i) const { return IndexSpan(ids.data() + offsets[i], offsets[i+1] - offsets[i]); }
+        IndexSpan at        (const uint i) const; // throws std::out_of_range, as std::vector::at
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<std::vector<uint>> to_nested() const;
+
+        // true if all ids are smaller than n (e.g. to validate lists read from file)
+        bool ids_below(const uint n) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const std::vector<uint> & vector_offsets() const { return offsets; }
+        const std::vector<uint> & vector_ids()     const { return ids;     }
+
+    private:
+
+        std::vector<uint> offsets;
+        std::vector<uint> ids;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Nested copy of a CSRIndices, expanded on first request. It lets const
+ * accessors that return a std::vector<std::vector<uint>> reference keep
+ * working on data stored in CSR form. It can be queried concurrently. The
+ * owner must call reset() whenever the source lists change, which also
+ * invalidates any reference previously returned. Copies start empty.
+*/
+
+class CSRNestedCache
+{
+    public:
+
+        CSRNestedCache() {}
+        CSRNestedCache(const CSRNestedCache &) {}
+        CSRNestedCache & operator=(const CSRNestedCache &) { reset(); return *this; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const std::vector<std::vector<uint>> & get(const CSRIndices & csr) const;
+              void                             reset();
+
+    private:
+
+        mutable std::mutex                     mtx;
+        mutable std::atomic<bool>              valid{false};
+        mutable std::vector<std::vector<uint>> lists;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "csr_indices.cpp"
+#endif
+
+#endif // CINO_CSR_INDICES_H
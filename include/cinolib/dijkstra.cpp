@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/dijkstra.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/indexed_heap.h>
 #include <cinolib/stl_container_utilities.h>
 
 namespace cinolib
@@ -42,24 +43,25 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why std::set and not
-// std::unordered_set or std::priority_queue?
+// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why not std::set or
+// std::priority_queue?
 //
-// The reason why I am using std::set is that Dijkstra requires priority
-// update, which is supported by none of the STL containers. Options are:
+// Dijkstra requires priority update, which is supported by none of the
+// STL containers. Options are:
 //
-//  1) remove an element and re-add it with updated priority. In this
-//     case std::set has the best remove performances
+//  1) remove an element and re-add it with updated priority (std::set).
+//     Each insertion allocates a tree node, and the tree has poor locality
 //
 //  2) leave "dead" copies of an element in the container, and just add a
-//     new copy each time its priority needs an update. Regardless the waste
-//     of memory, which is an issue by itself, in this case at each iteration
-//     you need a mechanism that allows you to discard the current element
-//     if it is not the one with the most recent priority...
+//     new copy each time its priority needs an update (std::priority_queue).
+//     The queue grows with the number of updates, and stale copies must be
+//     recognized and discarded at extraction time
 //
-// I therefore decided to go for (1).
-// See also:
-// https://stackoverflow.com/questions/649640/how-to-do-an-efficient-priority-update-in-stl-priority-queue
+// All the functions below use an IndexedHeap instead, which updates
+// priorities in place and allocates only once. Ties are broken as std::set
+// would, so paths are the same one would get with (1). Applications that
+// run many queries on the same mesh should use DijkstraEngine, which also
+// recycles all scratch buffers across calls and supports early termination.
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -72,13 +74,12 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_v2v(vid))
         {
@@ -86,14 +87,8 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -110,13 +105,12 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_v2v(vid))
         {
@@ -124,14 +118,8 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -148,13 +136,12 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint eid : m.adj_v2e(vid))
         {
@@ -165,14 +152,8 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
 
                 if(dist.at(nbr) > new_dist)
                 {
-                    if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                    {
-                        auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                        assert(it!=q.end());
-                        q.erase(it);
-                    }
                     dist.at(nbr) = new_dist;
-                    q.insert(std::make_pair(new_dist,nbr));
+                    q.push_or_decrease(nbr,new_dist);
                 }
             }
         }
@@ -191,13 +172,12 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint eid : m.adj_v2e(vid))
         {
@@ -208,14 +188,8 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -234,13 +208,12 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(uint vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    for(uint vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap<> q(m.num_verts());
+    for(uint vid : sources) q.push_or_decrease(vid,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint eid : m.adj_v2e(vid))
         {
@@ -251,14 +224,8 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -280,13 +247,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -302,15 +268,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -335,13 +295,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -357,15 +316,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -391,13 +344,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -415,15 +367,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -451,13 +397,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -478,15 +423,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -517,13 +456,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -541,15 +479,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -580,13 +512,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -607,15 +538,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -647,13 +572,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_verts());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -671,15 +595,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -700,13 +618,12 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_p2p(vid))
         {
@@ -714,14 +631,8 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -737,18 +648,17 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 {
     dist = std::vector<double>(m.num_polys(), inf_double);
 
-    std::set<std::pair<double,uint>> q;
+    IndexedHeap<> q(m.num_polys());
 
     for(uint s : sources)
     {
         dist.at(s) = 0.0;
-        q.insert(std::make_pair(0.0,s));
+        q.push_or_decrease(s,0.0);
     }
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         for(uint nbr : m.adj_p2p(vid))
         {
@@ -756,14 +666,8 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -785,13 +689,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -807,15 +710,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -840,13 +737,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(vid==dest)
         {
@@ -864,15 +760,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -899,13 +789,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -923,15 +812,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -957,13 +840,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,uint>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap<> q(m.num_polys());
+    q.push(source,0.0);
 
     while(!q.empty())
     {
-        uint vid = q.begin()->second;
-        q.erase(q.begin());
+        uint vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -979,15 +861,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push_or_decrease(nbr,new_dist);
             }
         }
     }
@@ -0,0 +1,198 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/dijkstra_engine.h>
+#include <cinolib/thread_pool.h>
+#include <algorithm>
+#include <cassert>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void DijkstraEngine::resize(const uint n_nodes)
+{
+    dist_.assign(n_nodes, inf_double);
+    prev_.assign(n_nodes, -1);
+    stamp.assign(n_nodes, 0);
+    query = 0;
+    settled_.clear();
+    queue.resize(n_nodes);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::reset()
+{
+    queue.clear();
+    settled_.clear();
+    if(++query==0) // counter wrap around: invalidate everything explicitly
+    {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        query = 1;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::relax(const uint id, const uint nbr, const double d)
+{
+    if(stamp[nbr]!=query)
+    {
+        stamp[nbr] = query;
+        dist_[nbr] = inf_double;
+        prev_[nbr] = -1;
+    }
+    if(d<dist_[nbr])
+    {
+        dist_[nbr] = d;
+        prev_[nbr] = int(id);
+        queue.push_or_decrease(nbr, d);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Adj, class Weight>
+CINO_INLINE
+void DijkstraEngine::run(const std::vector<uint> & sources,
+                         const Adj               & adj,
+                         const Weight            & weight,
+                         const uint                target,
+                         const double              max_dist)
+{
+    reset();
+
+    for(uint s : sources)
+    {
+        assert(s<size());
+        relax(s, s, 0.0);
+        prev_[s] = -1;
+    }
+
+    while(!queue.empty())
+    {
+        uint id = queue.pop();
+        settled_.push_back(id);
+        if(id==target) return;
+
+        double d = dist_[id];
+        for(uint nbr : adj(id))
+        {
+            double new_dist = d + weight(id,nbr);
+            if(new_dist<=max_dist) relax(id, nbr, new_dist);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void DijkstraEngine::run(const AbstractMesh<M,V,E,P> & m,
+                         const std::vector<uint>     & sources,
+                         const uint                    target,
+                         const double                  max_dist)
+{
+    if(size()!=m.num_verts()) resize(m.num_verts());
+
+    run(sources,
+        [&m](const uint vid) { return m.adj_v2v(vid); },
+        [&m](const uint vid, const uint nbr) { return m.vert(vid).dist(m.vert(nbr)); },
+        target, max_dist);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::path_to(const uint id, std::vector<uint> & path) const
+{
+    path.clear();
+    if(dist(id)==inf_double) return;
+    int tmp = id;
+    do { path.push_back(tmp); tmp = prev_[tmp]; } while(tmp!=-1);
+    std::reverse(path.begin(), path.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::copy_dist(std::vector<double> & d) const
+{
+    d.resize(size());
+    for(uint id=0; id<size(); ++id) d[id] = dist(id);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+DistanceMatrix dijkstra_distance_matrix(const AbstractMesh<M,V,E,P> & m,
+                                        const std::vector<uint>     & sources,
+                                        const double                  max_dist)
+{
+    uint nv = m.num_verts();
+    DistanceMatrix D(sources.size(), nv);
+
+    auto fill_row = [&](DijkstraEngine & engine, const uint i)
+    {
+        engine.run(m, {sources[i]}, max_uint, max_dist);
+        float *row = D.data() + size_t(i)*nv;
+        std::fill(row, row+nv, inf_float);
+        for(uint vid : engine.settled()) row[vid] = float(engine.dist(vid));
+    };
+
+#ifndef SERIALIZE_PARALLEL_FOR
+    if(sources.size()>1 && !ThreadPool::in_parallel_region())
+    {
+        // PARALLEL_FOR does not expose thread ids, but here each thread
+        // needs its own engine. Engines are sized at their first query
+        ThreadPool & pool = ThreadPool::instance();
+        std::vector<DijkstraEngine> engines(pool.num_threads());
+        pool.run(0, uint(sources.size()), 0, 1, [&](uint k1, uint k2, uint tid)
+        {
+            for(uint i=k1; i<k2; ++i) fill_row(engines[tid], i);
+        });
+        return D;
+    }
+#endif
+    DijkstraEngine engine(nv);
+    for(uint i=0; i<sources.size(); ++i) fill_row(engine, i);
+    return D;
+}
+
+}
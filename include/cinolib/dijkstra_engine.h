@@ -0,0 +1,143 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_DIJKSTRA_ENGINE_H
+#define CINO_DIJKSTRA_ENGINE_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/indexed_heap.h>
+#include <cinolib/meshes/abstract_mesh.h>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Reusable single/multi source shortest path solver. Meant for applications
+ * that run many queries on the same graph (e.g. geodesic distances from many
+ * seeds): all the scratch buffers (distances, predecessors, priority queue)
+ * are kept across calls, and entries touched by a previous query are not
+ * reset explicitly but invalidated by bumping a query counter. Hence, the cost
+ * of a query is proportional to the number of nodes it reaches, not to the
+ * size of the graph. A query can stop early as soon as a target node is
+ * reached and/or all nodes within a given distance have been settled.
+ *
+ * The graph is given by two callables: adj(id) returns an iterable range of
+ * neighbor ids, and weight(id,nbr) the (non negative) cost of the arc id->nbr.
+ *
+ * After each query, settled() lists the nodes whose shortest distance has been
+ * determined, sorted by distance. Distances and predecessors of nodes not in
+ * this list are just upper bounds (inf_double/-1 for nodes never reached).
+*/
+
+class DijkstraEngine
+{
+    public:
+
+        explicit DijkstraEngine(const uint n_nodes = 0) { resize(n_nodes); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void resize(const uint n_nodes);
+        uint size() const { return uint(dist_.size()); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class Adj, class Weight>
+        void run(const std::vector<uint> & sources,
+                 const Adj               & adj,
+                 const Weight            & weight,
+                 const uint                target   = max_uint,     // stop as soon as the target is settled
+                 const double              max_dist = inf_double);  // do not visit nodes farther than this
+
+        // shortest paths along the edges of a mesh (arc weights are edge lengths)
+        template<class M, class V, class E, class P>
+        void run(const AbstractMesh<M,V,E,P> & m,
+                 const std::vector<uint>     & sources,
+                 const uint                    target   = max_uint,
+                 const double                  max_dist = inf_double);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double dist(const uint id) const { return (stamp[id]==query) ? dist_[id] : inf_double; }
+        int    prev(const uint id) const { return (stamp[id]==query) ? prev_[id] : -1;         }
+
+        const std::vector<uint> & settled() const { return settled_; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void path_to  (const uint id, std::vector<uint> & path) const; // empty if id was not reached
+        void copy_dist(std::vector<double> & d) const;                 // dense copy, inf_double for unreached nodes
+
+    protected:
+
+        void reset();
+        void relax(const uint id, const uint nbr, const double d);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<double> dist_;
+        std::vector<int>    prev_;
+        std::vector<uint>   stamp; // stamp[id]!=query means dist_[id] and prev_[id] are stale
+        uint                query = 0;
+        std::vector<uint>   settled_;
+        IndexedHeap<4>      queue;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+typedef Eigen::Matrix<float,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> DistanceMatrix;
+
+// Dense matrix of shortest path distances along mesh edges, having a row for
+// each source and a column for each vertex. Sources are processed in parallel,
+// each thread reusing its own DijkstraEngine. Distances are stored in single
+// precision to halve memory. Vertices farther than max_dist from a source (or
+// not reachable at all) get inf_float.
+//
+template<class M, class V, class E, class P>
+CINO_INLINE
+DistanceMatrix dijkstra_distance_matrix(const AbstractMesh<M,V,E,P> & m,
+                                        const std::vector<uint>     & sources,
+                                        const double                  max_dist = inf_double);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "dijkstra_engine.cpp"
+#endif
+
+#endif // CINO_DIJKSTRA_ENGINE_H
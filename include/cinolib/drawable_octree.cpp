@@ -61,8 +61,8 @@ void DrawableOctree::draw(const float ) const
 CINO_INLINE
 vec3d DrawableOctree::scene_center() const
 {
-    if(this->root==nullptr) return vec3d(0,0,0);
-    return this->root->bbox.center();
+    if(this->root()==nullptr) return vec3d(0,0,0);
+    return this->root()->bbox.center();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -70,8 +70,8 @@ vec3d DrawableOctree::scene_center() const
 CINO_INLINE
 float DrawableOctree::scene_radius() const
 {
-    if(this->root==nullptr) return 0.f;
-    return float(this->root->bbox.diag());
+    if(this->root()==nullptr) return 0.f;
+    return float(this->root()->bbox.diag());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -80,20 +80,10 @@ CINO_INLINE
 void DrawableOctree::updateGL()
 {
     render_list.clear();
-    if(this->root==nullptr) return;
-    updateGL(this->root);
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void DrawableOctree::updateGL(const OctreeNode *node)
-{
-    render_list.push_back(DrawableAABB(node->bbox.min, node->bbox.max));
-    if(node->is_inner())
+    render_list.reserve(this->nodes.size());
+    for(const OctreeNode & node : this->nodes)
     {
-        assert(node->item_indices.empty());
-        for(int i=0; i<8; ++i) updateGL(node->children[i]);
+        render_list.push_back(DrawableAABB(node.bbox.min, node.bbox.max));
     }
 }
 
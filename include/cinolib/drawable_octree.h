@@ -65,7 +65,6 @@ class DrawableOctree : public Octree, public DrawableObject
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         void updateGL();
-        void updateGL(const OctreeNode * node);
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -0,0 +1,205 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/fast_winding_number.h>
+#include <cinolib/solid_angle.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/pi.h>
+#include <cmath>
+
+namespace cinolib
+{
+
+CINO_INLINE
+FastWindingNumber::FastWindingNumber(const double beta, const uint order)
+: beta(beta)
+, order(order)
+{
+    assert(order==1 || order==2);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::build(const std::vector<vec3d> & verts,
+                              const std::vector<uint>  & tris)
+{
+    bvh = BVH();
+    bvh.build_from_vectors(verts, tris);
+    build_expansions();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double FastWindingNumber::eval(const vec3d & p) const
+{
+    if(expansions.empty()) return 0.0;
+    return eval(0,p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::eval(const std::vector<vec3d> & points, std::vector<double> & w) const
+{
+    w.resize(points.size());
+    PARALLEL_FOR(0, points.size(), 100, [&](const uint i)
+    {
+        w[i] = eval(points[i]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double FastWindingNumber::eval(const uint nid, const vec3d & p) const
+{
+    const Expansion & e = expansions[nid];
+    vec3d  r  = e.center - p;
+    double d2 = r.norm_sqrd();
+    if(d2 > beta*beta*e.radius*e.radius)
+    {
+        // far field: Taylor expansion of the dipole kernel r/|r|^3 around the center of the node
+        double d3 = d2*std::sqrt(d2);
+        double w  = r.dot(e.dipole)/d3;
+        if(order>1) w += e.moment.trace()/d3 - 3.0*r.dot(e.moment*r)/(d3*d2);
+        return w/(4.0*M_PI);
+    }
+
+    const BVHNode & n = bvh.nodes[nid];
+    if(n.is_leaf())
+    {
+        // near field: exact
+        double w = 0.0;
+        for(uint i=n.offset; i<n.offset+n.count; ++i)
+        {
+            const vec3d *t = bvh.items.verts(bvh.item_order[i]);
+            w += solid_angle(t[0], t[1], t[2], p);
+        }
+        return w;
+    }
+    return eval(nid+1,p) + eval(n.offset,p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Expansions are computed bottom up. Since BVH nodes are stored in depth first order,
+// children always come after their parent, and a backward visit meets them first
+CINO_INLINE
+void FastWindingNumber::build_expansions()
+{
+    const std::vector<BVHNode> & nodes = bvh.nodes;
+    expansions.resize(nodes.size());
+
+    // sums of area, area weighted centroids, area weighted normals and
+    // (area weighted normal) x (centroid), from which expansions are derived
+    std::vector<double> area(nodes.size(), 0.0);
+    std::vector<vec3d>  ac  (nodes.size(), vec3d(0,0,0));
+    std::vector<vec3d>  an  (nodes.size(), vec3d(0,0,0));
+    std::vector<mat3d>  anc (nodes.size(), mat3d::ZERO());
+
+    auto outer = [](const vec3d & a, const vec3d & b)
+    {
+        return mat3d({a[0]*b[0], a[0]*b[1], a[0]*b[2],
+                      a[1]*b[0], a[1]*b[1], a[1]*b[2],
+                      a[2]*b[0], a[2]*b[1], a[2]*b[2]});
+    };
+
+    auto set_center = [&](const uint nid)
+    {
+        Expansion & e = expansions[nid];
+        const BVHNode & n = nodes[nid];
+        if(area[nid]>0) e.center = ac[nid]/area[nid];
+        else            e.center = vec3d(0.5*(n.bmin[0]+n.bmax[0]), 0.5*(n.bmin[1]+n.bmax[1]), 0.5*(n.bmin[2]+n.bmax[2]));
+        e.dipole = an[nid];
+        e.moment = anc[nid] - outer(an[nid], e.center);
+    };
+
+    // leaves are independent from each other
+    PARALLEL_FOR(0, nodes.size(), 1000, [&](const uint nid)
+    {
+        const BVHNode & n = nodes[nid];
+        if(!n.is_leaf()) return;
+
+        for(uint i=n.offset; i<n.offset+n.count; ++i)
+        {
+            uint it = bvh.item_order[i];
+            assert(bvh.items.type(it)==TRIANGLE);
+            const vec3d *t = bvh.items.verts(it);
+            vec3d  n2 = (t[1]-t[0]).cross(t[2]-t[0]); // twice the area weighted normal
+            double a  = 0.5*n2.norm();
+            vec3d  c  = (t[0]+t[1]+t[2])/3.0;
+            area[nid] += a;
+            ac  [nid] += c*a;
+            an  [nid] += n2*0.5;
+            anc [nid] += outer(n2*0.5, c);
+        }
+        set_center(nid);
+
+        double r = 0.0;
+        for(uint i=n.offset; i<n.offset+n.count; ++i)
+        {
+            const vec3d *t = bvh.items.verts(bvh.item_order[i]);
+            for(uint j=0; j<3; ++j) r = std::max(r, t[j].dist(expansions[nid].center));
+        }
+        expansions[nid].radius = r;
+    });
+
+    for(uint nid=nodes.size(); nid-- > 0;)
+    {
+        const BVHNode & n = nodes[nid];
+        if(n.is_leaf()) continue;
+
+        uint l = nid+1;
+        uint r = n.offset;
+        area[nid] = area[l] + area[r];
+        ac  [nid] = ac  [l] + ac  [r];
+        an  [nid] = an  [l] + an  [r];
+        anc [nid] = anc [l] + anc [r];
+        set_center(nid);
+
+        // the ball must contain both children balls. The farthest corner of the bounding
+        // box gives another bound, tighter when the centers of the children are far apart
+        const Expansion & e = expansions[nid];
+        double r_balls = std::max(e.center.dist(expansions[l].center) + expansions[l].radius,
+                                  e.center.dist(expansions[r].center) + expansions[r].radius);
+        vec3d far;
+        for(uint j=0; j<3; ++j) far[j] = std::max(std::fabs(e.center[j]-n.bmin[j]), std::fabs(n.bmax[j]-e.center[j]));
+        expansions[nid].radius = std::min(r_balls, far.norm());
+    }
+}
+
+}
@@ -0,0 +1,128 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FAST_WINDING_NUMBER_H
+#define CINO_FAST_WINDING_NUMBER_H
+
+#include <cinolib/bvh.h>
+
+namespace cinolib
+{
+
+/* Fast approximation of the generalized winding number of a triangle soup.
+ * Triangles are organized in a BVH, and each node stores a multipole
+ * expansion of the contribution of all its triangles, centered at their
+ * area weighted centroid. Query points that are far enough from a node
+ * (i.e. farther than beta times the radius of the node) use its expansion,
+ * otherwise the query descends to the children. Triangles in the leaves
+ * close to the query point are evaluated exactly, with their solid angle.
+ *
+ * The accuracy is controlled by beta (higher is more accurate, but slower)
+ * and by the order of the expansion:
+ *
+ *   order 1 : dipole only (i.e. the sum of the area weighted normals)
+ *   order 2 : dipole plus its first derivative (default)
+ *
+ * Differently from the exact sum (see winding_number.h), which costs
+ * O(#tris) per query, each query is roughly logarithmic in the number of
+ * triangles. Queries are thread safe, and the batched version processes
+ * points in parallel.
+ *
+ * Ref:
+ * Fast Winding Numbers for Soups and Clouds
+ * G. Barill, N.G. Dickson, R. Schmidt, D.I.W. Levin, A. Jacobson
+ * ACM Transactions on Graphics (SIGGRAPH), 2018
+*/
+
+class FastWindingNumber
+{
+    public:
+
+        explicit FastWindingNumber(const double beta  = 2.0,
+                                   const uint   order = 2);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build(const std::vector<vec3d> & verts,
+                   const std::vector<uint>  & tris);
+
+        template<class M, class V, class E, class P>
+        void build(const AbstractPolygonMesh<M,V,E,P> & m)
+        {
+            bvh = BVH();
+            bvh.build_from_mesh_polys(m);
+            build_expansions();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // generalized winding number at p (~1 inside, ~0 outside, for watertight surfaces)
+        double eval(const vec3d & p) const;
+
+        // batched evaluation, in parallel
+        void eval(const std::vector<vec3d> & points, std::vector<double> & w) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double beta;
+        uint   order;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        // far field expansion of the triangles in a BVH node
+        struct Expansion
+        {
+            vec3d  center; // area weighted centroid
+            double radius; // radius of the ball centered at center that contains all the triangles
+            vec3d  dipole; // sum of area weighted normals
+            mat3d  moment; // sum of (area weighted normal) x (centroid - center), for order 2
+        };
+
+        BVH                    bvh;
+        std::vector<Expansion> expansions; // one per BVH node
+
+        void   build_expansions();
+        double eval(const uint nid, const vec3d & p) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "fast_winding_number.cpp"
+#endif
+
+#endif // CINO_FAST_WINDING_NUMBER_H
@@ -36,7 +36,6 @@
 #include <cinolib/find_intersections.h>
 #include <cinolib/parallel_for.h>
 #include <cinolib/octree.h>
-#include <mutex>
 
 namespace cinolib
 {
@@ -46,7 +45,8 @@ CINO_INLINE
 void find_intersections(const Trimesh<M,V,E,P> & m,
                               std::set<ipair>  & intersections)
 {
-    auto tris = serialized_vids_from_polys(m.vector_polys());
+    std::vector<std::vector<uint>> buf;
+    auto tris = serialized_vids_from_polys(m.vector_polys(buf));
     find_intersections(m.vector_verts(), tris, intersections);
 }
 
@@ -60,30 +60,32 @@ void find_intersections(const std::vector<vec3d> & verts,
     Octree o(8,1000); // max 1000 elements per leaf, depth permitting
     o.build_from_vectors(verts, tris);
 
-    std::mutex mutex;
-    PARALLEL_FOR(0, uint(o.leaves.size()), 1, [&](uint i)
-    {        
-        auto & leaf = o.leaves.at(i);
-        if(leaf->item_indices.empty()) return;
-        for(uint j=0;   j<leaf->item_indices.size()-1; ++j)
-        for(uint k=j+1; k<leaf->item_indices.size();   ++k)
+    // pairs are collected per thread, and inserted in the output set at the end
+    typedef std::vector<ipair> list;
+    list res = PARALLEL_REDUCE(0, uint(o.leaves.size()), 1, list(), [&](uint i, list & acc)
+    {
+        const OctreeNode & leaf = o.nodes.at(o.leaves.at(i));
+        const uint *leaf_items  = &o.leaf_items[leaf.offset];
+        for(uint j=0;   j<leaf.count; ++j)
+        for(uint k=j+1; k<leaf.count; ++k)
         {
-            uint tid0 = leaf->item_indices.at(j);
-            uint tid1 = leaf->item_indices.at(k);
-            auto T0 = o.items.at(tid0);
-            auto T1 = o.items.at(tid1);
-            if(T0->aabb.intersects_box(T1->aabb)) // early reject based on AABB intersection
+            uint tid0 = leaf_items[j];
+            uint tid1 = leaf_items[k];
+            if(o.items.aabb(tid0).intersects_box(o.items.aabb(tid1))) // early reject based on AABB intersection
             {
-                const Triangle *t0 = dynamic_cast<Triangle*>(T0);
-                const Triangle *t1 = dynamic_cast<Triangle*>(T1);
-                if(t0->intersects_triangle(t1->v,true)) // precise check (exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined)
+                if(Triangle::intersects_triangle(o.items.verts(tid0), o.items.verts(tid1), true)) // precise check (exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined)
                 {
-                    std::lock_guard<std::mutex> guard(mutex);
-                    intersections.insert(unique_pair(tid0,tid1));
+                    acc.push_back(unique_pair(tid0,tid1));
                 }
             }
         }
+    },
+    [](list l0, const list & l1)
+    {
+        l0.insert(l0.end(), l1.begin(), l1.end());
+        return l0;
     });
+    intersections.insert(res.begin(), res.end());
 }
 
 }
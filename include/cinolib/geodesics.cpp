@@ -39,6 +39,8 @@
 #include <cinolib/laplacian.h>
 #include <cinolib/vertex_mass.h>
 #include <cinolib/linear_solvers.h>
+#include <iostream>
+#include <cassert>
 
 namespace cinolib
 {
@@ -49,7 +51,8 @@ ScalarField compute_geodesics(      Mesh              & m,
                               const std::vector<uint> & heat_charges,
                               const int                 laplacian_mode,
                               const float               time_scalar,
-                              const bool                hard_constrain_charges)
+                              const bool                hard_constrain_charges,
+                              const int                 solver)
 {
     // optimize position and scale to get better numerical precision
     double d = m.bbox().diag();
@@ -69,13 +72,23 @@ ScalarField compute_geodesics(      Mesh              & m,
 
     for(uint vid : heat_charges) rhs[vid] = 1.0;
 
-    ScalarField heat(m.num_verts());
-    solve_square_system(MM - time * L, rhs, heat);
+    // heat decays exponentially away from the sources, but the direction of its
+    // gradient must be accurate also where it is tiny: iterative solvers need a
+    // much tighter tolerance than usual (it is ignored by direct solvers). Also,
+    // with a diagonal preconditioner each CG iteration spreads heat by just one
+    // ring of vertices, and it converges long before reaching the whole mesh
+    ScalarField  heat(m.num_verts());
+    LinearSolver heat_solver(solver==CG_JACOBI ? CG_ICHOL : solver);
+    heat_solver.tolerance = 1e-12;
+    bool ok = heat_solver.compute(MM - time * L) && heat_solver.solve(rhs, heat);
+    if(!ok) std::cerr << "WARNING: heat flow solve failed (" << txt[heat_solver.type()] << ", relative residual " << heat_solver.convergence.residual << ")" << std::endl;
+    assert(ok);
 
     VectorField grad = G * heat;
     grad.normalize();
 
     ScalarField geodesics(m.num_verts());
+    int integration_solver = (solver==CG_JACOBI || solver==CG_ICHOL) ? solver : SIMPLICIAL_LDLT;
 
     // this is of course not supported in the amortized version,
     // as the matrix changes every time
@@ -83,11 +96,11 @@ ScalarField compute_geodesics(      Mesh              & m,
     {
         std::map<uint,double> bcs;
         for(uint vid : heat_charges) bcs[vid] = 1.0;
-        solve_square_system_with_bc(-L, G.transpose() * grad, geodesics, bcs, SIMPLICIAL_LDLT);
+        solve_square_system_with_bc(-L, G.transpose() * grad, geodesics, bcs, integration_solver);
     }
     else
     {
-        solve_square_system(-L, G.transpose() * grad, geodesics, SIMPLICIAL_LDLT);
+        solve_square_system(-L, G.transpose() * grad, geodesics, integration_solver);
     }
 
     // restore original scale and position
@@ -41,6 +41,7 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/scalar_field.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -67,6 +68,21 @@ namespace cinolib
  *              L phy = grad^T * ( grad(u)/|grad(u)| )
  *
  * phy is the scalar field encoding the geodesic distances.
+ *
+ * For meshes too big to be factorized, use one of the conjugate gradient
+ * solvers (CG_JACOBI, CG_ICHOL). The first step always uses CG_ICHOL in this
+ * case, as a diagonal preconditioner does not propagate heat far enough from
+ * the sources. With direct solvers the second step is always solved with
+ * SIMPLICIAL_LDLT, as the Laplacian is only semi definite.
+ *
+ * NOTE: iterative solvers are less accurate. Heat decays exponentially away
+ * from the sources, and far from them it is way below what a relative residual
+ * can resolve, hence there the direction of its gradient is mostly noise. On
+ * the bunny (default time_scalar) the distances, normalized in [0,1], differ
+ * from the ones obtained with a direct solver by up to 0.08, and a tighter
+ * tolerance does not help. A larger time_scalar shrinks the gap (below 0.005
+ * with time_scalar=16) at the price of smoother distances. A failed solve of
+ * the heat flow (e.g. no convergence) is reported on std::cerr and asserted.
 */
 
 template<class Mesh>
@@ -75,7 +91,8 @@ ScalarField compute_geodesics(      Mesh              & m,
                               const std::vector<uint> & heat_charges,
                               const int                 laplacian_mode = COTANGENT,
                               const float               time_scalar = 1.0,
-                              const bool                hard_constrain_charges = false);
+                              const bool                hard_constrain_charges = false,
+                              const int                 solver = SIMPLICIAL_LLT);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
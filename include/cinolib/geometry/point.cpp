@@ -50,15 +50,31 @@ std::ostream & operator<<(std::ostream & in, const Point & p)
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-vec3d Point::point_closest_to(const vec3d & /*p*/) const
+vec3d Point::point_closest_to(const vec3d & p) const
 {
-    return v;
+    return point_closest_to(&v, p);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Point::intersects_ray(const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/) const
+vec3d Point::point_closest_to(const vec3d v[], const vec3d & /*p*/)
+{
+    return v[0];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Point::intersects_ray(const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    return intersects_ray(&v, p, dir, t, pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Point::intersects_ray(const vec3d /*v*/[], const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/)
 {
     assert(false && "TODO");
     return true;
@@ -75,9 +91,17 @@ void Point::barycentric_coordinates(const vec3d & /*p*/, double /*bc*/[]) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Point::contains(const vec3d & p, const bool /*strict*/) const
+bool Point::contains(const vec3d & p, const bool strict) const
+{
+    return contains(&v, p, strict);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Point::contains(const vec3d v[], const vec3d & p, const bool /*strict*/)
 {
-    return p.dist_sqrd(v)==0;
+    return p.dist_sqrd(v[0])==0;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -85,7 +109,15 @@ bool Point::contains(const vec3d & p, const bool /*strict*/) const
 CINO_INLINE
 bool Point::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex) const
 {
-    auto res = point_in_segment_3d(v, s[0], s[1]);
+    return intersects_segment(&v, s, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Point::intersects_segment(const vec3d v[], const vec3d s[], const bool ignore_if_valid_complex)
+{
+    auto res = point_in_segment_3d(v[0], s[0], s[1]);
     if(ignore_if_valid_complex) return (res==STRICTLY_INSIDE);
     return (res!=STRICTLY_OUTSIDE);
 }
@@ -95,7 +127,15 @@ bool Point::intersects_segment(const vec3d s[], const bool ignore_if_valid_compl
 CINO_INLINE
 bool Point::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex) const
 {
-    auto res = point_in_triangle_3d(v, t[0], t[1], t[2]);
+    return intersects_triangle(&v, t, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Point::intersects_triangle(const vec3d v[], const vec3d t[], const bool ignore_if_valid_complex)
+{
+    auto res = point_in_triangle_3d(v[0], t[0], t[1], t[2]);
     if(ignore_if_valid_complex) return (res==STRICTLY_INSIDE || res>=ON_EDGE0);
     return (res!=STRICTLY_OUTSIDE);
 }
@@ -34,8 +34,45 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/geometry/point_utils.h>
+#include <cinolib/geometry/aabb.h>
+#include <algorithm>
 
 namespace cinolib
 {
 
+// interleaves the lowest 10 bits of x with zeros (i.e. bit i goes to bit 3i)
+CINO_INLINE
+static uint spread_bits(uint x)
+{
+    x &= 0x3ff;
+    x = (x | (x << 16)) & 0x030000ff;
+    x = (x | (x <<  8)) & 0x0300f00f;
+    x = (x | (x <<  4)) & 0x030c30c3;
+    x = (x | (x <<  2)) & 0x09249249;
+    return x;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Z_order(const std::vector<vec3d> & points, std::vector<uint> & order)
+{
+    order.resize(points.size());
+    if(points.empty()) return;
+
+    // quantize coordinates on a 1024^3 grid
+    AABB   box(points);
+    double scale = 1023.0 / std::max(box.delta().max_entry(), 1e-15);
+
+    std::vector<std::pair<uint,uint>> codes(points.size());
+    for(uint i=0; i<points.size(); ++i)
+    {
+        vec3d q = (points[i] - box.min) * scale;
+        codes[i].first  = spread_bits(uint(q.x())) | (spread_bits(uint(q.y())) << 1) | (spread_bits(uint(q.z())) << 2);
+        codes[i].second = i;
+    }
+    std::sort(codes.begin(), codes.end());
+    for(uint i=0; i<points.size(); ++i) order[i] = codes[i].second;
+}
+
 }
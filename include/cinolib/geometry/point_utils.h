@@ -36,9 +36,18 @@
 #ifndef CINO_POINT_UTILS_H
 #define CINO_POINT_UTILS_H
 
+#include <cinolib/geometry/vec_mat.h>
+#include <vector>
+
 namespace cinolib
 {
 
+// permutation that sorts a set of points along a Z-order (Morton) curve, so that points
+// that are close in space also tend to be close in the list. Useful to group queries
+// that can share work, such as coherent rays (see Octree::intersects_rays)
+CINO_INLINE
+void Z_order(const std::vector<vec3d> & points, std::vector<uint> & order);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -0,0 +1,189 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/geometry/ray_packet.h>
+#include <algorithm>
+#include <cmath>
+#ifdef CINOLIB_VEC_MAT_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+void RayPacket::set(const vec3d * p, const vec3d * dir, const uint * skip_ids, const uint size, const bool all_hits)
+{
+    assert(size>0 && size<=RAY_PACKET_SIZE);
+    this->size     = size;
+    this->all_hits = all_hits;
+    this->clips    = 0;
+
+    for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        // unused slots replicate the first ray, so that SIMD lanes never operate on garbage
+        uint src   = (i<size) ? i : 0;
+        this->p[i]   = p[src];
+        this->dir[i] = dir[src];
+        skip_id[i] = (skip_ids!=nullptr) ? skip_ids[src] : max_uint;
+        min_t[i]   = inf_double;
+        id[i]      = max_uint;
+        n_hits[i]  = 0;
+        hits[i].clear();
+
+        for(uint j=0; j<3; ++j)
+        {
+            orig[j][i] = this->p[i][j];
+            // rays parallel to an axis (see AABB::intersects_ray) get an infinite reciprocal, which
+            // leaves the slab unbounded if the origin is inside it, and empty otherwise
+            inv_dir[j][i] = (std::fabs(this->dir[i][j]) < 1e-15) ? inf_double : 1.0/this->dir[i][j];
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void RayPacket::finalize()
+{
+    if(!all_hits)
+    {
+        for(uint i=0; i<size; ++i) n_hits[i] = (min_t[i]<inf_double) ? 1 : 0;
+        return;
+    }
+
+    for(uint i=0; i<size; ++i)
+    {
+        std::vector<std::pair<double,uint>> & h = hits[i];
+        std::sort(h.begin(), h.end());
+        h.erase(std::unique(h.begin(), h.end()), h.end());
+
+        uint first = 0;
+        while(first<h.size() && h[first].second==skip_id[i]) ++first;
+
+        n_hits[i] = h.size() - first;
+        if(first<h.size())
+        {
+            min_t[i] = h[first].first;
+            id[i]    = h[first].second;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as AABB::intersects_ray, for all rays at once. Rays are clipped at min_t,
+// which in all hits mode stays at infinity throughout the traversal. If the origin
+// of a ray parallel to an axis lies exactly on the boundary of the slab, 0 * inf
+// gives NaN. Operands of min/max are ordered so that a NaN is always discarded (as
+// in SSE2, where min(a,b) and max(a,b) return b if any of the two is NaN), making
+// the slab unbounded along that axis
+template<typename T>
+CINO_INLINE
+uint RayPacket::intersects_box(const T bmin[], const T bmax[], const uint mask, double t_near[]) const
+{
+    uint hit = 0;
+#ifdef CINOLIB_VEC_MAT_SSE2
+    for(uint i=0; i<RAY_PACKET_SIZE; i+=2)
+    {
+        __m128d t0 = _mm_setzero_pd();
+        __m128d t1 = _mm_loadu_pd(min_t+i);
+        for(uint j=0; j<3; ++j)
+        {
+            __m128d o  = _mm_loadu_pd(orig[j]+i);
+            __m128d id = _mm_loadu_pd(inv_dir[j]+i);
+            __m128d n  = _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(static_cast<double>(bmin[j])), o), id);
+            __m128d f  = _mm_mul_pd(_mm_sub_pd(_mm_set1_pd(static_cast<double>(bmax[j])), o), id);
+            t0 = _mm_max_pd(_mm_min_pd(f,n), t0);
+            t1 = _mm_min_pd(_mm_max_pd(n,f), t1);
+        }
+        _mm_storeu_pd(t_near+i, t0);
+        hit |= static_cast<uint>(_mm_movemask_pd(_mm_cmple_pd(t0,t1))) << i;
+    }
+#else
+    for(uint i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        double t0 = 0.0;
+        double t1 = min_t[i];
+        for(uint j=0; j<3; ++j)
+        {
+            double n = (static_cast<double>(bmin[j]) - orig[j][i]) * inv_dir[j][i];
+            double f = (static_cast<double>(bmax[j]) - orig[j][i]) * inv_dir[j][i];
+            double lo = (f<n) ? f : n;
+            double hi = (n>f) ? n : f;
+            t0 = (lo>t0) ? lo : t0;
+            t1 = (hi<t1) ? hi : t1;
+        }
+        t_near[i] = t0;
+        if(t0<=t1) hit |= 1u << i;
+    }
+#endif
+    return hit & mask;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void RayPacket::intersects_items(const SpatialItemPool & items, const uint * list, const uint n, const uint mask)
+{
+    // item major, so that each item is fetched once for all the rays in the packet
+    for(uint k=0; k<n; ++k)
+    {
+        uint it = list[k];
+        for(uint i=0; i<size; ++i)
+        {
+            if(!(mask & (1u << i))) continue;
+
+            double t;
+            vec3d  pos;
+            if(items.intersects_ray(it, p[i], dir[i], t, pos))
+            {
+                uint hit_id = items.id(it);
+                if(all_hits)
+                {
+                    hits[i].push_back(std::make_pair(t,hit_id));
+                }
+                else if(hit_id!=skip_id[i] && (t<min_t[i] || (t==min_t[i] && hit_id<id[i])))
+                {
+                    min_t[i] = t;
+                    id[i]    = hit_id;
+                    ++clips;
+                }
+            }
+        }
+    }
+}
+
+}
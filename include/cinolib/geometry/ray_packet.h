@@ -0,0 +1,124 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RAY_PACKET_H
+#define CINO_RAY_PACKET_H
+
+#include <cinolib/geometry/spatial_item_pool.h>
+#include <cinolib/min_max_inf.h>
+
+namespace cinolib
+{
+
+const uint RAY_PACKET_SIZE = 4;
+
+/* A bundle of up to RAY_PACKET_SIZE rays R_i(t) := p_i + t * dir_i, traced
+ * together through a spatial data structure (see Octree::intersects_rays and
+ * BVH::intersects_rays). Each node is tested against all the rays in the
+ * packet at once: origins and reciprocal directions are stored by coordinate,
+ * so that the slab test runs on two rays per instruction when SSE2 is
+ * available. Packets pay off when rays are coherent, that is, when they
+ * traverse the same nodes (e.g. parallel rays shot from nearby points).
+ *
+ * Two modes are supported:
+ *  - first hit: each ray is clipped at the closest hit found so far, and
+ *    nodes beyond it are not visited
+ *  - all hits : rays are not clipped, and all hits are collected. Besides
+ *    the first hit, this gives the number of intersections along the ray
+ *
+ * In both modes, hits with item skip_id that precede any other hit are
+ * discarded (e.g. when a ray is shot from a point on the item itself).
+ * Hits are counted as in Octree::intersects_ray, that is, pairs (t,id)
+ * that appear multiple times are counted only once.
+*/
+
+struct RayPacket
+{
+    uint   size = 0;
+    bool   all_hits = false;
+    vec3d  p      [RAY_PACKET_SIZE];
+    vec3d  dir    [RAY_PACKET_SIZE];
+    uint   skip_id[RAY_PACKET_SIZE];
+
+    // number of times a ray was clipped by a closer hit (first hit mode only)
+    uint   clips = 0;
+
+    // results (filled by finalize)
+    double min_t  [RAY_PACKET_SIZE];
+    uint   id     [RAY_PACKET_SIZE];
+    uint   n_hits [RAY_PACKET_SIZE];
+
+    // entry of a traversal stack: a node, the rays that hit it, and the number of clips at the time
+    // it was pushed. If rays were clipped in the meantime, the node must be tested again when popped
+    template<typename Node>
+    struct StackEntry
+    {
+        Node node;
+        uint mask;
+        uint clips;
+    };
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    void set(const vec3d * p, const vec3d * dir, const uint * skip_ids, const uint size, const bool all_hits);
+    void finalize();
+
+    // bitmask of all the rays in the packet
+    uint rays() const { return (1u << size) - 1; }
+
+    // returns the bitmask of the rays in mask that hit box [bmin,bmax] before their current
+    // clipping distance. For each ray hitting the box, t_near receives the entry parameter
+    template<typename T>
+    uint intersects_box(const T bmin[], const T bmax[], const uint mask, double t_near[]) const;
+
+    // intersects the rays in mask with the items of a leaf (list has n entries, indexing the pool)
+    void intersects_items(const SpatialItemPool & items, const uint * list, const uint n, const uint mask);
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+    double orig   [3][RAY_PACKET_SIZE]; // orig[j][i] is the j-th coordinate of the i-th origin
+    double inv_dir[3][RAY_PACKET_SIZE];
+    std::vector<std::pair<double,uint>> hits[RAY_PACKET_SIZE]; // all hits mode only
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "ray_packet.cpp"
+#endif
+
+#endif // CINO_RAY_PACKET_H
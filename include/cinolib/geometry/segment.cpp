@@ -52,6 +52,14 @@ std::ostream & operator<<(std::ostream & in, const Segment & s)
 // Real Time Collision Detection", Section 5.1.2
 CINO_INLINE
 vec3d Segment::point_closest_to(const vec3d & p) const
+{
+    return point_closest_to(v, p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Segment::point_closest_to(const vec3d v[], const vec3d & p)
 {
     vec3d u = v[1] - v[0];
 
@@ -69,7 +77,15 @@ vec3d Segment::point_closest_to(const vec3d & p) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Segment::intersects_ray(const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/) const
+bool Segment::intersects_ray(const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    return intersects_ray(v, p, dir, t, pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Segment::intersects_ray(const vec3d /*v*/[], const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/)
 {
     assert(false && "TODO");
     return true;
@@ -92,6 +108,14 @@ void Segment::barycentric_coordinates(const vec3d & p, double bc[]) const
 
 CINO_INLINE
 bool Segment::contains(const vec3d & p, const bool strict) const
+{
+    return contains(v, p, strict);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Segment::contains(const vec3d v[], const vec3d & p, const bool strict)
 {
     int where = point_in_segment_3d(p, v[0], v[1]);
     if(strict) return (where==STRICTLY_INSIDE);
@@ -102,6 +126,14 @@ bool Segment::contains(const vec3d & p, const bool strict) const
 
 CINO_INLINE
 bool Segment::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    return intersects_segment(v, s, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Segment::intersects_segment(const vec3d v[], const vec3d s[], const bool ignore_if_valid_complex)
 {
     auto res = segment_segment_intersect_3d(v[0], v[1], s[0], s[1]);
     if(ignore_if_valid_complex) return (res > SIMPLICIAL_COMPLEX);
@@ -112,6 +144,14 @@ bool Segment::intersects_segment(const vec3d s[], const bool ignore_if_valid_com
 
 CINO_INLINE
 bool Segment::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    return intersects_triangle(v, t, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Segment::intersects_triangle(const vec3d v[], const vec3d t[], const bool ignore_if_valid_complex)
 {
     auto res = segment_triangle_intersect_3d(v[0], v[1], t[0], t[1], t[2]);
     if(ignore_if_valid_complex) return (res > SIMPLICIAL_COMPLEX);
@@ -0,0 +1,247 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/geometry/spatial_item_pool.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void SpatialItemPool::push_ref(const ItemType type, const uint index, const uint id, const AABB & bbox)
+{
+    refs.push_back({type, index});
+    ids.push_back(id);
+    bboxes.push_back(bbox);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::push_point(const uint id, const vec3d & v)
+{
+    push_ref(POINT, points.size(), id, AABB(v,v));
+    points.push_back(v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::push_sphere(const uint id, const vec3d & c, const double r)
+{
+    // same box as class Sphere
+    double hr = r*0.5;
+    push_ref(SPHERE, sphere_centers.size(), id, AABB(c - vec3d(hr,hr,hr), c + vec3d(hr,hr,hr)));
+    sphere_centers.push_back(c);
+    sphere_radii.push_back(r);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::push_segment(const uint id, const vec3d & v0, const vec3d & v1)
+{
+    push_ref(SEGMENT, segments.size()/2, id, AABB(v0,v1));
+    segments.push_back(v0);
+    segments.push_back(v1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::push_triangle(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2)
+{
+    push_ref(TRIANGLE, triangles.size()/3, id, AABB(v0.min(v1).min(v2), v0.max(v1).max(v2)));
+    triangles.push_back(v0);
+    triangles.push_back(v1);
+    triangles.push_back(v2);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::push_tetrahedron(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & v3)
+{
+    push_ref(TETRAHEDRON, tetrahedra.size()/4, id, AABB(v0.min(v1).min(v2).min(v3), v0.max(v1).max(v2).max(v3)));
+    tetrahedra.push_back(v0);
+    tetrahedra.push_back(v1);
+    tetrahedra.push_back(v2);
+    tetrahedra.push_back(v3);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// reserves space for n items of the given type
+CINO_INLINE
+void SpatialItemPool::reserve(const uint n, const ItemType type)
+{
+    refs.reserve(n);
+    ids.reserve(n);
+    bboxes.reserve(n);
+    switch(type)
+    {
+        case POINT       : points.reserve(n);                                 break;
+        case SPHERE      : sphere_centers.reserve(n); sphere_radii.reserve(n); break;
+        case SEGMENT     : segments.reserve(2*n);                             break;
+        case TRIANGLE    : triangles.reserve(3*n);                            break;
+        case TETRAHEDRON : tetrahedra.reserve(4*n);                           break;
+        default: break;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SpatialItemPool::clear()
+{
+    refs.clear();
+    ids.clear();
+    bboxes.clear();
+    points.clear();
+    segments.clear();
+    triangles.clear();
+    tetrahedra.clear();
+    sphere_centers.clear();
+    sphere_radii.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const vec3d * SpatialItemPool::verts(const uint i) const
+{
+    const Ref & r = refs.at(i);
+    switch(r.type)
+    {
+        case POINT       : return &points        [  r.index];
+        case SPHERE      : return &sphere_centers[  r.index];
+        case SEGMENT     : return &segments      [2*r.index];
+        case TRIANGLE    : return &triangles     [3*r.index];
+        case TETRAHEDRON : return &tetrahedra    [4*r.index];
+        default: assert(false && "Unknown item type");
+    }
+    return nullptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d SpatialItemPool::point_closest_to(const uint i, const vec3d & p) const
+{
+    const Ref & r = refs[i];
+    switch(r.type)
+    {
+        case POINT       : return Point      ::point_closest_to(&points    [  r.index], p);
+        case SEGMENT     : return Segment    ::point_closest_to(&segments  [2*r.index], p);
+        case TRIANGLE    : return Triangle   ::point_closest_to(&triangles [3*r.index], p);
+        case TETRAHEDRON : return Tetrahedron::point_closest_to(&tetrahedra[4*r.index], p);
+        case SPHERE      : return Sphere     ::point_closest_to(sphere_centers[r.index], sphere_radii[r.index], p);
+        default: assert(false && "Unknown item type");
+    }
+    return p;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool SpatialItemPool::contains(const uint i, const vec3d & p, const bool strict) const
+{
+    const Ref & r = refs[i];
+    switch(r.type)
+    {
+        case POINT       : return Point      ::contains(&points    [  r.index], p, strict);
+        case SEGMENT     : return Segment    ::contains(&segments  [2*r.index], p, strict);
+        case TRIANGLE    : return Triangle   ::contains(&triangles [3*r.index], p, strict);
+        case TETRAHEDRON : return Tetrahedron::contains(&tetrahedra[4*r.index], p, strict);
+        case SPHERE      : return Sphere     ::contains(sphere_centers[r.index], sphere_radii[r.index], p, strict);
+        default: assert(false && "Unknown item type");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool SpatialItemPool::intersects_segment(const uint i, const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    const Ref & r = refs[i];
+    switch(r.type)
+    {
+        case POINT       : return Point      ::intersects_segment(&points    [  r.index], s, ignore_if_valid_complex);
+        case SEGMENT     : return Segment    ::intersects_segment(&segments  [2*r.index], s, ignore_if_valid_complex);
+        case TRIANGLE    : return Triangle   ::intersects_segment(&triangles [3*r.index], s, ignore_if_valid_complex);
+        case TETRAHEDRON : return Tetrahedron::intersects_segment(&tetrahedra[4*r.index], s, ignore_if_valid_complex);
+        case SPHERE      : return Sphere     ::intersects_segment(sphere_centers[r.index], sphere_radii[r.index], s, ignore_if_valid_complex);
+        default: assert(false && "Unknown item type");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool SpatialItemPool::intersects_triangle(const uint i, const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    const Ref & r = refs[i];
+    switch(r.type)
+    {
+        case POINT       : return Point      ::intersects_triangle(&points    [  r.index], t, ignore_if_valid_complex);
+        case SEGMENT     : return Segment    ::intersects_triangle(&segments  [2*r.index], t, ignore_if_valid_complex);
+        case TRIANGLE    : return Triangle   ::intersects_triangle(&triangles [3*r.index], t, ignore_if_valid_complex);
+        case TETRAHEDRON : return Tetrahedron::intersects_triangle(&tetrahedra[4*r.index], t, ignore_if_valid_complex);
+        case SPHERE      : return Sphere     ::intersects_triangle(sphere_centers[r.index], sphere_radii[r.index], t, ignore_if_valid_complex);
+        default: assert(false && "Unknown item type");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool SpatialItemPool::intersects_ray(const uint i, const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    const Ref & r = refs[i];
+    switch(r.type)
+    {
+        case POINT       : return Point      ::intersects_ray(&points    [  r.index], p, dir, t, pos);
+        case SEGMENT     : return Segment    ::intersects_ray(&segments  [2*r.index], p, dir, t, pos);
+        case TRIANGLE    : return Triangle   ::intersects_ray(&triangles [3*r.index], p, dir, t, pos);
+        case TETRAHEDRON : return Tetrahedron::intersects_ray(&tetrahedra[4*r.index], p, dir, t, pos);
+        case SPHERE      : return Sphere     ::intersects_ray(sphere_centers[r.index], sphere_radii[r.index], p, dir, t, pos);
+        default: assert(false && "Unknown item type");
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,129 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SPATIAL_ITEM_POOL_H
+#define CINO_SPATIAL_ITEM_POOL_H
+
+#include <cinolib/geometry/point.h>
+#include <cinolib/geometry/sphere.h>
+#include <cinolib/geometry/segment.h>
+#include <cinolib/geometry/triangle.h>
+#include <cinolib/geometry/tetrahedron.h>
+
+namespace cinolib
+{
+
+/* Container for the items of a spatial data structure (e.g. Octree, BVH).
+ * Rather than allocating each item as a SpatialDataStructureItem on the heap,
+ * items are stored by value in flat arrays: vertices are packed in one array
+ * per type (e.g. triangle k spans triangles[3k,3k+3)), whereas ids and
+ * bounding boxes are kept in separate arrays, indexed by the global item index,
+ * which follows the order of insertion. Queries switch on the item type and
+ * call the static kernels of the item classes (Triangle, Segment, ...)
+ * directly, without going through the virtual table.
+*/
+
+class SpatialItemPool
+{
+    public:
+
+        explicit SpatialItemPool() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push_point      (const uint id, const vec3d &  v);
+        void push_sphere     (const uint id, const vec3d &  c, const double   r);
+        void push_segment    (const uint id, const vec3d & v0, const vec3d & v1);
+        void push_triangle   (const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2);
+        void push_tetrahedron(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & v3);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void reserve(const uint n, const ItemType type = TRIANGLE);
+        void clear();
+        uint size()  const { return refs.size();  }
+        bool empty() const { return refs.empty(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        ItemType      type (const uint i) const { return refs[i].type; }
+        uint          id   (const uint i) const { return ids[i];       }
+        const AABB  & aabb (const uint i) const { return bboxes[i];    }
+        const vec3d * verts(const uint i) const; // vertices of the i-th item (the center, for spheres)
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // same as the SpatialDataStructureItem interface, but without virtual calls
+        vec3d point_closest_to   (const uint i, const vec3d & p) const;
+        bool  contains           (const uint i, const vec3d & p, const bool strict) const;
+        bool  intersects_segment (const uint i, const vec3d s[], const bool ignore_if_valid_complex) const;
+        bool  intersects_triangle(const uint i, const vec3d t[], const bool ignore_if_valid_complex) const;
+        bool  intersects_ray     (const uint i, const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // per item data (indexed by global item index)
+        std::vector<uint> ids;
+        std::vector<AABB> bboxes;
+
+        // per type data (indexed by type-specific index)
+        std::vector<vec3d>  points;     // 1 vertex per point
+        std::vector<vec3d>  segments;   // 2 vertices per segment
+        std::vector<vec3d>  triangles;  // 3 vertices per triangle
+        std::vector<vec3d>  tetrahedra; // 4 vertices per tetrahedron
+        std::vector<vec3d>  sphere_centers;
+        std::vector<double> sphere_radii;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        struct Ref
+        {
+            ItemType type;
+            uint     index; // type-specific index (e.g. triangle k)
+        };
+        std::vector<Ref> refs;
+
+        void push_ref(const ItemType type, const uint index, const uint id, const AABB & bbox);
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "spatial_item_pool.cpp"
+#endif
+
+#endif // CINO_SPATIAL_ITEM_POOL_H
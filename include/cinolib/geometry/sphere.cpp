@@ -50,7 +50,15 @@ std::ostream & operator<<(std::ostream & in, const Sphere & s)
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-vec3d Sphere::point_closest_to(const vec3d & /*p*/) const
+vec3d Sphere::point_closest_to(const vec3d & p) const
+{
+    return point_closest_to(c, r, p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Sphere::point_closest_to(const vec3d & c, const double /*r*/, const vec3d & /*p*/)
 {
     assert(false && "TODO");
     return c;
@@ -59,7 +67,15 @@ vec3d Sphere::point_closest_to(const vec3d & /*p*/) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Sphere::intersects_ray(const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/) const
+bool Sphere::intersects_ray(const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    return intersects_ray(c, r, p, dir, t, pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Sphere::intersects_ray(const vec3d & /*c*/, const double /*r*/, const vec3d & /*p*/, const vec3d & /*dir*/, double & /*t*/, vec3d & /*pos*/)
 {
     assert(false && "TODO");
     return true;
@@ -77,6 +93,14 @@ void Sphere::barycentric_coordinates(const vec3d & /*p*/, double /*bc*/[]) const
 
 CINO_INLINE
 bool Sphere::contains(const vec3d & p, const bool strict) const
+{
+    return contains(c, r, p, strict);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Sphere::contains(const vec3d & c, const double r, const vec3d & p, const bool strict)
 {
     if(strict) return p.dist(c) <  r;
     else       return p.dist(c) <= r;
@@ -85,7 +109,15 @@ bool Sphere::contains(const vec3d & p, const bool strict) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Sphere::intersects_segment(const vec3d /*s*/[], const bool /*ignore_if_valid_complex*/) const
+bool Sphere::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    return intersects_segment(c, r, s, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Sphere::intersects_segment(const vec3d & /*c*/, const double /*r*/, const vec3d /*s*/[], const bool /*ignore_if_valid_complex*/)
 {
     assert(false && "TODO");
     return false;
@@ -94,7 +126,15 @@ bool Sphere::intersects_segment(const vec3d /*s*/[], const bool /*ignore_if_vali
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Sphere::intersects_triangle(const vec3d /*t*/[], const bool /*ignore_if_valid_complex*/) const
+bool Sphere::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    return intersects_triangle(c, r, t, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Sphere::intersects_triangle(const vec3d & /*c*/, const double /*r*/, const vec3d /*t*/[], const bool /*ignore_if_valid_complex*/)
 {
     assert(false && "TODO");
     return false;
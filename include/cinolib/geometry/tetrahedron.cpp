@@ -44,6 +44,14 @@ namespace cinolib
 
 CINO_INLINE
 vec3d Tetrahedron::point_closest_to(const vec3d & p) const
+{
+    return point_closest_to(v, p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Tetrahedron::point_closest_to(const vec3d v[], const vec3d & p)
 {
     return tetrahedron_closest_point(p,v[0],v[1],v[2],v[3]);
 }
@@ -52,6 +60,14 @@ vec3d Tetrahedron::point_closest_to(const vec3d & p) const
 
 CINO_INLINE
 bool Tetrahedron::intersects_ray(const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    return intersects_ray(v, p, dir, t, pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Tetrahedron::intersects_ray(const vec3d v[], const vec3d & p, const vec3d & dir, double & t, vec3d & pos)
 {
     bool   backside;
     bool   coplanar;
@@ -89,6 +105,14 @@ void Tetrahedron::barycentric_coordinates(const vec3d &p, double bc[]) const
 
 CINO_INLINE
 bool Tetrahedron::contains(const vec3d & p, const bool strict) const
+{
+    return contains(v, p, strict);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Tetrahedron::contains(const vec3d v[], const vec3d & p, const bool strict)
 {
     int where = point_in_tet(p, v[0], v[1], v[2], v[3]);
     if(strict) return (where==STRICTLY_INSIDE);
@@ -98,7 +122,15 @@ bool Tetrahedron::contains(const vec3d & p, const bool strict) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Tetrahedron::intersects_segment(const vec3d [], const bool) const
+bool Tetrahedron::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    return intersects_segment(v, s, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Tetrahedron::intersects_segment(const vec3d [], const vec3d [], const bool)
 {
     assert(false && "TODO!");
     return false;
@@ -107,7 +139,15 @@ bool Tetrahedron::intersects_segment(const vec3d [], const bool) const
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-bool Tetrahedron::intersects_triangle(const vec3d [], const bool) const
+bool Tetrahedron::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    return intersects_triangle(v, t, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Tetrahedron::intersects_triangle(const vec3d [], const vec3d [], const bool)
 {
     assert(false && "TODO!");
     return false;
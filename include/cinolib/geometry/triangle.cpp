@@ -45,6 +45,14 @@ namespace cinolib
 
 CINO_INLINE
 vec3d Triangle::point_closest_to(const vec3d & p) const
+{
+    return point_closest_to(v, p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Triangle::point_closest_to(const vec3d v[], const vec3d & p)
 {
     return triangle_closest_point(p,v[0],v[1],v[2]);
 }
@@ -53,6 +61,14 @@ vec3d Triangle::point_closest_to(const vec3d & p) const
 
 CINO_INLINE
 bool Triangle::intersects_ray(const vec3d & p, const vec3d & dir, double & t, vec3d & pos) const
+{
+    return intersects_ray(v, p, dir, t, pos);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Triangle::intersects_ray(const vec3d v[], const vec3d & p, const vec3d & dir, double & t, vec3d & pos)
 {
     bool  hits_backside;
     bool  coplanar;
@@ -77,6 +93,14 @@ void Triangle::barycentric_coordinates(const vec3d & p, double bc[]) const
 
 CINO_INLINE
 bool Triangle::contains(const vec3d & p, const bool strict) const
+{
+    return contains(v, p, strict);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Triangle::contains(const vec3d v[], const vec3d & p, const bool strict)
 {
     int where = point_in_triangle_3d(p,v[0], v[1], v[2]);
     if(strict) return (where==STRICTLY_INSIDE);
@@ -87,6 +111,14 @@ bool Triangle::contains(const vec3d & p, const bool strict) const
 
 CINO_INLINE
 bool Triangle::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    return intersects_segment(v, s, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Triangle::intersects_segment(const vec3d v[], const vec3d s[], const bool ignore_if_valid_complex)
 {
     auto res = segment_triangle_intersect_3d(s[0],s[1], v[0], v[1], v[2]);
     if(ignore_if_valid_complex) return (res > SIMPLICIAL_COMPLEX);
@@ -97,6 +129,14 @@ bool Triangle::intersects_segment(const vec3d s[], const bool ignore_if_valid_co
 
 CINO_INLINE
 bool Triangle::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    return intersects_triangle(v, t, ignore_if_valid_complex);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Triangle::intersects_triangle(const vec3d v[], const vec3d t[], const bool ignore_if_valid_complex)
 {
     auto res = triangle_triangle_intersect_3d(v[0], v[1], v[2], t[0], t[1], t[2]);
     if(ignore_if_valid_complex) return (res > SIMPLICIAL_COMPLEX);
@@ -80,6 +80,13 @@ class Triangle : public SpatialDataStructureItem
         bool     intersects_segment     (const vec3d   s[], const bool ignore_if_valid_complex) const override;
         bool     intersects_triangle    (const vec3d   t[], const bool ignore_if_valid_complex) const override;
 
+        // the same queries on raw data (used by SpatialItemPool, which stores items by value)
+        static vec3d point_closest_to   (const vec3d v[], const vec3d & p);
+        static bool  intersects_ray     (const vec3d v[], const vec3d & p, const vec3d & dir, double & t, vec3d & pos);
+        static bool  contains           (const vec3d v[], const vec3d & p, const bool strict);
+        static bool  intersects_segment (const vec3d v[], const vec3d s[], const bool ignore_if_valid_complex);
+        static bool  intersects_triangle(const vec3d v[], const vec3d t[], const bool ignore_if_valid_complex);
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         vec3d v[3];
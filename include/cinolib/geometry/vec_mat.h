@@ -37,12 +37,16 @@
 #define CINO_VEC_MAT_H
 
 #include <ostream>
+#include <type_traits>
 #include <cinolib/geometry/vec_mat_utils.h>
 #include <cinolib/symbols.h>
 
 namespace cinolib
 {
 
+// NOTE: mat is meant to be a plain aggregate of r*c scalars (no vtable, no padding), so
+// that arrays of vectors/matrices can be memcpy-ed, mapped from files or handed to GPU
+// buffers as they are. Do not add virtual members or extra data to this class
 template<uint r, uint c, class T>
 class mat
 {
@@ -62,8 +66,7 @@ class mat
         explicit mat(const T * values);
         explicit mat(const T v0, const T v1);
         explicit mat(const T v0, const T v1, const T v2);
-        explicit mat() {}
-        virtual ~mat() {}
+        explicit mat() = default;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -256,6 +259,12 @@ typedef mat<4,1,float>  vec4f;
 typedef mat<4,1,int>    vec4i;
 typedef mat<4,1,uint>   vec4u;
 
+static_assert(std::is_trivially_copyable<vec3d>::value, "vec3d must be trivially copyable");
+static_assert(std::is_trivially_copyable<mat3d>::value, "mat3d must be trivially copyable");
+static_assert(sizeof(vec3d)==3*sizeof(double),          "vec3d must be tightly packed");
+static_assert(sizeof(vec3f)==3*sizeof(float),           "vec3f must be tightly packed");
+static_assert(sizeof(mat3d)==9*sizeof(double),          "mat3d must be tightly packed");
+
 }
 
 #ifndef  CINO_STATIC_LIB
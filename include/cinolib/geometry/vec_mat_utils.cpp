@@ -40,6 +40,9 @@
 #include <cmath>
 #include <assert.h>
 #include <Eigen/Dense>
+#ifdef CINOLIB_VEC_MAT_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace cinolib
 {
@@ -1029,4 +1032,81 @@ void mat_times(const T m0[][c0], const T m1[][c1], T m2[][c1])
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+#ifdef CINOLIB_VEC_MAT_SSE2
+
+// sum of the two lanes of an SSE register, plus a third scalar term: (a[0]+a[1])+b
+CINO_INLINE
+double sse2_hsum_plus(const __m128d a, const double b)
+{
+    __m128d s = _mm_add_sd(a, _mm_unpackhi_pd(a,a));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_set_sd(b)));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dot<3,double>(const double * v0, const double * v1)
+{
+    __m128d xy = _mm_mul_pd(_mm_loadu_pd(v0), _mm_loadu_pd(v1));
+    return sse2_hsum_plus(xy, v0[2]*v1[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void vec_cross<double>(const double * v0, const double * v1, double * v2)
+{
+    // first two components in one shot:
+    // [ y0*z1 - z0*y1 , z0*x1 - x0*z1 ]
+    __m128d a = _mm_loadu_pd(v0+1);           // [y0,z0]
+    __m128d b = _mm_set_pd(v1[0], v1[2]);     // [z1,x1]
+    __m128d c = _mm_set_pd(v0[0], v0[2]);     // [z0,x0]
+    __m128d d = _mm_loadu_pd(v1+1);           // [y1,z1]
+    __m128d r = _mm_sub_pd(_mm_mul_pd(a,b), _mm_mul_pd(c,d));
+    double  z = v0[0] * v1[1] - v0[1] * v1[0];
+    _mm_storeu_pd(v2, r);
+    v2[2] = z;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_dist_sqrd<3,double>(const double * v0, const double * v1)
+{
+    __m128d d  = _mm_sub_pd(_mm_loadu_pd(v0), _mm_loadu_pd(v1));
+    double  dz = v0[2] - v1[2];
+    return sse2_hsum_plus(_mm_mul_pd(d,d), dz*dz);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+double vec_norm_sqrd<3,double>(const double * v)
+{
+    __m128d xy = _mm_loadu_pd(v);
+    return sse2_hsum_plus(_mm_mul_pd(xy,xy), v[2]*v[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<>
+CINO_INLINE
+void mat_times<3,3,1,double>(const double m0[][3], const double m1[][1], double m2[][1])
+{
+    const double * v = m1[0];
+    double res[3];
+    for(uint i=0; i<3; ++i) res[i] = vec_dot<3,double>(m0[i], v);
+    m2[0][0] = res[0];
+    m2[1][0] = res[1];
+    m2[2][0] = res[2];
+}
+
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 }
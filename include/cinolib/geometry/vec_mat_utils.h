@@ -40,6 +40,12 @@
 #include <initializer_list>
 #include <sys/types.h>
 
+// 3D double precision kernels (dot, cross, norms, mat3 x vec3) have SSE2 specializations
+// on x86-64 targets. Define CINOLIB_NO_SIMD to fall back to the generic templates
+#if !defined(CINOLIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define CINOLIB_VEC_MAT_SSE2
+#endif
+
 namespace cinolib
 {
 
@@ -131,6 +137,18 @@ void mat_times(const T m0[][c0], const T m1[][c1], T m2[][c1]);
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+#ifdef CINOLIB_VEC_MAT_SSE2
+// SIMD specializations for the 3D double precision case, which dominates mesh processing.
+// They accumulate in the same order of the generic loops, hence results are bit-wise identical
+template<> CINO_INLINE double vec_dot      <3,double>(const double * v_0, const double * v_1);
+template<> CINO_INLINE void   vec_cross    <  double>(const double * v_0, const double * v_1, double * v_2);
+template<> CINO_INLINE double vec_dist_sqrd<3,double>(const double * v_0, const double * v_1);
+template<> CINO_INLINE double vec_norm_sqrd<3,double>(const double * vec);
+template<> CINO_INLINE void   mat_times<3,3,1,double>(const double m0[][3], const double m1[][1], double m2[][1]);
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 }
 
 #ifndef  CINO_STATIC_LIB
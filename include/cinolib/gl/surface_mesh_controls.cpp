@@ -96,6 +96,7 @@ void SurfaceMeshControls<Mesh>::header_IO(const bool open)
             if(!filename.empty())
             {
                 *m = Mesh(filename.c_str());
+                slicer.clear_cache();
                 gui->refit_scene();
             }
         }
@@ -405,8 +406,7 @@ void SurfaceMeshControls<Mesh>::header_slicing(const bool open)
         refresh |= ImGui::Checkbox   ("##l", &slicer.L_is);
         if(refresh)
         {
-            slicer.slice(*m);
-            m->updateGL();
+            if(!slicer.slice(*m).empty()) m->updateGL_visibility();
         }
         ImGui::TreePop();
     }
@@ -462,10 +462,10 @@ void SurfaceMeshControls<Mesh>::header_ambient_occlusion(const bool open)
         if(ImGui::SmallButton("Update AO"))
         {
             ambient_occlusion(*m,ao_data);
-            m->updateGL();
+            m->updateGL_colors();
             if(ao_data.with_floor) ao_data.floor.updateGL();
         }
-        if(ImGui::SliderFloat("Alpha",&m->AO_alpha, 0.f, 1.f)) { m->updateGL(); }
+        if(ImGui::SliderFloat("Alpha",&m->AO_alpha, 0.f, 1.f)) { m->updateGL_colors(); }
         if(ImGui::SliderInt  ("Dirs",&ao_data.n_samples,10,300)) {}
         if(ImGui::SliderFloat("Contrast",&ao_data.contrast,1.f,10.f)) {}
         if(ImGui::SliderFloat("Ray length",&ao_data.ray_length,0.001f,1.f)) {}
@@ -598,7 +598,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
                 {
                     m->poly_data(pid).flags[HIDDEN] = true;
                 }
-                m->updateGL();
+                m->updateGL_visibility();
             }
         }
         return false;
@@ -622,7 +622,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
                         m->poly_data(pid).flags[HIDDEN] = false;
                     }
                 }
-                m->updateGL();
+                m->updateGL_visibility();
             }
         }
         return false;
@@ -648,7 +648,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
                     }
                 }
                 m->poly_data(pid).flags[HIDDEN] = false;
-                m->updateGL();
+                m->updateGL_visibility();
             }
         }
         return false;
@@ -662,7 +662,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
         if(ImGui::RadioButton("Dig    ", &dig_choice, DIG    )) gui->callback_mouse_left_click = func_dig;
         if(ImGui::RadioButton("Undig  ", &dig_choice, UNDIG  )) gui->callback_mouse_left_click = func_undig;
         if(ImGui::RadioButton("Isolate", &dig_choice, ISOLATE)) gui->callback_mouse_left_click = func_isolate;
-        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); m->updateGL(); }
+        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); m->updateGL_visibility(); }
         ImGui::TreePop();
     }
 }
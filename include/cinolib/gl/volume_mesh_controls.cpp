@@ -101,6 +101,7 @@ void VolumeMeshControls<Mesh>::header_IO(const bool open)
             if(!filename.empty())
             {
                 *m = Mesh(filename.c_str());
+                slicer.clear_cache();
                 gui->refit_scene();
             }
         }
@@ -513,8 +514,7 @@ void VolumeMeshControls<Mesh>::header_slicing(const bool open)
         refresh |= ImGui::Checkbox   ("##l", &slicer.L_is);
         if(refresh)
         {
-            slicer.slice(*m);
-            m->updateGL();
+            if(!slicer.slice(*m).empty()) m->updateGL();
         }
         ImGui::TreePop();
     }
@@ -42,6 +42,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/gradient.h>
+#include <cinolib/operator_cache.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -50,177 +52,204 @@ typedef Eigen::Triplet<double> Entry;
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// per poly coefficients (see GradientCoeffs in operator_cache.h)
 template<class M, class V, class E, class P>
 CINO_INLINE
-Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, const bool per_poly)
+static GradientCoeffs gradient_coeffs(const AbstractPolygonMesh<M,V,E,P> & m)
 {
-    if(per_poly)
+    GradientCoeffs g;
+    g.offset.resize(m.num_polys()+1, 0);
+    for(uint pid=0; pid<m.num_polys(); ++pid) g.offset[pid+1] = g.offset[pid] + m.verts_per_poly(pid);
+    g.vid.resize(g.offset.back());
+    g.coeff.resize(g.offset.back());
+    g.measure.resize(m.num_polys());
+
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
+        g.measure[pid] = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
+        vec3d n = m.poly_data(pid).normal;
+        uint  k = g.offset[pid];
 
-        for(uint pid=0; pid<m.num_polys(); ++pid)
+        for(uint off=0; off<m.verts_per_poly(pid); ++off)
         {
-            double area = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
-            vec3d n     = m.poly_data(pid).normal;
-
-            for(uint off=0; off<m.verts_per_poly(pid); ++off)
-            {
-                uint  prev = m.poly_vert_id(pid,off);
-                uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
-                uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
-                vec3d u    = m.vert(next) - m.vert(curr);
-                vec3d v    = m.vert(curr) - m.vert(prev);
-                vec3d u_90 = u.cross(n); u_90.normalize();
-                vec3d v_90 = v.cross(n); v_90.normalize();
-
-                vec3d per_vert_sum_over_edge_normals = u_90 * u.norm() + v_90 * v.norm();
-                per_vert_sum_over_edge_normals /= area;
-
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.x())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.y())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.z()));
-            }
+            uint  prev = m.poly_vert_id(pid,off);
+            uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
+            uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
+            vec3d u    = m.vert(next) - m.vert(curr);
+            vec3d v    = m.vert(curr) - m.vert(prev);
+            vec3d u_90 = u.cross(n); u_90.normalize();
+            vec3d v_90 = v.cross(n); v_90.normalize();
+
+            g.vid[k]   = curr;
+            g.coeff[k] = u_90 * u.norm() + v_90 * v.norm(); // sum over edge normals
+            ++k;
         }
+    });
 
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
-    else // per vertex
+    g.weight = g.measure; // per vertex gradients are area weighted
+    return g;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+static GradientCoeffs gradient_coeffs(const AbstractPolyhedralMesh<M,V,E,F,P> & m)
+{
+    GradientCoeffs g;
+    g.offset.resize(m.num_polys()+1, 0);
+    for(uint pid=0; pid<m.num_polys(); ++pid) g.offset[pid+1] = g.offset[pid] + uint(m.adj_p2v(pid).size());
+    g.vid.resize(g.offset.back());
+    g.coeff.resize(g.offset.back());
+    g.measure.resize(m.num_polys());
+    g.weight.resize(m.num_polys());
+
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
     {
-        Eigen::SparseMatrix<double> G(m.num_verts()*3, m.num_verts());
-        std::vector<Entry> entries;
+        g.weight[pid]  = m.poly_volume(pid); // per vertex gradients are volume weighted
+        g.measure[pid] = std::max(g.weight[pid], 1e-5);
+        uint k = g.offset[pid];
 
-        for(uint vid=0; vid<m.num_verts(); ++vid)
+        for(uint vid : m.adj_p2v(pid))
         {
-            std::vector<std::pair<uint,vec3d>> vert_contr;
-            double area=0.f;
-            for(uint pid : m.adj_v2p(vid))
+            vec3d per_vert_sum_over_f_normals(0,0,0);
+            for(uint fid : m.adj_p2f(pid))
             {
-                area   += std::max(m.poly_area(pid), 1e-5) * 2.0;
-                vec3d n = m.poly_data(pid).normal;
-
-                for(uint off=0; off<m.verts_per_poly(pid); ++off)
+                if (m.face_contains_vert(fid,vid))
                 {
-                    uint  prev = m.poly_vert_id(pid,off);
-                    uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
-                    uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
-                    vec3d u    = m.vert(next) - m.vert(curr);
-                    vec3d v    = m.vert(curr) - m.vert(prev);
-                    vec3d u_90 = u.cross(n); u_90.normalize();
-                    vec3d v_90 = v.cross(n); v_90.normalize();
-
-                    // note: Eigen::setFromTriplets will take care of summing contributs w.r.t. multiple polys
-                    vert_contr.push_back(std::make_pair(curr, u_90*u.norm()+v_90*v.norm()));
+                    vec3d  n   = m.poly_face_normal(pid,fid);
+                    double a   = m.face_area(fid);
+                    double avg = static_cast<double>(m.verts_per_face(fid));
+                    per_vert_sum_over_f_normals += (n*a)/avg;
                 }
             }
-            uint row = vid * 3;
-            for(auto c : vert_contr)
-            {
-                entries.push_back(Entry(row  , c.first, c.second.x()/area));
-                entries.push_back(Entry(row+1, c.first, c.second.y()/area));
-                entries.push_back(Entry(row+2, c.first, c.second.z()/area));
-            }
+            g.vid[k]   = vid;
+            g.coeff[k] = per_vert_sum_over_f_normals;
+            ++k;
         }
+    });
 
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
+    return g;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class F, class P>
+// 3M x N matrix, with the gradient of each poly
 CINO_INLINE
-Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, const bool per_poly)
+static Eigen::SparseMatrix<double> gradient_per_poly(const GradientCoeffs & g, const uint nv)
 {
-    if(per_poly)
-    {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
+    uint np = uint(g.measure.size());
+    Eigen::SparseMatrix<double> G(np*3, nv);
 
-        for(uint pid=0; pid<m.num_polys(); ++pid)
+    // each poly writes 3 entries per vertex in its own range of the array
+    std::vector<Entry> entries(3*g.offset.back());
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        for(uint k=g.offset[pid]; k<g.offset[pid+1]; ++k)
         {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
-
-            for(uint vid : m.adj_p2v(pid))
-            {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
-                {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
-                }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
-            }
+            vec3d grad = g.coeff[k];
+            grad /= g.measure[pid];
+            uint row = 3 * pid;
+            entries[3*k  ] = Entry(row,   g.vid[k], grad.x());
+            entries[3*k+1] = Entry(row+1, g.vid[k], grad.y());
+            entries[3*k+2] = Entry(row+2, g.vid[k], grad.z());
         }
+    });
 
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
-    }
-    else // per vert
+    G.setFromTriplets(entries.begin(), entries.end());
+    return G;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+static Eigen::SparseMatrix<double> gradient_assemble(const AbstractPolygonMesh<M,V,E,P> & m, const GradientCoeffs & g, const bool per_poly)
+{
+    if(per_poly) return gradient_per_poly(g, m.num_verts());
+
+    // per vertex: area weighted average of the gradients of the incident polys
+    Eigen::SparseMatrix<double> G(m.num_verts()*3, m.num_verts());
+    std::vector<Entry> entries;
+
+    for(uint vid=0; vid<m.num_verts(); ++vid)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
+        double area=0.f;
+        for(uint pid : m.adj_v2p(vid)) area += g.weight[pid];
 
-        for(uint pid=0; pid<m.num_polys(); ++pid)
+        // note: Eigen::setFromTriplets will take care of summing contributs w.r.t. multiple polys
+        uint row = vid * 3;
+        for(uint pid : m.adj_v2p(vid))
+        for(uint k=g.offset[pid]; k<g.offset[pid+1]; ++k)
         {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
-
-            for(uint vid : m.adj_p2v(pid))
-            {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
-                {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
-                }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
-            }
+            entries.push_back(Entry(row  , g.vid[k], g.coeff[k].x()/area));
+            entries.push_back(Entry(row+1, g.vid[k], g.coeff[k].y()/area));
+            entries.push_back(Entry(row+2, g.vid[k], g.coeff[k].z()/area));
         }
-        G.setFromTriplets(entries.begin(), entries.end());
+    }
+
+    G.setFromTriplets(entries.begin(), entries.end());
+    return G;
+}
 
-        Eigen::SparseMatrix<double> A(m.num_verts()*3, m.num_polys()*3);
-        entries.clear();
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        for(uint vid=0;vid<m.num_verts();++vid)
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+static Eigen::SparseMatrix<double> gradient_assemble(const AbstractPolyhedralMesh<M,V,E,F,P> & m, const GradientCoeffs & g, const bool per_poly)
+{
+    Eigen::SparseMatrix<double> G = gradient_per_poly(g, m.num_verts());
+    if(per_poly) return G;
+
+    // per vertex: volume weighted average of the gradients of the incident polys
+    Eigen::SparseMatrix<double> A(m.num_verts()*3, m.num_polys()*3);
+    std::vector<Entry> entries;
+
+    for(uint vid=0;vid<m.num_verts();++vid)
+    {
+        double total_volume=0;
+        for(uint pid : m.adj_v2p(vid))
         {
-            double total_volume=0;
-            for(uint pid : m.adj_v2p(vid))
-            {
-                total_volume += m.poly_volume(pid);
-            }
-            uint row = 3*vid;
-            for(uint pid : m.adj_v2p(vid))
-            {
-                uint col=3*pid;
-                entries.push_back(Entry(row,  col,   m.poly_volume(pid)/total_volume));
-                entries.push_back(Entry(row+1,col+1, m.poly_volume(pid)/total_volume));
-                entries.push_back(Entry(row+2,col+2, m.poly_volume(pid)/total_volume));
-            }
+            total_volume += g.weight[pid];
+        }
+        uint row = 3*vid;
+        for(uint pid : m.adj_v2p(vid))
+        {
+            uint col=3*pid;
+            entries.push_back(Entry(row,  col,   g.weight[pid]/total_volume));
+            entries.push_back(Entry(row+1,col+1, g.weight[pid]/total_volume));
+            entries.push_back(Entry(row+2,col+2, g.weight[pid]/total_volume));
         }
-        A.setFromTriplets(entries.begin(), entries.end());
-        return A*G;
     }
+    A.setFromTriplets(entries.begin(), entries.end());
+    return A*G;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// per poly coefficients are the costly part, and can be cached (see operator_cache.h)
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, const bool per_poly)
+{
+    OperatorCache::Gradient g = m.operator_cache().get(&OperatorCache::Slots::gradient, [&]()
+    {
+        return gradient_coeffs(m);
+    });
+    return gradient_assemble(m, *g, per_poly);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, const bool per_poly)
+{
+    OperatorCache::Gradient g = m.operator_cache().get(&OperatorCache::Slots::gradient, [&]()
+    {
+        return gradient_coeffs(m);
+    });
+    return gradient_assemble(m, *g, per_poly);
 }
 
 }
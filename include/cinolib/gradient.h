@@ -62,6 +62,10 @@ namespace cinolib
  * with linear interpolation using the barycentri coordinates, which uniquely
  * defines a piece-wise constant gradient field.
  *
+ * If operator caching is enabled for m, the per poly gradient coefficients
+ * are cached within the mesh, and matrices are assembled from them until the
+ * mesh is edited or its normals are updated. See operator_cache.h
+ *
  * References:
  *
  *   A Comparison of Methods for Gradient Field Estimation on Simplicial Meshes
@@ -51,7 +51,7 @@ ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver >= SIMPLICIAL_LLT && solver <= CG_ICHOL);
 
     ScalarField f(m.num_verts());
 
@@ -80,7 +80,7 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    assert(solver >= SIMPLICIAL_LLT && solver <= CG_ICHOL);
 
     ScalarField f(3*m.num_verts());
 
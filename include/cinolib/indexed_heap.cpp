@@ -0,0 +1,220 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/indexed_heap.h>
+#include <algorithm>
+#include <cassert>
+
+namespace cinolib
+{
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::resize(const uint n)
+{
+    heap.clear();
+    pos.assign(n, max_uint);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::grow(const uint n)
+{
+    if(n>pos.size()) pos.resize(n, max_uint);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::clear()
+{
+    for(const Entry & e : heap) pos[e.id] = max_uint;
+    heap.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::push(const uint id, const double key)
+{
+    assert(id<pos.size() && !contains(id));
+    heap.push_back({key,id});
+    sift_up(uint(heap.size()-1));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::decrease(const uint id, const double key)
+{
+    assert(contains(id) && key<=heap[pos[id]].key);
+    uint i = pos[id];
+    heap[i].key = key;
+    sift_up(i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+bool IndexedHeap<D>::push_or_decrease(const uint id, const double key)
+{
+    assert(id<pos.size());
+    if(!contains(id))
+    {
+        push(id,key);
+        return true;
+    }
+    if(key<heap[pos[id]].key)
+    {
+        decrease(id,key);
+        return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::update(const uint id, const double key)
+{
+    assert(id<pos.size());
+    if(!contains(id))
+    {
+        push(id,key);
+        return;
+    }
+    uint   i   = pos[id];
+    double old = heap[i].key;
+    heap[i].key = key;
+    if(key<old) sift_up(i); else sift_down(i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::remove(const uint id)
+{
+    assert(id<pos.size());
+    if(!contains(id)) return;
+    uint i = pos[id];
+    pos[id] = max_uint;
+    Entry last = heap.back();
+    heap.pop_back();
+    if(i<heap.size())
+    {
+        // the last entry fills the hole, and may need to go either up or down
+        heap[i] = last;
+        sift_up(i);
+        sift_down(pos[last.id]);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+uint IndexedHeap<D>::pop()
+{
+    assert(!empty());
+    uint id = heap.front().id;
+    pos[id] = max_uint;
+    Entry last = heap.back();
+    heap.pop_back();
+    if(!heap.empty())
+    {
+        heap.front() = last;
+        sift_down(0);
+    }
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// both sift routines move a "hole" rather than swapping entries,
+// and write the moving entry (and its position) only once at the end
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::sift_up(uint i)
+{
+    Entry e = heap[i];
+    while(i>0)
+    {
+        uint parent = (i-1)/D;
+        if(!precedes(e, heap[parent])) break;
+        heap[i] = heap[parent];
+        pos[heap[i].id] = i;
+        i = parent;
+    }
+    heap[i] = e;
+    pos[e.id] = i;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint D>
+CINO_INLINE
+void IndexedHeap<D>::sift_down(uint i)
+{
+    Entry e = heap[i];
+    uint  n = uint(heap.size());
+    for(;;)
+    {
+        uint first = D*i+1;
+        if(first>=n) break;
+        uint last = std::min(first+D, n);
+        uint best = first;
+        for(uint c=first+1; c<last; ++c)
+        {
+            if(precedes(heap[c], heap[best])) best = c;
+        }
+        if(!precedes(heap[best], e)) break;
+        heap[i] = heap[best];
+        pos[heap[i].id] = i;
+        i = best;
+    }
+    heap[i] = e;
+    pos[e.id] = i;
+}
+
+}
@@ -0,0 +1,123 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_INDEXED_HEAP_H
+#define CINO_INDEXED_HEAP_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/min_max_inf.h>
+
+namespace cinolib
+{
+
+/* Min priority queue over a fixed range of ids [0,n), stored as an implicit
+ * D-ary heap. Each id can be in the queue at most once, and a position map
+ * allows to update its priority in place (decrease-key) rather than erasing
+ * and reinserting it, which is what Dijkstra-like algorithms need. Ties are
+ * broken by smaller id, so that the extraction order is the same one would
+ * get with a std::set<std::pair<double,uint>>. Memory is allocated only when
+ * the id range grows: clear() costs O(size), not O(n), hence the same queue
+ * can be cheaply reused across many queries on the same graph. Keys can also
+ * be increased, and ids removed, as required by greedy mesh optimizers whose
+ * candidate moves change cost (or disappear) after each step.
+*/
+
+template<uint D = 4>
+class IndexedHeap
+{
+    static_assert(D>=2, "IndexedHeap: arity must be at least 2");
+
+    public:
+
+        explicit IndexedHeap(const uint n = 0) { resize(n); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void resize(const uint n); // empties the queue and sets the id range to [0,n)
+        void grow  (const uint n); // extends the id range to [0,n), keeping the queue
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        uint size()  const { return uint(heap.size()); }
+        bool empty() const { return heap.empty();      }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool   contains(const uint id) const { return pos[id]!=max_uint;     }
+        double key     (const uint id) const { return heap[pos[id]].key;     }
+        uint   top()                   const { return heap.front().id;       }
+        double top_key()               const { return heap.front().key;      }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push            (const uint id, const double key); // id must not be in the queue
+        void decrease        (const uint id, const double key); // id must be in the queue, with a key >= than the new one
+        bool push_or_decrease(const uint id, const double key); // returns false (and does nothing) if id is in the queue with a key <= than the new one
+        void update          (const uint id, const double key); // pushes id, or moves it up or down according to its new key
+        void remove          (const uint id);                   // does nothing if id is not in the queue
+        uint pop();
+
+    protected:
+
+        struct Entry
+        {
+            double key;
+            uint   id;
+        };
+
+        static bool precedes(const Entry & a, const Entry & b)
+        {
+            return a.key<b.key || (a.key==b.key && a.id<b.id);
+        }
+
+        void sift_up  (uint i);
+        void sift_down(uint i);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<Entry> heap;
+        std::vector<uint>  pos;  // position of each id in heap (max_uint if not in the queue)
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "indexed_heap.cpp"
+#endif
+
+#endif // CINO_INDEXED_HEAP_H
@@ -0,0 +1,308 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/binary_mesh.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <typeinfo>
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <cstdio>
+
+namespace cinolib
+{
+
+static const char     BINARY_MESH_MAGIC[8]  = {'C','I','N','O','M','E','S','H'};
+static const uint32_t BINARY_MESH_ENDIANNESS = 0x01020304;
+static const uint64_t BINARY_MESH_ALIGNMENT  = 64;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// 64 bit FNV-1a hash
+CINO_INLINE
+uint64_t binary_mesh_type_hash(const char * type_name)
+{
+    uint64_t h = 14695981039346656037ull;
+    for(const char *c=type_name; *c!='\0'; ++c)
+    {
+        h ^= uint64_t(uint8_t(*c));
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BinaryMeshWriter::add_section(const char     * tag,
+                                   const void     * data,
+                                   const uint64_t   bytes,
+                                   const uint32_t   elem_size,
+                                   const uint64_t   type_hash)
+{
+    assert(strlen(tag) < sizeof(BinaryMeshSection::tag));
+
+    Section s;
+    memset(&s.info, 0, sizeof(BinaryMeshSection));
+    strncpy(s.info.tag, tag, sizeof(s.info.tag)-1);
+    s.info.bytes     = bytes;
+    s.info.type_hash = type_hash;
+    s.info.elem_size = elem_size;
+    s.data           = data;
+    sections.push_back(s);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+void BinaryMeshWriter::add_array(const char * tag, const std::vector<T> & data)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "binary mesh sections can only store trivially copyable types");
+    add_section(tag, data.data(), data.size()*sizeof(T), sizeof(T), binary_mesh_type_hash(typeid(T).name()));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BinaryMeshWriter::add_lists(const char * tag, const CSRIndices & lists)
+{
+    std::string t(tag);
+    add_array((t + ".off").c_str(), lists.vector_offsets());
+    add_array((t + ".ids").c_str(), lists.vector_ids());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BinaryMeshWriter::add_lists(const char * tag, const std::vector<std::vector<uint>> & lists)
+{
+    buffers.push_back(std::vector<uint>(lists.size()+1, 0));
+    std::vector<uint> & offsets = buffers.back();
+    for(uint i=0; i<lists.size(); ++i)
+    {
+        offsets[i+1] = offsets[i] + uint(lists[i].size());
+    }
+
+    std::string t(tag);
+    add_array((t + ".off").c_str(), offsets);
+    add_section((t + ".ids").c_str(), nullptr, uint64_t(offsets.back())*sizeof(uint), sizeof(uint), binary_mesh_type_hash(typeid(uint).name()));
+    sections.back().lists = &lists;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BinaryMeshWriter::add_lists(const char * tag, const std::vector<std::vector<bool>> & lists)
+{
+    buffers.push_back(std::vector<uint>(lists.size()+1, 0));
+    std::vector<uint> & offsets = buffers.back();
+    buffers.push_back(std::vector<uint>());
+    std::vector<uint> & flags = buffers.back();
+    for(uint i=0; i<lists.size(); ++i)
+    {
+        offsets[i+1] = offsets[i] + uint(lists[i].size());
+        for(bool b : lists[i]) flags.push_back(b ? 1 : 0);
+    }
+
+    std::string t(tag);
+    add_array((t + ".off").c_str(), offsets);
+    add_array((t + ".ids").c_str(), flags);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BinaryMeshWriter::write(const char * filename) const
+{
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : couldn't write output file " << filename << std::endl;
+        return false;
+    }
+
+    auto align = [](const uint64_t off) { return (off + BINARY_MESH_ALIGNMENT - 1) / BINARY_MESH_ALIGNMENT * BINARY_MESH_ALIGNMENT; };
+
+    BinaryMeshHeader h;
+    memcpy(h.magic, BINARY_MESH_MAGIC, sizeof(h.magic));
+    h.version      = BINARY_MESH_VERSION;
+    h.mesh_type    = uint32_t(type);
+    h.endianness   = BINARY_MESH_ENDIANNESS;
+    h.num_sections = uint32_t(sections.size());
+
+    std::vector<BinaryMeshSection> table(sections.size());
+    uint64_t off = align(sizeof(BinaryMeshHeader) + sections.size()*sizeof(BinaryMeshSection));
+    for(uint i=0; i<sections.size(); ++i)
+    {
+        table[i]        = sections[i].info;
+        table[i].offset = off;
+        off = align(off + table[i].bytes);
+    }
+
+    bool ok = true;
+    ok &= fwrite(&h, sizeof(BinaryMeshHeader), 1, fp) == 1;
+    ok &= fwrite(table.data(), sizeof(BinaryMeshSection), table.size(), fp) == table.size();
+    uint64_t pos = sizeof(BinaryMeshHeader) + table.size()*sizeof(BinaryMeshSection);
+
+    const char zeros[BINARY_MESH_ALIGNMENT] = {};
+    for(uint i=0; i<sections.size() && ok; ++i)
+    {
+        size_t pad = size_t(table[i].offset - pos);
+        ok &= fwrite(zeros, 1, pad, fp) == pad;
+        pos = table[i].offset + table[i].bytes;
+
+        if(sections[i].lists != nullptr)
+        {
+            for(const auto & l : *sections[i].lists)
+            {
+                ok &= fwrite(l.data(), sizeof(uint), l.size(), fp) == l.size();
+            }
+        }
+        else if(table[i].bytes > 0)
+        {
+            ok &= fwrite(sections[i].data, 1, table[i].bytes, fp) == table[i].bytes;
+        }
+    }
+    ok &= fclose(fp) == 0;
+
+    if(!ok) std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : failed writing " << filename << std::endl;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BinaryMeshReader::open(const char * filename)
+{
+    toc.clear();
+    if(!file.open(filename) || file.size() < sizeof(BinaryMeshHeader)) return false;
+
+    BinaryMeshHeader h;
+    memcpy(&h, file.data(), sizeof(BinaryMeshHeader));
+    if(memcmp(h.magic, BINARY_MESH_MAGIC, sizeof(h.magic)) != 0 ||
+       h.version    != BINARY_MESH_VERSION                      ||
+       h.endianness != BINARY_MESH_ENDIANNESS                   ||
+       h.mesh_type   > uint32_t(POLYHEDRALMESH)                 ||
+       file.size()   < sizeof(BinaryMeshHeader) + uint64_t(h.num_sections)*sizeof(BinaryMeshSection))
+    {
+        return false;
+    }
+    type = MeshType(h.mesh_type);
+
+    for(uint i=0; i<h.num_sections; ++i)
+    {
+        BinaryMeshSection s;
+        memcpy(&s, file.data() + sizeof(BinaryMeshHeader) + i*sizeof(BinaryMeshSection), sizeof(BinaryMeshSection));
+        s.tag[sizeof(s.tag)-1] = '\0';
+        if(s.offset > file.size() || s.bytes > file.size() - s.offset) return false; // truncated file
+        toc[s.tag] = s;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BinaryMeshReader::section(const char        * tag,
+                               const uint32_t      elem_size,
+                               const uint64_t      type_hash,
+                                     BinaryMeshSection & s) const
+{
+    auto it = toc.find(tag);
+    if(it == toc.end()) return false;
+    s = it->second;
+    return s.elem_size == elem_size && s.type_hash == type_hash && s.bytes % elem_size == 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BinaryMeshReader::copy(const BinaryMeshSection & s, void * dst) const
+{
+    // big sections are copied in blocks, concurrently, so that page faults
+    // and memory transfers are spread across threads
+    const uint64_t block = 1 << 20;
+    const uint     nb    = uint((s.bytes + block - 1) / block);
+    const char   * src   = file.data() + s.offset;
+    PARALLEL_FOR(0, nb, 4, [&](const uint i)
+    {
+        uint64_t beg = i*block;
+        uint64_t len = std::min(block, s.bytes - beg);
+        memcpy(static_cast<char*>(dst) + beg, src + beg, len);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T>
+CINO_INLINE
+bool BinaryMeshReader::read_array(const char * tag, std::vector<T> & data) const
+{
+    static_assert(std::is_trivially_copyable<T>::value, "binary mesh sections can only store trivially copyable types");
+    BinaryMeshSection s;
+    if(!section(tag, sizeof(T), binary_mesh_type_hash(typeid(T).name()), s)) return false;
+    data.resize(s.bytes / sizeof(T));
+    copy(s, data.data());
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BinaryMeshReader::read_lists(const char * tag, CSRIndices & lists) const
+{
+    std::string t(tag);
+    std::vector<uint> offsets, ids;
+    if(!read_array((t + ".off").c_str(), offsets) ||
+       !read_array((t + ".ids").c_str(), ids))
+    {
+        return false;
+    }
+
+    // a corrupted offset would turn into out of bounds accesses later on
+    if(offsets.empty() || offsets.front() != 0 || offsets.back() != ids.size()) return false;
+    for(uint i=1; i<offsets.size(); ++i) if(offsets[i] < offsets[i-1]) return false;
+
+    lists.assign(std::move(offsets), std::move(ids));
+    return true;
+}
+
+}
@@ -0,0 +1,190 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BINARY_MESH_H
+#define CINO_BINARY_MESH_H
+
+#include <map>
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include <cinolib/cino_inline.h>
+#include <cinolib/csr_indices.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/meshes/abstract_mesh.h>
+
+namespace cinolib
+{
+
+/* Native binary mesh format (.cino). Meant as a cache for meshes that are
+ * loaded many times: positions, connectivity, all adjacencies and (optionally)
+ * per element attributes are stored as raw arrays, each in its own section,
+ * so that a mesh can be restored with plain memory copies, without parsing
+ * and without rebuilding its topology. Meshes are then thawed, unless they
+ * are loaded with AbstractMesh::load_binary_frozen (read-only use). All ids
+ * are range checked, so a corrupted file is rejected instead of producing
+ * out of bounds accesses later on.
+ *
+ * File layout:
+ *   - header (magic, version, mesh type, endianness check, number of sections)
+ *   - section table (tag, offset, size, element size and type of each section)
+ *   - sections, each starting at a 64 bytes aligned offset
+ *
+ * Lists of lists (e.g. polys, or the vert-to-poly adjacency) are stored in CSR
+ * form, as two sections named "<tag>.off" and "<tag>.ids" (see CSRIndices).
+ * Element types are identified through the typeid of the C++ type used to
+ * write them, hence files are portable only across builds of the same compiler
+ * and architecture, which is all a cache needs.
+*/
+
+static const uint32_t BINARY_MESH_VERSION = 1;
+
+struct BinaryMeshHeader
+{
+    char     magic[8];     // "CINOMESH"
+    uint32_t version;
+    uint32_t mesh_type;    // MeshType
+    uint32_t endianness;   // 0x01020304, as seen by the writer
+    uint32_t num_sections;
+};
+
+struct BinaryMeshSection
+{
+    char     tag[16];      // zero terminated
+    uint64_t offset;       // from the beginning of the file
+    uint64_t bytes;
+    uint64_t type_hash;    // hash of the element type name
+    uint32_t elem_size;
+    uint32_t padding;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class BinaryMeshWriter
+{
+    public:
+
+        explicit BinaryMeshWriter(const MeshType type) : type(type) {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // sections refer to the input data, which must stay alive (and unchanged)
+        // until write() is called. Tags are at most 15 characters long
+        template<class T>
+        void add_array(const char * tag, const std::vector<T> & data);
+        void add_lists(const char * tag, const CSRIndices & lists);
+        void add_lists(const char * tag, const std::vector<std::vector<uint>> & lists);
+        void add_lists(const char * tag, const std::vector<std::vector<bool>> & lists); // stored as 0/1 flags
+
+        // per element attributes (e.g. vert/poly data) are stored only if their type
+        // is trivially copyable, and silently skipped otherwise
+        template<class T>
+        void add_attributes(const char * tag, const std::vector<T> & data) { add_attributes(tag, data, std::is_trivially_copyable<T>()); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool write(const char * filename) const;
+
+    protected:
+
+        struct Section
+        {
+            BinaryMeshSection                      info;
+            const void                           * data  = nullptr;
+            const std::vector<std::vector<uint>> * lists = nullptr; // serialized while writing
+        };
+
+        void add_section(const char * tag, const void * data, const uint64_t bytes, const uint32_t elem_size, const uint64_t type_hash);
+
+        template<class T> void add_attributes(const char * tag, const std::vector<T> & data, std::true_type)  { add_array(tag, data); }
+        template<class T> void add_attributes(const char *,     const std::vector<T> &,      std::false_type) {}
+
+        MeshType                     type;
+        std::vector<Section>         sections;
+        std::list<std::vector<uint>> buffers; // data serialized by the writer itself (e.g. CSR offsets)
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class BinaryMeshReader
+{
+    public:
+
+        explicit BinaryMeshReader() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool     open(const char * filename); // false if the file is missing, or is not a valid binary mesh
+        MeshType mesh_type() const { return type; }
+        bool     has(const char * tag) const { return toc.find(tag) != toc.end(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // false if the section is missing, or if it does not contain elements of type T
+        template<class T>
+        bool read_array(const char * tag, std::vector<T> & data) const;
+        bool read_lists(const char * tag, CSRIndices & lists) const;
+
+        // false if T is not trivially copyable (see BinaryMeshWriter::add_attributes)
+        template<class T>
+        bool read_attributes(const char * tag, std::vector<T> & data) const { return read_attributes(tag, data, std::is_trivially_copyable<T>()); }
+
+    protected:
+
+        bool section(const char * tag, const uint32_t elem_size, const uint64_t type_hash, BinaryMeshSection & s) const;
+        void copy(const BinaryMeshSection & s, void * dst) const;
+
+        template<class T> bool read_attributes(const char * tag, std::vector<T> & data, std::true_type)  const { return read_array(tag, data); }
+        template<class T> bool read_attributes(const char *,     std::vector<T> &,      std::false_type) const { return false; }
+
+        MappedFile                               file;
+        MeshType                                 type;
+        std::map<std::string, BinaryMeshSection> toc;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint64_t binary_mesh_type_hash(const char * type_name);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "binary_mesh.cpp"
+#endif
+
+#endif // CINO_BINARY_MESH_H
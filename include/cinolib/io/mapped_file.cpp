@@ -0,0 +1,110 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/mapped_file.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX            // keep std::min/std::max usable in the rest of the library
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool MappedFile::open(const char * filename)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE f = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER s;
+    if(!GetFileSizeEx(f, &s)) { CloseHandle(f); return false; }
+    file   = f;
+    len    = size_t(s.QuadPart);
+    opened = true;
+    if(len==0) return true;
+    HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(m == NULL) { close(); return false; }
+    map = m;
+    ptr = static_cast<const char*>(MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0));
+    if(ptr == nullptr) { close(); return false; }
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if(fd < 0) return false;
+    struct stat s;
+    if(fstat(fd, &s) != 0) { ::close(fd); return false; }
+    len    = size_t(s.st_size);
+    opened = true;
+    if(len==0) { ::close(fd); return true; }
+    void *p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+    if(p == MAP_FAILED) { len = 0; opened = false; return false; }
+    ptr = static_cast<const char*>(p);
+#endif
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if(ptr  != nullptr) UnmapViewOfFile(ptr);
+    if(map  != nullptr) CloseHandle(map);
+    if(file != nullptr) CloseHandle(file);
+    map  = nullptr;
+    file = nullptr;
+#else
+    if(ptr != nullptr) munmap(const_cast<char*>(ptr), len);
+#endif
+    ptr    = nullptr;
+    len    = 0;
+    opened = false;
+}
+
+}
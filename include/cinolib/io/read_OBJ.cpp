@@ -44,6 +44,10 @@
 #include <cinolib/io/read_OBJ.h>
 #include <cinolib/to_openGL_unified_verts.h>
 #include <cinolib/string_utilities.h>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -56,16 +60,357 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// https://stackoverflow.com/questions/9310327/sscanf-optional-column
-//
+/* The reader memory maps the file and splits it into chunks of whole lines,
+ * which are parsed in parallel. A first pass counts the vertex lines of each
+ * chunk, so that in the second pass each chunk knows the global index of its
+ * first vertex, writes vertices straight into the output arrays, and resolves
+ * relative (negative) face indices. Polygons are parsed into per chunk buffers,
+ * which are then concatenated. Lines that change the parser state (materials,
+ * groups) are rare: they are recorded as events along with the position of the
+ * face they precede, and replayed serially at the end.
+*/
+
+enum
+{
+    OBJ_OTHER,
+    OBJ_POS,
+    OBJ_TEX,
+    OBJ_NOR,
+    OBJ_FACE,
+    OBJ_EVENT,
+};
+
+struct OBJEvent
+{
+    uint        face;  // number of faces in the chunk before the event
+    std::string line;
+    Color       color; // parser state after the event
+    int         label;
+};
+
+struct OBJChunk
+{
+    const char *beg, *end;
+    uint n_pos = 0, n_tex = 0, n_nor = 0, n_faces = 0; // lines in the chunk
+    uint base_pos = 0, base_tex = 0, base_nor = 0, base_face = 0;
+    // polygons with at least one reference to pos/tex/nor
+    std::vector<uint> pos_ids, tex_ids, nor_ids;
+    std::vector<uint> pos_cnt, tex_cnt, nor_cnt;
+    std::vector<uint> pos_face; // (chunk) face of each polygon in pos_cnt
+    std::vector<OBJEvent> events;
+    Color start_color;
+    int   start_label;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static int OBJ_line_type(const char * p, const char * end)
+{
+    if(p==end) return OBJ_OTHER;
+    switch(*p)
+    {
+        case 'v':
+        {
+            if(p+1==end) return OBJ_OTHER;
+            if(p[1]==' ' || p[1]=='\t') return OBJ_POS;
+            if(p[1]=='t') return OBJ_TEX;
+            if(p[1]=='n') return OBJ_NOR;
+            return OBJ_OTHER;
+        }
+        case 'f': return OBJ_FACE;
+        case 'u':
+        case 'm':
+        case 'g': return OBJ_EVENT;
+    }
+    return OBJ_OTHER;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static bool OBJ_is_space(const char c)
+{
+    return c==' ' || c=='\t' || c=='\r' || c=='\n';
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Parses a double, skipping leading blanks. Returns the position after the
+ * number, or nullptr if there is no number. Common numbers take the fast path
+ * of Clinger's algorithm: if the decimal mantissa fits in 53 bits and the power
+ * of ten is exactly representable, a single multiplication (or division) gives
+ * the correctly rounded result, i.e. the same value strtod would return.
+ * Everything else (long mantissas, large exponents, nan, inf...) goes through
+ * strtod.
+*/
+CINO_INLINE
+static const char * OBJ_parse_double(const char * p, const char * end, double & d)
+{
+    static const double pow10[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    while(p<end && (*p==' ' || *p=='\t')) ++p;
+    if(p==end) return nullptr;
+    const char *beg = p;
+
+    bool neg = false;
+    if(*p=='-' || *p=='+') neg = (*p++=='-');
+
+    uint64_t m      = 0;
+    int      digits = 0; // significant digits in m
+    int      exp10  = 0;
+    bool     any    = false;
+    for(; p<end && *p>='0' && *p<='9'; ++p)
+    {
+        any = true;
+        if(m>0 || *p!='0') { m = m*10 + uint64_t(*p-'0'); ++digits; }
+    }
+    if(p<end && *p=='.')
+    {
+        for(++p; p<end && *p>='0' && *p<='9'; ++p)
+        {
+            any = true;
+            if(m>0 || *p!='0') { m = m*10 + uint64_t(*p-'0'); ++digits; }
+            --exp10;
+        }
+    }
+    bool fast = any && digits<=19;
+    if(fast && p<end && (*p=='e' || *p=='E'))
+    {
+        ++p;
+        bool eneg = false;
+        if(p<end && (*p=='-' || *p=='+')) eneg = (*p++=='-');
+        int  e     = 0;
+        bool edigs = false;
+        for(; p<end && *p>='0' && *p<='9'; ++p)
+        {
+            edigs = true;
+            if(e<10000) e = e*10 + (*p-'0');
+        }
+        fast = edigs;
+        exp10 += eneg ? -e : e;
+    }
+    fast = fast && (p==end || OBJ_is_space(*p)) && m <= (uint64_t(1)<<53) && exp10>=-22 && exp10<=22;
+
+    if(fast)
+    {
+        double v = double(m);
+        v = (exp10<0) ? v/pow10[-exp10] : v*pow10[exp10];
+        d = neg ? -v : v;
+        return p;
+    }
+
+    // slow path: strtod needs a null terminated string
+    const char *tok_end = beg;
+    while(tok_end<end && !OBJ_is_space(*tok_end)) ++tok_end;
+    std::string tok(beg, tok_end);
+    char *stop;
+    d = strtod(tok.c_str(), &stop);
+    if(stop==tok.c_str()) return nullptr;
+    return beg + (stop - tok.c_str());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static const char * OBJ_parse_int(const char * p, const char * end, int & i)
+{
+    bool neg = false;
+    if(p<end && (*p=='-' || *p=='+')) neg = (*p++=='-');
+    if(p==end || *p<'0' || *p>'9') return nullptr;
+    long v = 0;
+    for(; p<end && *p>='0' && *p<='9'; ++p) v = v*10 + (*p-'0');
+    i = int(neg ? -v : v);
+    return p;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// OBJ indices are 1-based, or relative to the last element read if negative
+CINO_INLINE
+static bool OBJ_resolve_id(const int id, const uint n_before, uint & res)
+{
+    if(id>0)
+    {
+        res = uint(id-1);
+        return true;
+    }
+    if(id<0 && uint(-id)<=n_before)
+    {
+        res = n_before - uint(-id);
+        return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static void OBJ_parse_chunk(OBJChunk           & c,
+                            std::vector<vec3d> & pos,
+                            std::vector<vec3d> & tex,
+                            std::vector<vec3d> & nor)
+{
+    uint n_pos = 0, n_tex = 0, n_nor = 0;
+    const char *line = c.beg;
+    while(line < c.end)
+    {
+        const char *eol = static_cast<const char*>(memchr(line, '\n', size_t(c.end-line)));
+        if(eol==nullptr) eol = c.end;
+
+        switch(OBJ_line_type(line, eol))
+        {
+            // malformed vertices are set to zero rather than skipped, as
+            // skipping would shift the ids of all the subsequent vertices
+            case OBJ_POS:
+            case OBJ_TEX:
+            case OBJ_NOR:
+            {
+                double xyz[3] = { 0, 0, 0 };
+                const char *p = line + ((line[1]==' ' || line[1]=='\t') ? 1 : 2);
+                for(int i=0; i<3 && p!=nullptr; ++i) p = OBJ_parse_double(p, eol, xyz[i]);
+                vec3d v(xyz[0], xyz[1], xyz[2]);
+                switch(OBJ_line_type(line, eol))
+                {
+                    case OBJ_POS: pos[c.base_pos + n_pos++] = v; break;
+                    case OBJ_TEX: tex[c.base_tex + n_tex++] = v; break;
+                    case OBJ_NOR: nor[c.base_nor + n_nor++] = v; break;
+                }
+                break;
+            }
+
+            case OBJ_FACE:
+            {
+                uint n_p = 0, n_t = 0, n_n = 0;
+                const char *p = line + 1;
+                while(true)
+                {
+                    while(p<eol && OBJ_is_space(*p)) ++p;
+                    if(p==eol) break;
+
+                    // v | v/vt | v//vn | v/vt/vn
+                    int v, vt, vn;
+                    bool has_v = false, has_vt = false, has_vn = false;
+                    const char *q = OBJ_parse_int(p, eol, v);
+                    if(q!=nullptr)
+                    {
+                        has_v = true;
+                        p = q;
+                        if(p<eol && *p=='/')
+                        {
+                            ++p;
+                            if(p<eol && *p=='/')
+                            {
+                                q = OBJ_parse_int(p+1, eol, vn);
+                                if(q!=nullptr) { has_vn = true; p = q; }
+                            }
+                            else if((q = OBJ_parse_int(p, eol, vt)) != nullptr)
+                            {
+                                has_vt = true;
+                                p = q;
+                                if(p<eol && *p=='/' && (q = OBJ_parse_int(p+1, eol, vn)) != nullptr)
+                                {
+                                    has_vn = true;
+                                    p = q;
+                                }
+                            }
+                        }
+                    }
+                    while(p<eol && !OBJ_is_space(*p)) ++p; // skip the rest of the token
+
+                    uint id;
+                    if(has_v  && OBJ_resolve_id(v,  c.base_pos + n_pos, id)) { c.pos_ids.push_back(id); ++n_p; }
+                    if(has_vt && OBJ_resolve_id(vt, c.base_tex + n_tex, id)) { c.tex_ids.push_back(id); ++n_t; }
+                    if(has_vn && OBJ_resolve_id(vn, c.base_nor + n_nor, id)) { c.nor_ids.push_back(id); ++n_n; }
+                }
+                if(n_p>0) { c.pos_cnt.push_back(n_p); c.pos_face.push_back(c.n_faces); }
+                if(n_t>0) c.tex_cnt.push_back(n_t);
+                if(n_n>0) c.nor_cnt.push_back(n_n);
+                ++c.n_faces;
+                break;
+            }
+
+            case OBJ_EVENT:
+            {
+                OBJEvent e;
+                e.face = c.n_faces;
+                e.line.assign(line, eol);
+                c.events.push_back(e);
+                break;
+            }
+        }
+        line = eol + 1;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// serializes the polygons of all chunks (pos, tex or nor, depending on the members),
+// and returns the id of the first polygon of each chunk
+CINO_INLINE
+static std::vector<uint> OBJ_gather_polys(const std::vector<OBJChunk>       & chunks,
+                                                std::vector<uint> OBJChunk::* ids,
+                                                std::vector<uint> OBJChunk::* cnt,
+                                                CSRIndices                  & polys)
+{
+    uint np = 0, nc = 0;
+    std::vector<uint> p_base(chunks.size());
+    std::vector<uint> c_base(chunks.size());
+    for(uint i=0; i<chunks.size(); ++i)
+    {
+        p_base[i] = np;
+        c_base[i] = nc;
+        np += uint((chunks[i].*cnt).size());
+        nc += uint((chunks[i].*ids).size());
+    }
+    std::vector<uint> offsets(np+1);
+    std::vector<uint> flat(nc);
+    offsets[np] = nc;
+    PARALLEL_FOR(0, uint(chunks.size()), 2, [&](const uint i)
+    {
+        const OBJChunk & c = chunks[i];
+        std::copy((c.*ids).begin(), (c.*ids).end(), flat.begin() + c_base[i]);
+        uint off = c_base[i];
+        for(uint j=0; j<(c.*cnt).size(); ++j)
+        {
+            offsets[p_base[i] + j] = off;
+            off += (c.*cnt)[j];
+        }
+    });
+    polys.assign(std::move(offsets), std::move(flat));
+    return p_base;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
-void read_point_id(char * s, int & v, int & vt, int & vn)
+static std::vector<std::vector<uint>> OBJ_to_nested(const CSRIndices & polys)
 {
-    v = vt = vn = -1;
-         if(sscanf(s, "%d/%d/%d", &v, &vt, &vn) == 3) { --v; --vt; --vn; }
-    else if(sscanf(s, "%d/%d",    &v, &vt     ) == 2) { --v; --vt;       }
-    else if(sscanf(s, "%d//%d",   &v, &vn     ) == 2) { --v; --vn;       }
-    else if(sscanf(s, "%d",       &v          ) == 1) { --v;             }
+    std::vector<std::vector<uint>> lists(polys.size());
+    PARALLEL_FOR(0, polys.size(), 10000, [&](const uint i)
+    {
+        lists[i] = polys[i].to_vector();
+    });
+    return lists;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_OBJ(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              CSRIndices                     & poly)
+{
+    std::vector<vec3d> tex, nor;
+    CSRIndices poly_tex, poly_nor;
+    std::vector<Color> poly_col;
+    std::vector<int> poly_lab;
+    std::string diffuse_path, specular_path, normal_path;
+    read_OBJ(filename, verts, tex, nor, poly, poly_tex, poly_nor, poly_col, poly_lab, diffuse_path, specular_path, normal_path);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -123,9 +468,9 @@ void read_OBJ(const char                     * filename,
               std::vector<vec3d>             & pos,           // vertex xyz positions
               std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
               std::vector<vec3d>             & nor,           // vertex normals
-              std::vector<std::vector<uint>> & poly_pos,      // polygons with references to pos
-              std::vector<std::vector<uint>> & poly_tex,      // polygons with references to tex
-              std::vector<std::vector<uint>> & poly_nor,      // polygons with references to nor
+              CSRIndices                     & poly_pos,      // polygons with references to pos
+              CSRIndices                     & poly_tex,      // polygons with references to tex
+              CSRIndices                     & poly_nor,      // polygons with references to nor
               std::vector<Color>             & poly_col,      // per polygon colors
               std::vector<int>               & poly_lab,      // per polygon labels (cluster by OBJ groups "g")
               std::string                    & diffuse_path,  // path of the image encoding the diffuse  texture component
@@ -146,111 +491,189 @@ void read_OBJ(const char                     * filename,
     specular_path.clear();
     normal_path.clear();
 
-    std::ifstream f(filename);
-    if(!f.is_open())
+    MappedFile f;
+    if(!f.open(filename))
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OBJ() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
+    // split the file into chunks of whole lines
+    const size_t chunk_size = 1<<22;
+    const char  *data       = f.data();
+    const char  *data_end   = data + f.size();
+    uint n_chunks = uint(std::max(size_t(1), f.size()/chunk_size));
+    std::vector<OBJChunk> chunks(n_chunks);
+    for(uint i=0; i<n_chunks; ++i)
+    {
+        const char *p = (i==0) ? data : data + f.size()/n_chunks*i;
+        if(i>0)
+        {
+            p = std::max(p, chunks[i-1].beg);
+            while(p<data_end && p[-1]!='\n') ++p;
+        }
+        chunks[i].beg = p;
+        if(i>0) chunks[i-1].end = p;
+    }
+    chunks.back().end = data_end;
+
+    // first pass: count vertices, to know where each chunk starts writing them
+    PARALLEL_FOR(0, n_chunks, 2, [&](const uint i)
+    {
+        OBJChunk & c = chunks[i];
+        for(const char *line=c.beg; line<c.end;)
+        {
+            const char *eol = static_cast<const char*>(memchr(line, '\n', size_t(c.end-line)));
+            if(eol==nullptr) eol = c.end;
+            switch(OBJ_line_type(line, eol))
+            {
+                case OBJ_POS: ++c.n_pos; break;
+                case OBJ_TEX: ++c.n_tex; break;
+                case OBJ_NOR: ++c.n_nor; break;
+            }
+            line = eol + 1;
+        }
+    });
+    for(uint i=1; i<n_chunks; ++i)
+    {
+        chunks[i].base_pos = chunks[i-1].base_pos + chunks[i-1].n_pos;
+        chunks[i].base_tex = chunks[i-1].base_tex + chunks[i-1].n_tex;
+        chunks[i].base_nor = chunks[i-1].base_nor + chunks[i-1].n_nor;
+    }
+    pos.resize(chunks.back().base_pos + chunks.back().n_pos);
+    tex.resize(chunks.back().base_tex + chunks.back().n_tex);
+    nor.resize(chunks.back().base_nor + chunks.back().n_nor);
+
+    // second pass: parse
+    PARALLEL_FOR(0, n_chunks, 2, [&](const uint i)
+    {
+        OBJ_parse_chunk(chunks[i], pos, tex, nor);
+    });
+    for(uint i=1; i<n_chunks; ++i)
+    {
+        chunks[i].base_face = chunks[i-1].base_face + chunks[i-1].n_faces;
+    }
+
+    std::vector<uint> pos_base = OBJ_gather_polys(chunks, &OBJChunk::pos_ids, &OBJChunk::pos_cnt, poly_pos);
+    OBJ_gather_polys(chunks, &OBJChunk::tex_ids, &OBJChunk::tex_cnt, poly_tex);
+    OBJ_gather_polys(chunks, &OBJChunk::nor_ids, &OBJChunk::nor_cnt, poly_nor);
+
+    // replay materials and groups in file order
     int fresh_label = 0;
     std::map<std::string,Color> color_map;
     Color curr_color = Color::WHITE();     // set WHITE as default color
     bool has_per_face_color = false;
     bool has_groups         = false;
 
-    std::string line;
-    while(std::getline(f,line))
+    for(OBJChunk & c : chunks)
     {
-        switch(line[0])
+        c.start_color = curr_color;
+        c.start_label = fresh_label;
+        for(OBJEvent & e : c.events)
         {
-            case 'v':
-            {
-                // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-                //
-                double a, b, c;
-                     if(sscanf(line.data(), "v  %lf %lf %lf", &a, &b, &c) == 3) pos.push_back(vec3d(a,b,c));
-                else if(sscanf(line.data(), "vt %lf %lf %lf", &a, &b, &c) == 3) tex.push_back(vec3d(a,b,c));
-                else if(sscanf(line.data(), "vt %lf %lf %lf", &a, &b, &c) == 2) tex.push_back(vec3d(a,b,0));
-                else if(sscanf(line.data(), "vn %lf %lf %lf", &a, &b, &c) == 3) nor.push_back(vec3d(a,b,c));
-                break;
-            }
-
-            case 'f':
-            {
-                line = line.substr(1,line.size()-1); // discard the 'f' letter
-                std::istringstream ss(line);
-                std::vector<uint> p_pos, p_tex, p_nor;
-                for(std::string sub_str; ss >> sub_str;)
-                {
-                    int v_pos, v_tex, v_nor;
-                    read_point_id(strdup(sub_str.c_str()), v_pos, v_tex, v_nor);
-                    if (v_pos >= 0) p_pos.push_back(v_pos);
-                    if (v_tex >= 0) p_tex.push_back(v_tex);
-                    if (v_nor >= 0) p_nor.push_back(v_nor);
-                }
-                if (!p_tex.empty()) poly_tex.push_back(p_tex);
-                if (!p_nor.empty()) poly_nor.push_back(p_nor);
-                if (!p_pos.empty())
-                {
-                    poly_pos.push_back(p_pos);
-                    poly_col.push_back(curr_color);
-                }
-                poly_lab.push_back(fresh_label);
-                break;
-            }
-
-            case 'u':
+            const std::string & line = e.line;
+            switch(line[0])
             {
-                char mat_c[1024];
-                if (sscanf(line.data(), "usemtl %s", mat_c) == 1)
+                case 'u':
                 {
-                    auto query = color_map.find(std::string(mat_c));
-                    if (query != color_map.end())
+                    char mat_c[1024];
+                    if (sscanf(line.data(), "usemtl %s", mat_c) == 1)
                     {
-                        curr_color = query->second;
+                        auto query = color_map.find(std::string(mat_c));
+                        if (query != color_map.end())
+                        {
+                            curr_color = query->second;
+                        }
+                        else std::cerr << "WARNING: could not find material: " << mat_c << std::endl;
                     }
-                    else std::cerr << "WARNING: could not find material: " << mat_c << std::endl;
+                    break;
                 }
-                break;
-            }
 
-            case 'm':
-            {
-                char mtu_c[1024];
-                if(sscanf(line.data(), "mtllib %[^\n]s", mtu_c) == 1)
+                case 'm':
                 {
-                    std::string s0(filename);
-                    std::string s1(mtu_c);
-                    std::string s2 = get_file_path(s0) + get_file_name(s1);
-
-                    // this fix shouldn't be here, but...
-                    // https://stackoverflow.com/questions/1279779/what-is-the-difference-between-r-and-n
-                    if(!s2.empty() && s2[s2.size()-1]=='\r')
+                    char mtu_c[1024];
+                    if(sscanf(line.data(), "mtllib %[^\n]s", mtu_c) == 1)
                     {
-                        s2.erase(s2.size()-1);
+                        std::string s0(filename);
+                        std::string s1(mtu_c);
+                        std::string s2 = get_file_path(s0) + get_file_name(s1);
+
+                        // this fix shouldn't be here, but...
+                        // https://stackoverflow.com/questions/1279779/what-is-the-difference-between-r-and-n
+                        if(!s2.empty() && s2[s2.size()-1]=='\r')
+                        {
+                            s2.erase(s2.size()-1);
+                        }
+
+                        if(read_MTU(s2.c_str(), color_map, diffuse_path, specular_path, normal_path))
+                        {
+                            has_per_face_color = true;
+                        }
                     }
+                    break;
+                }
 
-                    if(read_MTU(s2.c_str(), color_map, diffuse_path, specular_path, normal_path))
-                    {
-                        has_per_face_color = true;
-                    }
+                case 'g':
+                {
+                    has_groups = true;
+                    fresh_label++;
+                    break;
                 }
-                break;
             }
+            e.color = curr_color;
+            e.label = fresh_label;
+        }
+    }
 
-            case 'g':
+    if(has_per_face_color) poly_col.resize(poly_pos.size());
+    if(has_groups)         poly_lab.resize(chunks.back().base_face + chunks.back().n_faces);
+    if(has_per_face_color || has_groups)
+    {
+        PARALLEL_FOR(0, n_chunks, 2, [&](const uint i)
+        {
+            const OBJChunk & c = chunks[i];
+            uint  ev    = 0;
+            Color color = c.start_color;
+            int   label = c.start_label;
+            uint  j     = 0; // polygons with references to pos
+            for(uint fid=0; fid<c.n_faces; ++fid)
             {
-                has_groups = true;
-                fresh_label++;
-                break;
+                for(; ev<c.events.size() && c.events[ev].face<=fid; ++ev)
+                {
+                    color = c.events[ev].color;
+                    label = c.events[ev].label;
+                }
+                if(has_groups) poly_lab[c.base_face + fid] = label;
+                if(has_per_face_color && j<c.pos_face.size() && c.pos_face[j]==fid)
+                {
+                    poly_col[pos_base[i] + j++] = color;
+                }
             }
-        }
+        });
     }
-    f.close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    if(!has_per_face_color) poly_col.clear();
-    if(!has_groups)         poly_lab.clear();
+CINO_INLINE
+void read_OBJ(const char                     * filename,
+              std::vector<vec3d>             & pos,           // vertex xyz positions
+              std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
+              std::vector<vec3d>             & nor,           // vertex normals
+              std::vector<std::vector<uint>> & poly_pos,      // polygons with references to pos
+              std::vector<std::vector<uint>> & poly_tex,      // polygons with references to tex
+              std::vector<std::vector<uint>> & poly_nor,      // polygons with references to nor
+              std::vector<Color>             & poly_col,      // per polygon colors
+              std::vector<int>               & poly_lab,      // per polygon labels (cluster by OBJ groups "g")
+              std::string                    & diffuse_path,  // path of the image encoding the diffuse  texture component
+              std::string                    & specular_path, // path of the image encoding the specular texture component
+              std::string                    & normal_path)   // path of the image encoding the normal   texture component
+{
+    CSRIndices csr_pos, csr_tex, csr_nor;
+    read_OBJ(filename, pos, tex, nor, csr_pos, csr_tex, csr_nor, poly_col, poly_lab, diffuse_path, specular_path, normal_path);
+    poly_pos = OBJ_to_nested(csr_pos);
+    poly_tex = OBJ_to_nested(csr_tex);
+    poly_nor = OBJ_to_nested(csr_nor);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -43,10 +43,37 @@
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
 #include <cinolib/color.h>
+#include <cinolib/csr_indices.h>
 
 namespace cinolib
 {
 
+/* The file is memory mapped and split into chunks of whole lines, which are
+ * parsed in parallel with hand written number parsers. Polygons are returned
+ * in compressed form (see csr_indices.h), which avoids one heap allocation per
+ * polygon. All the other overloads are wrappers around this one.
+*/
+CINO_INLINE
+void read_OBJ(const char                     * filename,
+              std::vector<vec3d>             & pos,           // vertex xyz positions
+              std::vector<vec3d>             & tex,           // vertex uv(w) texture coordinates
+              std::vector<vec3d>             & nor,           // vertex normals
+              CSRIndices                     & poly_pos,      // polygons with references to pos
+              CSRIndices                     & poly_tex,      // polygons with references to tex
+              CSRIndices                     & poly_nor,      // polygons with references to nor
+              std::vector<Color>             & poly_col,      // per polygon colors
+              std::vector<int>               & poly_labels,   // per polygon labels (cluster by OBJ groups "g")
+              std::string                    & diffuse_path,  // path of the image encoding the diffuse  texture component
+              std::string                    & specular_path, // path of the image encoding the specular texture component
+              std::string                    & normal_path);  // path of the image encoding the normal   texture component
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_OBJ(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              CSRIndices                     & poly);
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
@@ -43,7 +43,11 @@
 *********************************************************************************/
 #include <cinolib/io/read_STL.h>
 #include <cinolib/io/io_utilities.h>
-#include <map>
+#include <cinolib/io/mapped_file.h>
+#include <cinolib/weld_points.h>
+#include <cinolib/parallel_for.h>
+#include <cstring>
+#include <cstdint>
 
 namespace cinolib
 {
@@ -52,10 +56,66 @@ CINO_INLINE
 void read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<uint>  & tris,
-              const bool           merge_duplicated_verts)
+              const bool           merge_duplicated_verts,
+              const double         merge_eps)
 {
     std::vector<vec3d> normals;
-    read_STL(filename, verts, normals, tris, merge_duplicated_verts);
+    read_STL(filename, verts, normals, tris, merge_duplicated_verts, merge_eps);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// parses nt binary triangles (50 bytes each) in place, straight from the mapped file
+CINO_INLINE
+static void read_STL_binary(const MappedFile         & f,
+                            const uint                 nt,
+                                  std::vector<vec3d> & verts,
+                                  std::vector<vec3d> & normals,
+                                  std::vector<uint>  & tris,
+                            const bool                 merge_duplicated_verts,
+                            const double               merge_eps)
+{
+    const char *data = f.data() + 84; // skip header (80 bytes) and number of triangles (4 bytes)
+
+    // triangle record: normal (3 floats), verts (9 floats), attribute (unsigned short)
+    auto read_vec = [&](const size_t offset)
+    {
+        float v[3];
+        std::memcpy(v, data + offset, sizeof(v));
+        return vec3d(v[0], v[1], v[2]);
+    };
+    auto corner = [&](const uint i)
+    {
+        return read_vec(50*size_t(i/3) + 12*(1+i%3));
+    };
+
+    normals.resize(nt);
+    PARALLEL_FOR(0, nt, 10000, [&](const uint tid)
+    {
+        normals[tid] = read_vec(50*size_t(tid));
+    });
+
+    uint nc = 3*nt;
+    if(merge_duplicated_verts)
+    {
+        std::vector<uint> reps;
+        weld_points(nc, corner, tris, reps, merge_eps);
+        verts.resize(reps.size());
+        PARALLEL_FOR(0, uint(reps.size()), 10000, [&](const uint vid)
+        {
+            verts[vid] = corner(reps[vid]);
+        });
+    }
+    else
+    {
+        verts.resize(nc);
+        tris.resize(nc);
+        PARALLEL_FOR(0, nc, 10000, [&](const uint i)
+        {
+            verts[i] = corner(i);
+            tris[i]  = i;
+        });
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -65,7 +125,8 @@ void read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<vec3d> & normals,
               std::vector<uint>  & tris,
-              const bool           merge_duplicated_verts)
+              const bool           merge_duplicated_verts,
+              const double         merge_eps)
 {
     // https://en.wikipedia.org/wiki/STL_(file_format)
 
@@ -73,6 +134,31 @@ void read_STL(const char         * filename,
     normals.clear();
     tris.clear();
 
+    MappedFile f;
+    if(!f.open(filename))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    /* In Thingi10K binary files start with the header of ASCII files even if
+     * they shouldn't, hence the "solid" keyword does not tell binary and ASCII
+     * files apart. The size of binary files is fixed by the number of triangles
+     * though, so a file with the exact expected size is parsed as binary
+     * straight away. Otherwise I try to parse it as ASCII first, and if I fail
+     * then I know that it is binary anyway.
+    */
+    uint32_t nt = 0;
+    if(f.size() >= 84)
+    {
+        std::memcpy(&nt, f.data() + 80, sizeof(uint32_t));
+        if(f.size() == 84 + 50*size_t(nt))
+        {
+            read_STL_binary(f, nt, verts, normals, tris, merge_duplicated_verts, merge_eps);
+            return;
+        }
+    }
+
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     FILE *fp = fopen(filename, "r");
@@ -82,15 +168,8 @@ void read_STL(const char         * filename,
         exit(-1);
     }
 
-    std::map<vec3d,uint> vmap;
-
-    /* This is a horrible trick to cope with the fact that in Thingi10K
-     * binary files start with the header of ASCII files even if they shouldn't.
-     * As a result it becomes messy to figure out whether a file is binary or not.
-     * I assume it is, then I try to parse it as if it was ASCII first, and if I fail
-     * then I know that is indeed binary.
-    */
     bool is_binary = true;
+    std::vector<vec3d> soup; // triangle corners
 
     if(seek_keyword(fp, "solid")) // ASCII file
     {
@@ -114,24 +193,7 @@ void read_STL(const char         * filename,
                 if(!eat_double(fp, v.x()))      assert(false && "could not parse x coord");
                 if(!eat_double(fp, v.y()))      assert(false && "could not parse y coord");
                 if(!eat_double(fp, v.z()))      assert(false && "could not parse z coord");
-
-                if(merge_duplicated_verts)
-                {
-                    auto it = vmap.find(v);
-                    if(it == vmap.end())
-                    {
-                        uint fresh_id = uint(vmap.size());
-                        vmap[v] = fresh_id;
-                        verts.push_back(v);
-                        tris.push_back(fresh_id);
-                    }
-                    else tris.push_back(it->second);
-                }
-                else
-                {
-                    tris.push_back(uint(verts.size()));
-                    verts.push_back(v);
-                }
+                soup.push_back(v);
             }
             if(!seek_keyword(fp, "endloop"))  assert(false && "could not find keyword ENDLOOP");
             if(!seek_keyword(fp, "endfacet")) assert(false && "could not find keyword ENDFACET");
@@ -141,60 +203,25 @@ void read_STL(const char         * filename,
 
     if(is_binary)
     {
-        // open the file in binary mode
-        FILE *fp = fopen(filename, "rb");
-        if(!fp)
+        // truncated file: parse the triangles it actually contains
+        if(f.size() < 84 + 50*size_t(nt))
         {
-            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
-            exit(-1);
+            assert(false && "error reading STL binary triangles");
+            nt = (f.size() < 84) ? 0 : uint32_t((f.size()-84)/50);
         }
+        read_STL_binary(f, nt, verts, normals, tris, merge_duplicated_verts, merge_eps);
+        return;
+    }
 
-        // read header
-        char header[80];
-        if(fread(header, 1, 80, fp)!=80) assert(false && "error reading STL binary header");
-
-        // read triangles
-        unsigned int nt;
-        if(fread(&nt, sizeof(unsigned int), 1, fp)!=1) assert(false && "error reading number of triangles");
-        for(unsigned int i=0; i<nt; ++i)
-        {
-            // read normal
-            float nf[3];
-            if(fread(&nf, sizeof(float), 3, fp)!=3) assert(false && "error reading normal");
-            vec3d n(nf[0], nf[1], nf[2]);
-            normals.push_back(n);
-
-            // read verts
-            for(int j=0; j<3; ++j)
-            {
-                float vf[3];
-                if(fread(&vf, sizeof(float), 3, fp)!=3) assert(false && "error reading vertex");
-
-                vec3d v(vf[0], vf[1], vf[2]);                
-                if(merge_duplicated_verts)
-                {
-                    auto it = vmap.find(v);
-                    if(it == vmap.end())
-                    {
-                        uint fresh_id = uint(vmap.size());
-                        vmap[v] = fresh_id;
-                        verts.push_back(v);
-                        tris.push_back(fresh_id);
-                    }
-                    else tris.push_back(it->second);
-                }
-                else
-                {
-                    tris.push_back(uint(verts.size()));
-                    verts.push_back(v);
-                }
-            }
-
-            // read (and discard) attribute
-            unsigned short attribute;
-            if(fread(&attribute, sizeof(unsigned short), 1, fp)!=1) assert(false && "error reading attribute");
-        }
-        fclose(fp);
+    if(merge_duplicated_verts)
+    {
+        weld_points(soup, verts, tris, merge_eps);
+    }
+    else
+    {
+        verts.swap(soup);
+        tris.resize(verts.size());
+        for(uint i=0; i<tris.size(); ++i) tris[i] = i;
     }
 }
 
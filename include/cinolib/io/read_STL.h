@@ -46,7 +46,8 @@ CINO_INLINE
 void read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<uint>  & tris,
-              const bool           merge_duplicated_verts = true);
+              const bool           merge_duplicated_verts = true,
+              const double         merge_eps = 0.0); // merge verts closer than eps (see weld_points.h)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -55,7 +56,8 @@ void read_STL(const char         * filename,
               std::vector<vec3d> & verts,
               std::vector<vec3d> & normals,
               std::vector<uint>  & tris,
-              const bool           merge_duplicated_verts = true);
+              const bool           merge_duplicated_verts = true,
+              const double         merge_eps = 0.0); // merge verts closer than eps (see weld_points.h)
 }
 
 #ifndef  CINO_STATIC_LIB
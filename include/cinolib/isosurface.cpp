@@ -55,6 +55,32 @@ Isosurface<M,V,E,F,P>::Isosurface(const Tetmesh<M,V,E,F,P> & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<Isosurface<M,V,E,F,P>> isosurfaces(const Tetmesh<M,V,E,F,P> & m,
+                                               const std::vector<float>  & iso_values)
+{
+    std::vector<vec3d> verts, norms;
+    std::vector<uint>  tris, vert_offsets, tri_offsets;
+    std::vector<double> isovalues(iso_values.begin(), iso_values.end());
+    marching_tets(m, isovalues, verts, tris, norms, vert_offsets, tri_offsets);
+
+    // split the output into separate surfaces, with vertex ids local to each of them
+    std::vector<Isosurface<M,V,E,F,P>> res(iso_values.size());
+    for(uint i=0; i<iso_values.size(); ++i)
+    {
+        Isosurface<M,V,E,F,P> & iso = res.at(i);
+        iso.iso_value = iso_values.at(i);
+        iso.verts.assign(verts.begin() + vert_offsets.at(i),   verts.begin() + vert_offsets.at(i+1));
+        iso.norms.assign(norms.begin() + tri_offsets.at(i),    norms.begin() + tri_offsets.at(i+1));
+        iso.tris.assign (tris.begin()  + 3*tri_offsets.at(i),  tris.begin()  + 3*tri_offsets.at(i+1));
+        for(uint & vid : iso.tris) vid -= vert_offsets.at(i);
+    }
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 Trimesh<M,V,E,F> Isosurface<M,V,E,F,P>::export_as_trimesh() const
@@ -75,6 +75,13 @@ class Isosurface
         std::vector<vec3d> norms;
 };
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// extracts the isosurfaces of many isovalues at once, with a single sweep over the mesh
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<Isosurface<M,V,E,F,P>> isosurfaces(const Tetmesh<M,V,E,F,P> & m,
+                                               const std::vector<float>  & iso_values);
 
 }
 
@@ -35,6 +35,8 @@
 *********************************************************************************/
 #include <cinolib/laplacian.h>
 #include <cinolib/symbols.h>
+#include <cinolib/operator_cache.h>
+#include <cinolib/parallel_for.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -42,42 +44,107 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* Direct assembly of the compressed (CSC) storage of L. Since L is symmetric,
+ * column vid contains the same entries of row vid, that is, the neighbors of
+ * vid plus the diagonal term. The size of each column is therefore known in
+ * advance from the v2e adjacency, and columns can be filled independently.
+ * Edge weights are computed once per edge (instead of once per endpoint).
+*/
 template<class M, class V, class E, class P>
 CINO_INLINE
-std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<M,V,E,P> & m,
-                                                             const int mode,
-                                                             const int n) // diagonally replicate n times
+static std::vector<double> laplacian_weights(const AbstractMesh<M,V,E,P> & m, const int mode)
 {
-    std::vector<Entry> entries;
+    std::vector<double> w(m.num_edges(), 1.0);
+    if(mode!=UNIFORM)
+    {
+        PARALLEL_FOR(0, m.num_edges(), 1000, [&](const uint eid)
+        {
+            w[eid] = m.edge_weight(eid, mode);
+        });
+    }
+    return w;
+}
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+static Eigen::SparseMatrix<double> laplacian_assemble(const AbstractMesh<M,V,E,P> & m, const std::vector<double> & w)
+{
     uint nv = m.num_verts();
-    std::vector<uint> base(n);
-    for(int i=0; i<n; ++i) base[i] = nv*i;
 
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+    Eigen::SparseMatrix<double> L(nv,nv);
+    int *outer = L.outerIndexPtr();
+    outer[0] = 0;
+    for(uint vid=0; vid<nv; ++vid) outer[vid+1] = outer[vid] + int(m.adj_v2e(vid).size()) + 1;
+    L.resizeNonZeros(outer[nv]);
+    int    *inner = L.innerIndexPtr();
+    double *value = L.valuePtr();
+
+    std::vector<uint> null_rows(nv,0);
+    PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
     {
-        std::vector<std::pair<uint,double>> wgts;
-        m.vert_weights(vid, mode, wgts);
+        int    beg = outer[vid];
+        int    end = outer[vid+1];
+        int    k   = beg;
         double sum = 0.0;
-        for(auto item : wgts)
+        for(uint eid : m.adj_v2e(vid))
         {
-            for(int i=0; i<n; ++i)
-            {
-                entries.push_back(Entry(base[i] + vid, base[i] + item.first, item.second));
-            }
-            sum -= item.second;
+            inner[k] = int(m.vert_opposite_to(eid,vid));
+            value[k] = w[eid];
+            sum     -= w[eid];
+            ++k;
         }
         if(sum == 0.0)
         {
-            std::cerr << "WARNING: null row in the matrix! (disconnected vertex? I put 1 in the diagonal)" << std::endl;
+            null_rows[vid] = 1;
             sum = 1.0;
         }
-        for(int i=0; i<n; ++i)
+        inner[k] = int(vid);
+        value[k] = sum;
+        // insertion sort by row index (columns are short)
+        for(int i=beg+1; i<end; ++i)
         {
-            entries.push_back(Entry(base[i] + vid, base[i] + vid, sum));
+            int    r = inner[i];
+            double v = value[i];
+            int    j = i;
+            for(; j>beg && inner[j-1]>r; --j)
+            {
+                inner[j] = inner[j-1];
+                value[j] = value[j-1];
+            }
+            inner[j] = r;
+            value[j] = v;
         }
+    });
+
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        if(null_rows[vid]) std::cerr << "WARNING: null row in the matrix! (disconnected vertex? I put 1 in the diagonal)" << std::endl;
     }
 
+    return L;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<M,V,E,P> & m,
+                                                             const int mode,
+                                                             const int n) // diagonally replicate n times
+{
+    Eigen::SparseMatrix<double> L = laplacian(m, mode, n);
+
+    std::vector<Entry> entries;
+    entries.reserve(L.nonZeros());
+    for(int col=0; col<L.outerSize(); ++col)
+    {
+        for(Eigen::SparseMatrix<double>::InnerIterator it(L,col); it; ++it)
+        {
+            entries.push_back(Entry(it.row(), it.col(), it.value()));
+        }
+    }
     return entries;
 }
 
@@ -87,13 +154,14 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m, const int mode, const int n)
 {
-    std::vector<Entry> entries = laplacian_matrix_entries(m, mode, n);
-
-    uint nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> L(nv,nv);
-    L.setFromTriplets(entries.begin(), entries.end());
+    if(mode!=COTANGENT) return replicate_diagonally(laplacian_assemble(m, laplacian_weights(m, mode)), n);
 
-    return L;
+    // cotangent weights are the costly part, and can be cached (see operator_cache.h)
+    OperatorCache::Coeffs w = m.operator_cache().get(&OperatorCache::Slots::cot_weights, [&]()
+    {
+        return laplacian_weights(m, mode);
+    });
+    return replicate_diagonally(laplacian_assemble(m, *w), n);
 }
 
 }
@@ -47,6 +47,11 @@ typedef Eigen::Triplet<double> Entry;
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* Matrices are assembled in parallel. If operator caching is enabled for m,
+ * cotangent weights are cached within the mesh, and asking again for the
+ * matrix on a mesh that was not edited only costs its assembly. See
+ * operator_cache.h
+*/
 template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m,
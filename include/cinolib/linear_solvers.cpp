@@ -35,6 +35,9 @@
 *********************************************************************************/
 #include <cinolib/linear_solvers.h>
 #include <cinolib/stl_container_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <chrono>
 
 namespace cinolib
 {
@@ -44,55 +47,298 @@ typedef Eigen::Triplet<double> Entry;
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void solve_square_system(const Eigen::SparseMatrix<double> & A,
-                         const Eigen::VectorXd             & b,
-                               Eigen::VectorXd             & x,
-                         int   solver)
+static double seconds_since(const std::chrono::steady_clock::time_point & t0)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::analyze(const Eigen::SparseMatrix<double> & A)
 {
     assert(A.rows() == A.cols());
+    auto t0 = std::chrono::steady_clock::now();
 
-    switch (solver)
+    // Eigen solvers need the matrix in compressed form
+    const Eigen::SparseMatrix<double> * Ac = &A;
+    Eigen::SparseMatrix<double> tmp;
+    if(!A.isCompressed())
     {
-        case SIMPLICIAL_LLT:
+        tmp = A;
+        tmp.makeCompressed();
+        Ac = &tmp;
+    }
+
+    bool ok = false;
+    switch(solver)
+    {
+        case SIMPLICIAL_LLT:  llt.analyzePattern(*Ac);  ok = (llt.info()  == Eigen::Success); break;
+        case SIMPLICIAL_LDLT: ldlt.analyzePattern(*Ac); ok = (ldlt.info() == Eigen::Success); break;
+        // for these solvers, info() is only meaningful after factorization
+        case SparseLU:        lu.analyzePattern(*Ac);   ok = true; break;
+        case BiCGSTAB:
         {
-            Eigen::SimplicialLLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            A_copy = *Ac;
+            bicgstab.analyzePattern(A_copy);
+            ok = true;
             break;
         }
+        case CG_JACOBI: ok = true; break;
+        case CG_ICHOL:  ichol.analyzePattern(*Ac); ok = true; break;
+        default: assert(false && "Unknown Solver");
+    }
+
+    outer.assign(Ac->outerIndexPtr(), Ac->outerIndexPtr() + Ac->outerSize() + 1);
+    inner.assign(Ac->innerIndexPtr(), Ac->innerIndexPtr() + Ac->nonZeros());
+    analyzed   = ok;
+    factorized = false;
+
+    timings.analyze = seconds_since(t0);
+    ++timings.n_analyze;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::same_pattern(const Eigen::SparseMatrix<double> & A) const
+{
+    if(A.outerSize()+1 != (int)outer.size()) return false;
+    if(A.isCompressed())
+    {
+        return A.nonZeros() == (int)inner.size() &&
+               std::equal(outer.begin(), outer.end(), A.outerIndexPtr()) &&
+               std::equal(inner.begin(), inner.end(), A.innerIndexPtr());
+    }
+    // uncompressed matrix: compare column by column
+    for(int j=0; j<A.outerSize(); ++j)
+    {
+        int beg = A.outerIndexPtr()[j];
+        int nnz = A.innerNonZeroPtr()[j];
+        if(nnz != outer[j+1]-outer[j]) return false;
+        if(!std::equal(A.innerIndexPtr()+beg, A.innerIndexPtr()+beg+nnz, inner.begin()+outer[j])) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::factorize(const Eigen::SparseMatrix<double> & A)
+{
+    if(!analyzed || !same_pattern(A))
+    {
+        if(!analyze(A)) return false;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
 
-        case SIMPLICIAL_LDLT:
+    const Eigen::SparseMatrix<double> * Ac = &A;
+    Eigen::SparseMatrix<double> tmp;
+    if(!A.isCompressed())
+    {
+        tmp = A;
+        tmp.makeCompressed();
+        Ac = &tmp;
+    }
+
+    bool ok = false;
+    switch(solver)
+    {
+        case SIMPLICIAL_LLT:  llt.factorize(*Ac);  ok = (llt.info()  == Eigen::Success); break;
+        case SIMPLICIAL_LDLT: ldlt.factorize(*Ac); ok = (ldlt.info() == Eigen::Success); break;
+        case SparseLU:        lu.factorize(*Ac);   ok = (lu.info()   == Eigen::Success); break;
+        case BiCGSTAB:
         {
-            Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            if(Ac!=&A_copy) A_copy = *Ac;
+            bicgstab.factorize(A_copy);
+            ok = (bicgstab.info() == Eigen::Success);
             break;
         }
+        case CG_JACOBI:
+        {
+            A_copy   = *Ac;
+            inv_diag = A_copy.diagonal();
+            for(int i=0; i<inv_diag.size(); ++i) inv_diag[i] = (inv_diag[i]>0) ? 1.0/inv_diag[i] : 1.0;
+            ok = true;
+            break;
+        }
+        case CG_ICHOL:
+        {
+            A_copy = *Ac;
+            ichol.factorize(A_copy);
+            ok = (ichol.info() == Eigen::Success);
+            break;
+        }
+        default: assert(false && "Unknown Solver");
+    }
+    factorized = ok;
+
+    timings.factorize = seconds_since(t0);
+    ++timings.n_factorize;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSolver::mul_CG(const Eigen::VectorXd & x, Eigen::VectorXd & y) const
+{
+    // A is symmetric, hence the i-th entry of A*x is the dot product between
+    // x and the i-th column of A. Columns are independent, and each thread
+    // writes only the entries of y corresponding to the columns it processes
+    const int    * col_beg = A_copy.outerIndexPtr();
+    const int    * row     = A_copy.innerIndexPtr();
+    const double * val     = A_copy.valuePtr();
+    y.resize(x.size());
+    PARALLEL_FOR(0, uint(A_copy.cols()), 10000, [&](const uint i)
+    {
+        double sum = 0;
+        for(int k=col_beg[i]; k<col_beg[i+1]; ++k) sum += val[k] * x[row[k]];
+        y[i] = sum;
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// preconditioned conjugate gradient, starting from the x given as input
+
+CINO_INLINE
+bool LinearSolver::solve_CG(const Eigen::VectorXd & b, Eigen::VectorXd & x)
+{
+    convergence = Convergence();
+
+    double b_norm = b.norm();
+    if(b_norm==0)
+    {
+        x.setZero(b.size());
+        convergence.converged = true;
+        return true;
+    }
+
+    uint max_iter = (max_iterations>0) ? max_iterations : uint(b.size());
+
+    Eigen::VectorXd r, z, p, Ap;
+    mul_CG(x, Ap);
+    r = b - Ap;
+
+    auto precondition = [&]()
+    {
+        if(solver==CG_JACOBI) z = inv_diag.cwiseProduct(r);
+        else                  z = ichol.solve(r);
+    };
+
+    precondition();
+    p = z;
+    double rz  = r.dot(z);
+    double res = r.norm() / b_norm;
+    uint   it  = 0;
+
+    while(res>tolerance && it<max_iter)
+    {
+        mul_CG(p, Ap);
+        double pAp = p.dot(Ap);
+        if(!(pAp>0)) break; // matrix is not positive definite (or NaNs)
+        double alpha = rz / pAp;
+        x += alpha * p;
+        r -= alpha * Ap;
+        res = r.norm() / b_norm;
+        convergence.history.push_back(res);
+        ++it;
+        if(res<=tolerance) break;
+        precondition();
+        double rz_new = r.dot(z);
+        p  = z + (rz_new/rz) * p;
+        rz = rz_new;
+    }
+
+    convergence.iterations = it;
+    convergence.residual   = res;
+    convergence.converged  = (res<=tolerance);
+    return convergence.converged;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Rhs, class Sol>
+CINO_INLINE
+bool LinearSolver::solve_impl(const Rhs & B, Sol & X)
+{
+    assert(factorized);
+    auto t0 = std::chrono::steady_clock::now();
+
+    // iterative solvers start from X if it is a valid guess, from zero otherwise
+    bool guess = warm_start && X.rows()==B.rows() && X.cols()==B.cols();
 
+    bool ok = false;
+    switch(solver)
+    {
+        case SIMPLICIAL_LLT:  X = llt.solve(B);  ok = (llt.info()  == Eigen::Success); break;
+        case SIMPLICIAL_LDLT: X = ldlt.solve(B); ok = (ldlt.info() == Eigen::Success); break;
+        case SparseLU:        X = lu.solve(B);   ok = (lu.info()   == Eigen::Success); break;
         case BiCGSTAB:
         {
-            Eigen::BiCGSTAB< Eigen::SparseMatrix<double> , Eigen::IncompleteLUT<double> > solver;
-            //solver.setMaxIterations(100);
-            solver.setTolerance(1e-5);
-            solver.compute(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
+            bicgstab.setTolerance(tolerance);
+            bicgstab.setMaxIterations((max_iterations>0) ? int(max_iterations) : -1); // -1 => Eigen default
+            if(guess) X = bicgstab.solveWithGuess(B,X).eval();
+            else      X = bicgstab.solve(B).eval();
+            ok = (bicgstab.info() == Eigen::Success);
+            convergence = Convergence();
+            convergence.iterations = uint(bicgstab.iterations());
+            convergence.residual   = bicgstab.error();
+            convergence.converged  = ok;
             break;
         }
-
-        case SparseLU:
+        case CG_JACOBI:
+        case CG_ICHOL:
         {
-            Eigen::SparseMatrix<double> Ac = A;
-            Ac.makeCompressed();
-            Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver;
-            solver.analyzePattern(Ac);
-            solver.factorize(Ac);
-            x = solver.solve(b);
+            if(!guess) X.setZero(B.rows(), B.cols());
+            ok = true;
+            for(int j=0; j<B.cols(); ++j)
+            {
+                Eigen::VectorXd x = X.col(j);
+                ok = solve_CG(B.col(j), x) && ok;
+                X.col(j) = x;
+            }
             break;
         }
-
         default: assert(false && "Unknown Solver");
     }
+
+    timings.solve = seconds_since(t0);
+    ++timings.n_solve;
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::solve(const Eigen::VectorXd & b, Eigen::VectorXd & x)
+{
+    return solve_impl(b,x);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSolver::solve(const Eigen::MatrixXd & B, Eigen::MatrixXd & X)
+{
+    return solve_impl(B,X);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void solve_square_system(const Eigen::SparseMatrix<double> & A,
+                         const Eigen::VectorXd             & b,
+                               Eigen::VectorXd             & x,
+                         int   solver)
+{
+    LinearSolver s(solver);
+    bool ok = s.compute(A);
+    assert(ok); (void)ok;
+    s.solve(b,x);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
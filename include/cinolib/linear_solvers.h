@@ -38,6 +38,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <Eigen/Sparse>
@@ -56,6 +57,9 @@ namespace cinolib
  * --------------------------------------------------------------
  * BiCGSTAB     none
  * (iterative)
+ * --------------------------------------------------------------
+ * CG_JACOBI    symmetric positive definite
+ * CG_ICHOL     (iterative, no fill-in: for systems too big to be factorized)
  */
 
 enum
@@ -64,16 +68,130 @@ enum
     SIMPLICIAL_LDLT,
     SparseLU,
     BiCGSTAB,
+    CG_JACOBI, // conjugate gradient, diagonal preconditioner
+    CG_ICHOL,  // conjugate gradient, incomplete Cholesky preconditioner
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-static const std::string txt[4] =
+static const std::string txt[6] =
 {
     "SIMPLICIAL_LLT"  ,
     "SIMPLICIAL_LDLT" ,
     "SparseLU",
     "BiCGSTAB",
+    "CG_JACOBI",
+    "CG_ICHOL",
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Reusable solver for square sparse systems, meant for applications that
+ * solve many times with the same matrix (e.g. one system per coordinate, or
+ * per time step) or with matrices that share the same sparsity pattern (e.g.
+ * iterative methods that update matrix values at each step). The three phases
+ * of a direct solve are exposed separately:
+ *
+ *  - analyze   : symbolic analysis (fill reducing ordering, elimination tree).
+ *                Depends only on the sparsity pattern of the matrix
+ *  - factorize : numeric factorization. If the pattern of the matrix is the
+ *                same of the last analyzed one, the analysis is reused,
+ *                otherwise it is recomputed on the fly
+ *  - solve     : forward/backward substitution, for one or more right hand
+ *                sides (columns of B) at once
+ *
+ * For iterative solvers, analyze/factorize refer to the preconditioner, and
+ * tolerance/max_iterations control the stopping criterion (relative residual
+ * |b-Ax|/|b|, max_iterations=0 means as many as the system size). By default
+ * iterations start from x=0. With warm_start, the x passed to solve is used as
+ * initial guess when it has the right size (e.g. the solution of a previous
+ * time step). Conjugate gradient (CG_*) runs its sparse matrix-vector products
+ * in parallel, and records the relative residual of each iteration in the
+ * convergence report of the last solved right hand side.
+ *
+ * All methods return false if the underlying solver reports failure (or, for
+ * iterative solvers, if it did not converge). The wall clock time spent in the
+ * last call of each phase is stored in timings, as well as how many times each
+ * phase was executed.
+*/
+
+class LinearSolver
+{
+    public:
+
+        explicit LinearSolver(const int solver = SIMPLICIAL_LLT) : solver(solver) {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool analyze  (const Eigen::SparseMatrix<double> & A);
+        bool factorize(const Eigen::SparseMatrix<double> & A);
+        bool compute  (const Eigen::SparseMatrix<double> & A) { return analyze(A) && factorize(A); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool solve(const Eigen::VectorXd & b, Eigen::VectorXd & x);
+        bool solve(const Eigen::MatrixXd & B, Eigen::MatrixXd & X); // one right hand side per column
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // iterative solvers only
+        double tolerance      = 1e-5;
+        uint   max_iterations = 0;
+        bool   warm_start     = false;
+
+        struct Convergence
+        {
+            uint                iterations = 0;
+            double              residual   = 0; // relative residual at exit
+            bool                converged  = false;
+            std::vector<double> history;        // relative residual at each iteration (CG only)
+        };
+        Convergence convergence;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool is_factorized() const { return factorized; }
+        int  type()          const { return solver;     }
+
+        struct Timings
+        {
+            double analyze     = 0; // seconds spent in the last call of each phase
+            double factorize   = 0;
+            double solve       = 0;
+            uint   n_analyze   = 0; // number of calls of each phase
+            uint   n_factorize = 0;
+            uint   n_solve     = 0;
+        };
+        Timings timings;
+
+    protected:
+
+        bool same_pattern(const Eigen::SparseMatrix<double> & A) const;
+        bool is_CG() const { return solver==CG_JACOBI || solver==CG_ICHOL; }
+        bool solve_CG(const Eigen::VectorXd & b, Eigen::VectorXd & x);
+        void mul_CG  (const Eigen::VectorXd & x, Eigen::VectorXd & y) const;
+        template<class Rhs, class Sol>
+        bool solve_impl(const Rhs & B, Sol & X);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        int  solver;
+        bool analyzed   = false;
+        bool factorized = false;
+
+        // sparsity pattern of the last analyzed matrix
+        std::vector<int> outer;
+        std::vector<int> inner;
+
+        // iterative solvers need the matrix, not just its factors
+        Eigen::SparseMatrix<double> A_copy;
+        Eigen::VectorXd             inv_diag; // CG_JACOBI preconditioner
+
+        Eigen::SimplicialLLT <Eigen::SparseMatrix<double>>                             llt;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>                             ldlt;
+        Eigen::SparseLU      <Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu;
+        Eigen::BiCGSTAB      <Eigen::SparseMatrix<double>, Eigen::IncompleteLUT<double>> bicgstab;
+        Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::AMDOrdering<int>>         ichol;
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -43,7 +43,10 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/marching_tets.h>
-#include <array>
+#include <cinolib/parallel_for.h>
+#include <cinolib/standard_elements_tables.h>
+#include <algorithm>
+#include <numeric>
 
 namespace cinolib
 {
@@ -72,25 +75,63 @@ enum // Look-up Table
 
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void make_triangle(const Tetmesh<M,V,E,F,P> & m,
-                   const double               isovalue,
-                   const uint                 vids[],
-                   const double               func[],
-                   const std::array<uint,3> & e,
-                   std::map<ipair,uint>     & e2v_map,
-                   std::vector<vec3d>       & verts,
-                   std::vector<uint>        & tris,
-                   std::vector<vec3d>       & norms);
+static void MT_func(const Tetmesh<M,V,E,F,P> & m, const uint pid, double func[])
+{
+    for(uint i=0; i<4; ++i) func[i] = m.vert_data(m.poly_vert_id(pid,i)).uvw[0];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static unsigned char MT_config(const double func[], const double isovalue, bool & swapped)
+{
+    unsigned char c = 0x0;
+    if (isovalue >= func[0]) c |= C_1000;
+    if (isovalue >= func[1]) c |= C_0100;
+    if (isovalue >= func[2]) c |= C_0010;
+    if (isovalue >= func[3]) c |= C_0001;
+
+    /* If the isosurface does not intersect the tet,
+     * one should get C_1111 using ">=", and C_0000
+     * inverting to "<=".
+     *
+     * This does not happen if the isosurface passes
+     * exhactly through one face. In this case one will
+     * get C_1111 using ">=", and something like
+     * C_0111 using "<=".
+     *
+     * Normally this does not create any trouble, as the
+     * face-adjacent tet will trigger the generation of
+     * that triangle. But if the tet is exposed on the
+     * surface, then that triangle will be missing in the
+     * final iso-surface.
+     *
+     * To avoid these missing triangles, whenever I get
+     * a C_1111 I invert the sign, and assign to the tet
+     * the configuration produced using "<="
+    */
+    swapped = false;
+    if (c == C_1111)
+    {
+        swapped = true;
+        c = 0x0;
+        if (isovalue <= func[0]) c |= C_1000;
+        if (isovalue <= func[1]) c |= C_0100;
+        if (isovalue <= func[2]) c |= C_0010;
+        if (isovalue <= func[3]) c |= C_0001;
+    }
+    return c;
+}
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// configuration of tet pid, after removal of duplicated and collapsed triangles
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void marching_tets(const Tetmesh<M,V,E,F,P> & m,
-                   const double               isovalue,
-                   std::vector<vec3d>       & verts,
-                   std::vector<uint>        & tris,
-                   std::vector<vec3d>       & norms)
+static unsigned char MT_config(const Tetmesh<M,V,E,F,P> & m,
+                               const uint                 pid,
+                               const double               isovalue,
+                               bool                     & swapped)
 {
     /* FIXME: for all configurations where two verts >= isoval
      * and the other two are < isoval, this method will try to
@@ -103,219 +144,277 @@ void marching_tets(const Tetmesh<M,V,E,F,P> & m,
      * vertex (<,>,=). In this case each configuration will be 100% correct
     */
 
-    std::vector<unsigned char> c(m.num_polys(),0x0);
-    std::vector<bool> swapped(m.num_polys(), false);
+    double func[4];
+    MT_func(m, pid, func);
+    unsigned char c = MT_config(func, isovalue, swapped);
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
+    bool v_on_iso[] =
     {
-        double func[] =
-        {
-            m.vert_data(m.poly_vert_id(pid,0)).uvw[0],
-            m.vert_data(m.poly_vert_id(pid,1)).uvw[0],
-            m.vert_data(m.poly_vert_id(pid,2)).uvw[0],
-            m.vert_data(m.poly_vert_id(pid,3)).uvw[0]
-        };
-
-        if (isovalue >= func[0]) c.at(pid) |= C_1000;
-        if (isovalue >= func[1]) c.at(pid) |= C_0100;
-        if (isovalue >= func[2]) c.at(pid) |= C_0010;
-        if (isovalue >= func[3]) c.at(pid) |= C_0001;
-
-        /* If the isosurface does not intersect the tet,
-         * one should get C_1111 using ">=", and C_0000
-         * inverting to "<=".
-         *
-         * This does not happen if the isosurface passes
-         * exhactly through one face. In this case one will
-         * get C_1111 using ">=", and something like
-         * C_0111 using "<=".
-         *
-         * Normally this does not create any trouble, as the
-         * face-adjacent tet will trigger the generation of
-         * that triangle. But if the tet is exposed on the
-         * surface, then that triangle will be missing in the
-         * final iso-surface.
-         *
-         * To avoid these missing triangles, whenever I get
-         * a C_1111 I invert the sign, and assign to the tet
-         * the configuration produced using "<="
-        */
-        if (c.at(pid) == C_1111)
-        {
-            swapped.at(pid) = true;
-            c.at(pid) = 0x0;
-            if (isovalue <= func[0]) c.at(pid) |= C_1000;
-            if (isovalue <= func[1]) c.at(pid) |= C_0100;
-            if (isovalue <= func[2]) c.at(pid) |= C_0010;
-            if (isovalue <= func[3]) c.at(pid) |= C_0001;
-        }
+        func[0] == isovalue,
+        func[1] == isovalue,
+        func[2] == isovalue,
+        func[3] == isovalue
+    };
+
+    // configuration of the tet adjacent through the i-th face (before the removal
+    // of duplicated triangles). Tets that do not exist are never C_1111
+    auto adj_config = [&](const uint i, int & adj_tet) -> unsigned char
+    {
+        adj_tet = m.poly_adj_through_face(pid, m.poly_face_id(pid,i));
+        if(adj_tet<0) return C_0000;
+        double adj_func[4];
+        bool   adj_swapped;
+        MT_func(m, adj_tet, adj_func);
+        return MT_config(adj_func, isovalue, adj_swapped);
+    };
+
+    // Avoid triangle duplication and collapsed triangle generation when the iso-surface
+    // passes EXACTLY through a vertex/edge/face shared between many tetrahedra.
+    //
+    int adj_tet; // not uint because it may be -1 if there is no adjacent tet!
+    switch (c)
+    {
+        // iso-surface passes on a face : make sure only one tet (MUST BE the one with higher id) triggers triangle generation...
+        // Notice that if the adjacent tet is collapsed (C_1111), then it make sense to use the current one regardless the tid order
+        case C_1110 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[2] && adj_config(0,adj_tet) != C_1111 && (int)pid < adj_tet) c = C_0000; break;
+        case C_1101 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[3] && adj_config(1,adj_tet) != C_1111 && (int)pid < adj_tet) c = C_0000; break;
+        case C_1011 : if (v_on_iso[0] && v_on_iso[2] && v_on_iso[3] && adj_config(2,adj_tet) != C_1111 && (int)pid < adj_tet) c = C_0000; break;
+        case C_0111 : if (v_on_iso[1] && v_on_iso[2] && v_on_iso[3] && adj_config(3,adj_tet) != C_1111 && (int)pid < adj_tet) c = C_0000; break;
+
+        // iso-surface passes on a edge : do nothing
+        case C_0101 : if (v_on_iso[1] && v_on_iso[3]) c = C_0000; break;
+        case C_1010 : if (v_on_iso[0] && v_on_iso[2]) c = C_0000; break;
+        case C_0011 : if (v_on_iso[2] && v_on_iso[3]) c = C_0000; break;
+        case C_1100 : if (v_on_iso[0] && v_on_iso[1]) c = C_0000; break;
+        case C_1001 : if (v_on_iso[0] && v_on_iso[3]) c = C_0000; break;
+        case C_0110 : if (v_on_iso[1] && v_on_iso[2]) c = C_0000; break;
+
+        // iso-surface passes on a vertex : do nothing
+        case C_1000 : if (v_on_iso[0]) c = C_0000; break;
+        case C_0100 : if (v_on_iso[1]) c = C_0000; break;
+        case C_0010 : if (v_on_iso[2]) c = C_0000; break;
+        case C_0001 : if (v_on_iso[3]) c = C_0000; break;
+
+        default : break;
     }
+    return c;
+}
 
-    std::map<ipair,uint> e2v_map;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
+// triangles generated by a configuration, as triplets of tet edges (see TET_EDGES).
+// Returns the number of triangles (at most two)
+CINO_INLINE
+static uint MT_triangles(const unsigned char c, const bool swapped, uint tris[2][3])
+{
+    auto set = [&](const uint i, const uint e0, const uint e1, const uint e2)
     {
-        uint vids[] =
-        {
-            m.poly_vert_id(pid,0),
-            m.poly_vert_id(pid,1),
-            m.poly_vert_id(pid,2),
-            m.poly_vert_id(pid,3)
-        };
-
-        double func[] =
-        {
-            m.vert_data(vids[0]).uvw[0],
-            m.vert_data(vids[1]).uvw[0],
-            m.vert_data(vids[2]).uvw[0],
-            m.vert_data(vids[3]).uvw[0]
-        };
-
-        bool v_on_iso[] =
-        {
-            func[0] == isovalue,
-            func[1] == isovalue,
-            func[2] == isovalue,
-            func[3] == isovalue
-        };
+        tris[i][0] = e0;
+        tris[i][1] = e1;
+        tris[i][2] = e2;
+    };
+    switch (c)
+    {
+        case C_1000 : set(0,2,0,4); return 1;
+        case C_0111 : swapped ? set(0,2,0,4) : set(0,0,2,4); return 1;
+        case C_1011 : swapped ? set(0,1,2,3) : set(0,2,1,3); return 1;
+        case C_0100 : set(0,1,2,3); return 1;
+        case C_1101 : swapped ? set(0,0,1,5) : set(0,1,0,5); return 1;
+        case C_0010 : set(0,0,1,5); return 1;
+        case C_0001 : set(0,5,3,4); return 1;
+        case C_1110 : swapped ? set(0,5,3,4) : set(0,3,5,4); return 1;
+        case C_0101 : set(0,5,2,4); set(1,2,5,1); return 2;
+        case C_1010 : set(0,2,5,4); set(1,5,2,1); return 2;
+        case C_0011 : set(0,3,4,1); set(1,1,4,0); return 2;
+        case C_1100 : set(0,4,3,1); set(1,4,1,0); return 2;
+        case C_1001 : set(0,3,2,0); set(1,5,3,0); return 2;
+        case C_0110 : set(0,2,3,0); set(1,3,5,0); return 2;
+        default : return 0;
+    }
+}
 
-        int adj_tet[] // not uint because it may be -1 if there is no adjacent tet!
-        {
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,0)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,1)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,2)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,3)),
-        };
-
-        // Avoid triangle duplication and collapsed triangle generation when the iso-surface
-        // passes EXACTLY through a vertex/edge/face shared between many tetrahedra.
-        //
-        switch (c.at(pid))
-        {
-            // iso-surface passes on a face : make sure only one tet (MUST BE the one with higher id) triggers triangle generation...
-            // Notice that if the adjacent tet is collapsed (C_1111), then it make sense to use the current one regardless the tid order
-            case C_1110 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[2] && (int)pid < adj_tet[0] && c.at(adj_tet[0]) != C_1111) c.at(pid) = C_0000; break;
-            case C_1101 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[3] && (int)pid < adj_tet[1] && c.at(adj_tet[1]) != C_1111) c.at(pid) = C_0000; break;
-            case C_1011 : if (v_on_iso[0] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet[2] && c.at(adj_tet[2]) != C_1111) c.at(pid) = C_0000; break;
-            case C_0111 : if (v_on_iso[1] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet[3] && c.at(adj_tet[3]) != C_1111) c.at(pid) = C_0000; break;
-
-            // iso-surface passes on a edge : do nothing
-            case C_0101 : if (v_on_iso[1] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_1010 : if (v_on_iso[0] && v_on_iso[2]) c.at(pid) = C_0000; break;
-            case C_0011 : if (v_on_iso[2] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_1100 : if (v_on_iso[0] && v_on_iso[1]) c.at(pid) = C_0000; break;
-            case C_1001 : if (v_on_iso[0] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_0110 : if (v_on_iso[1] && v_on_iso[2]) c.at(pid) = C_0000; break;
-
-            // iso-surface passes on a vertex : do nothing
-            case C_1000 : if (v_on_iso[0]) c.at(pid) = C_0000; break;
-            case C_0100 : if (v_on_iso[1]) c.at(pid) = C_0000; break;
-            case C_0010 : if (v_on_iso[2]) c.at(pid) = C_0000; break;
-            case C_0001 : if (v_on_iso[3]) c.at(pid) = C_0000; break;
-
-            default : break;
-        }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        // triangle generation
-        switch (c.at(pid))
-        {
-            case C_1000 : { make_triangle(m, isovalue, vids, func, {2,0,4}, e2v_map, verts, tris, norms); break; }
-            case C_0111 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {2,0,4}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {0,2,4}, e2v_map, verts, tris, norms); break; }
-            case C_1011 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {1,2,3}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {2,1,3}, e2v_map, verts, tris, norms); break; }
-            case C_0100 : { make_triangle(m, isovalue, vids, func, {1,2,3}, e2v_map, verts, tris, norms); break; }
-            case C_1101 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {0,1,5}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {1,0,5}, e2v_map, verts, tris, norms); break; }
-            case C_0010 : { make_triangle(m, isovalue, vids, func, {0,1,5}, e2v_map, verts, tris, norms); break; }
-            case C_0001 : { make_triangle(m, isovalue, vids, func, {5,3,4}, e2v_map, verts, tris, norms); break; }
-            case C_1110 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {5,3,4}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {3,5,4}, e2v_map, verts, tris, norms); break; }
-            case C_0101 : { make_triangle(m, isovalue, vids, func, {5,2,4}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {2,5,1}, e2v_map, verts, tris, norms); break; }
-            case C_1010 : { make_triangle(m, isovalue, vids, func, {2,5,4}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {5,2,1}, e2v_map, verts, tris, norms); break; }
-            case C_0011 : { make_triangle(m, isovalue, vids, func, {3,4,1}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {1,4,0}, e2v_map, verts, tris, norms); break; }
-            case C_1100 : { make_triangle(m, isovalue, vids, func, {4,3,1}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {4,1,0}, e2v_map, verts, tris, norms); break; }
-            case C_1001 : { make_triangle(m, isovalue, vids, func, {3,2,0}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {5,3,0}, e2v_map, verts, tris, norms); break; }
-            case C_0110 : { make_triangle(m, isovalue, vids, func, {2,3,0}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {3,5,0}, e2v_map, verts, tris, norms); break; }
-            default : break;
-        }
+// exclusive prefix sum. Returns the total
+CINO_INLINE
+static uint MT_prefix_sum(std::vector<uint> & v)
+{
+    uint sum = 0;
+    for(uint & x : v)
+    {
+        uint tmp = x;
+        x    = sum;
+        sum += tmp;
     }
+    return sum;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void make_triangle(const Tetmesh<M,V,E,F,P> & m,
+void marching_tets(const Tetmesh<M,V,E,F,P> & m,
                    const double               isovalue,
-                   const uint                 vids[],
-                   const double               func[],
-                   const std::array<uint,3> & e,
-                   std::map<ipair,uint>     & e2v_map,
                    std::vector<vec3d>       & verts,
                    std::vector<uint>        & tris,
                    std::vector<vec3d>       & norms)
 {
-    assert(isovalue >= *std::min_element(func, func+4));
-    assert(isovalue <= *std::max_element(func, func+4));
+    std::vector<uint> vert_offsets, tri_offsets;
+    marching_tets(m, std::vector<double>(1,isovalue), verts, tris, norms, vert_offsets, tri_offsets);
+}
 
-    vec3d tri_verts[3];
-    uint  fresh_vid = uint(verts.size());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=0; i<3; ++i)
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void marching_tets(const Tetmesh<M,V,E,F,P>  & m,
+                   const std::vector<double> & isovalues,
+                   std::vector<vec3d>        & verts,
+                   std::vector<uint>         & tris,
+                   std::vector<vec3d>        & norms,
+                   std::vector<uint>         & vert_offsets,
+                   std::vector<uint>         & tri_offsets)
+{
+    uint n_iso = isovalues.size();
+
+    // isovalues sorted by value, to locate the ones crossing each tet by binary search
+    std::vector<uint> order(n_iso);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const uint a, const uint b) { return isovalues[a] < isovalues[b]; });
+    std::vector<double> sorted(n_iso);
+    for(uint i=0; i<n_iso; ++i) sorted[i] = isovalues[order[i]];
+
+    // 1) single sweep over the mesh, listing the (isovalue,tet) pairs such that the
+    //    isovalue is within the range of the tet. Any other tet is either C_0000 or
+    //    C_1111 (swapped to C_0000), and does not produce any triangle
+    //
+    std::vector<uint> range_beg(m.num_polys());
+    std::vector<uint> range_cnt(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
     {
-        uint v_a = vids[TET_EDGES[e[i]][0]];
-        uint v_b = vids[TET_EDGES[e[i]][1]];
-
-        // avoid duplicated vertices. If an edge has already
-        // been visited retrieve its id and coordinates
-        //
-        ipair pair  = unique_pair(v_a, v_b);
-        auto  query = e2v_map.find(pair);
-
-        if (query != e2v_map.end())
+        double func[4];
+        MT_func(m, pid, func);
+        double lo = *std::min_element(func, func+4);
+        double hi = *std::max_element(func, func+4);
+        uint beg = std::lower_bound(sorted.begin(), sorted.end(), lo) - sorted.begin();
+        uint end = std::upper_bound(sorted.begin(), sorted.end(), hi) - sorted.begin();
+        range_beg[pid] = beg;
+        range_cnt[pid] = end - beg;
+    });
+
+    // group pairs by isovalue (counting sort: within each group, tets remain sorted by id)
+    std::vector<uint> iso_offsets(n_iso+1,0);
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        for(uint i=range_beg[pid]; i<range_beg[pid]+range_cnt[pid]; ++i) ++iso_offsets[i];
+    }
+    uint n_pairs = MT_prefix_sum(iso_offsets);
+    iso_offsets.back() = n_pairs;
+    std::vector<uint> iso_tets(n_pairs);
+    {
+        std::vector<uint> pos(iso_offsets.begin(), iso_offsets.end()-1);
+        for(uint pid=0; pid<m.num_polys(); ++pid)
         {
-            uint vid = query->second;
-            tri_verts[i] = vec3d(verts.at(vid));
-            tris.push_back(vid);
+            for(uint i=range_beg[pid]; i<range_beg[pid]+range_cnt[pid]; ++i) iso_tets[pos[i]++] = pid;
         }
-        else
+    }
+    range_beg.clear();
+    range_cnt.clear();
+
+    // 2) extract each isosurface from its tets, in two passes
+    //
+    std::vector<uint> rank(n_iso);
+    for(uint i=0; i<n_iso; ++i) rank[order[i]] = i;
+
+    vert_offsets.resize(n_iso+1);
+    tri_offsets.resize(n_iso+1);
+    vert_offsets[0] = verts.size();
+    tri_offsets[0]  = norms.size();
+
+    std::vector<unsigned char> config;
+    std::vector<char>          swapped;
+    std::vector<uint>          tet_tris;
+    std::vector<uint>          cut_edges;
+    std::vector<uint>          e2v(m.num_edges());
+
+    for(uint iso=0; iso<n_iso; ++iso)
+    {
+        double isovalue = isovalues[iso];
+        const uint * tets = iso_tets.data() + iso_offsets[rank[iso]];
+        uint n_tets = iso_offsets[rank[iso]+1] - iso_offsets[rank[iso]];
+
+        // count triangles...
+        config.resize(n_tets);
+        swapped.resize(n_tets);
+        tet_tris.resize(n_tets);
+        PARALLEL_FOR(0, n_tets, 1000, [&](const uint i)
         {
-            double f_a = func[TET_EDGES[e[i]][0]];
-            double f_b = func[TET_EDGES[e[i]][1]];
-
+            bool s;
+            uint tmp[2][3];
+            config[i]   = MT_config(m, tets[i], isovalue, s);
+            swapped[i]  = s;
+            tet_tris[i] = MT_triangles(config[i], s, tmp);
+        });
+        uint n_tris = MT_prefix_sum(tet_tris);
+
+        // ...and fill them, initially indexing the corners with the ids of the edges they cut
+        uint t_base = norms.size();
+        tris.resize(3*(t_base + n_tris));
+        norms.resize(t_base + n_tris);
+        PARALLEL_FOR(0, n_tets, 1000, [&](const uint i)
+        {
+            uint pid = tets[i];
+            uint tmp[2][3];
+            uint n = MT_triangles(config[i], swapped[i], tmp);
+            for(uint t=0; t<n; ++t)
+            {
+                for(uint j=0; j<3; ++j)
+                {
+                    uint v_a = m.poly_vert_id(pid, TET_EDGES[tmp[t][j]][0]);
+                    uint v_b = m.poly_vert_id(pid, TET_EDGES[tmp[t][j]][1]);
+                    tris[3*(t_base + tet_tris[i] + t) + j] = m.poly_edge_id(pid, v_a, v_b);
+                }
+            }
+        });
+
+        // one vertex for each cut edge, numbered by edge id
+        cut_edges.assign(tris.begin() + 3*t_base, tris.end());
+        std::sort(cut_edges.begin(), cut_edges.end());
+        cut_edges.erase(std::unique(cut_edges.begin(), cut_edges.end()), cut_edges.end());
+        uint v_base = verts.size();
+        verts.resize(v_base + cut_edges.size());
+        PARALLEL_FOR(0, cut_edges.size(), 1000, [&](const uint i)
+        {
+            uint   eid = cut_edges[i];
+            uint   v_a = m.edge_vert_id(eid,0);
+            uint   v_b = m.edge_vert_id(eid,1);
+            double f_a = m.vert_data(v_a).uvw[0];
+            double f_b = m.vert_data(v_b).uvw[0];
             if (f_a < f_b)
             {
                 std::swap(v_a, v_b);
                 std::swap(f_a, f_b);
             }
-
             double alpha = (isovalue - f_a) / (f_b - f_a);
+            verts[v_base + i] = (1.0 - alpha) * m.vert(v_a) + alpha * m.vert(v_b);
+            e2v[eid] = v_base + i;
+        });
 
-            tri_verts[i] = (1.0 - alpha) * m.vert(v_a) + alpha * m.vert(v_b);
-
-            verts.push_back(tri_verts[i]);
-
-            tris.push_back(fresh_vid);
-            e2v_map[pair] = fresh_vid++;
-        }
+        // replace edge ids with vertex ids, and compute normals
+        PARALLEL_FOR(0, n_tris, 1000, [&](const uint i)
+        {
+            uint * t = tris.data() + 3*(t_base + i);
+            for(uint j=0; j<3; ++j) t[j] = e2v[t[j]];
+            vec3d u = verts[t[1]] - verts[t[0]]; u.normalize();
+            vec3d w = verts[t[2]] - verts[t[0]]; w.normalize();
+            vec3d n = u.cross(w);
+            n.normalize();
+            norms[t_base + i] = n;
+        });
+
+        vert_offsets[iso+1] = verts.size();
+        tri_offsets[iso+1]  = norms.size();
     }
-
-    vec3d u  = tri_verts[1] - tri_verts[0]; u.normalize();
-    vec3d w  = tri_verts[2] - tri_verts[0]; w.normalize();
-    vec3d n = u.cross(w);
-    n.normalize();
-    norms.push_back(n);
 }
 
 }
@@ -37,15 +37,24 @@
 #define CINO_MARCHING_TETS_H
 
 #include <vector>
-#include <map>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
-#include <cinolib/ipair.h>
 #include <cinolib/meshes/tetmesh.h>
 
 namespace cinolib
 {
 
+/* Extracts the isosurface of the scalar field stored in the first texture
+ * coordinate of the vertices (uvw[0]). Outputs are appended to verts, tris
+ * (three vertex ids per triangle) and norms (one normal per triangle), hence
+ * preallocated (reserved) buffers can be reused across calls. Each triangle
+ * corner is indexed by the mesh edge it cuts, so vertices are shared between
+ * adjacent tets without any search structure. Tets are processed in parallel,
+ * in two passes: first each tet counts its triangles, then, after a prefix sum
+ * gives each tet its slot in the output, triangles are written. The result
+ * does not depend on the number of threads.
+*/
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void marching_tets(const Tetmesh<M,V,E,F,P> & m,
@@ -53,6 +62,23 @@ void marching_tets(const Tetmesh<M,V,E,F,P> & m,
                    std::vector<vec3d>       & verts,
                    std::vector<uint>        & tris,
                    std::vector<vec3d>       & norms);
+
+/* Extracts multiple isosurfaces with a single sweep over the mesh, which only
+ * visits the tets actually crossed by each isovalue. Surfaces are appended to
+ * the output buffers in the same order of isovalues. The i-th surface has
+ * vertices in [vert_offsets[i], vert_offsets[i+1]) and triangles (i.e. ranges
+ * of tris/3 and norms) in [tri_offsets[i], tri_offsets[i+1]).
+*/
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void marching_tets(const Tetmesh<M,V,E,F,P>  & m,
+                   const std::vector<double> & isovalues,
+                   std::vector<vec3d>        & verts,
+                   std::vector<uint>         & tris,
+                   std::vector<vec3d>        & norms,
+                   std::vector<uint>         & vert_offsets,
+                   std::vector<uint>         & tri_offsets);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -60,6 +60,10 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
     Eigen::SparseMatrix<double> L  = laplacian(m, COTANGENT);
     Eigen::SparseMatrix<double> MM = mass_matrix(m);
 
+    // the sparsity pattern of the system does not change across iterations,
+    // hence its symbolic analysis is done only once
+    LinearSolver LLT(SIMPLICIAL_LLT);
+
     for(uint i=1; i<=n_iters; ++i)
     {
         // optimize position and scale to get better numerical precision
@@ -67,29 +71,26 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
         m.center_bbox();        
 
         // backward euler time integration of heat flow equation
-        Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> LLT(MM - time_scalar * L);
+        LLT.factorize(MM - time_scalar * L);
 
         uint nv = m.num_verts();
-        Eigen::VectorXd x(nv);
-        Eigen::VectorXd y(nv);
-        Eigen::VectorXd z(nv);
+        Eigen::MatrixXd xyz(nv,3);
 
         for(uint vid=0; vid<nv; ++vid)
         {
             vec3d pos = m.vert(vid);
-            x[vid] = pos.x();
-            y[vid] = pos.y();
-            z[vid] = pos.z();
+            xyz(vid,0) = pos.x();
+            xyz(vid,1) = pos.y();
+            xyz(vid,2) = pos.z();
         }
 
-        x = LLT.solve(MM * x);
-        y = LLT.solve(MM * y);
-        z = LLT.solve(MM * z);
+        Eigen::MatrixXd rhs = MM * xyz;
+        LLT.solve(rhs, xyz);
 
         double residual = 0.0;
         for(uint vid=0; vid<m.num_verts(); ++vid)
         {
-            vec3d new_pos(x[vid], y[vid], z[vid]);
+            vec3d new_pos(xyz(vid,0), xyz(vid,1), xyz(vid,2));
             residual += (m.vert(vid) - new_pos).norm();
             m.vert(vid) = new_pos;
         }
@@ -38,6 +38,9 @@
 #include <cinolib/gl/draw_lines_tris.h>
 #include <cinolib/gl/load_texture.h>
 #include <cinolib/color.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/stl_container_utilities.h>
+#include <cstring>
 
 namespace cinolib
 {
@@ -76,8 +79,18 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::updateGL()
 {
-    updateGL_mesh();
-    updateGL_marked();
+    assert(!this->has_dead_elements() && "compact the mesh before rendering it");
+    bool pending = gl_dirty || !gl_dirty_verts.empty() || !gl_dirty_polys.empty();
+    if(pending && gl_buffers_in_sync())
+    {
+        gl_update_dirty();
+    }
+    else
+    {
+        updateGL_mesh();
+        updateGL_marked();
+    }
+    gl_clear_dirty();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -142,194 +155,439 @@ void AbstractDrawablePolygonMesh<Mesh>::updateGL_mesh()
             drawlist.tri_v_colors.push_back(this->vert_data(vid).color.b);
             drawlist.tri_v_colors.push_back(this->vert_data(vid).color.a);
         }
+        gl_poly_tris.clear();
+        gl_edge_segs.clear();
+        gl_poly_hidden.clear();
     }
-    else
+    else gl_rebuild(false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::mark_dirty_colors()
+{
+    gl_dirty |= DIRTY_COLORS;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::mark_dirty_visibility()
+{
+    gl_dirty |= DIRTY_VISIBILITY;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::mark_dirty_verts(const std::vector<uint> & vids)
+{
+    gl_dirty_verts.insert(gl_dirty_verts.end(), vids.begin(), vids.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::mark_dirty_polys(const std::vector<uint> & pids)
+{
+    gl_dirty_polys.insert(gl_dirty_polys.end(), pids.begin(), pids.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::gl_clear_dirty()
+{
+    gl_dirty = 0;
+    gl_dirty_verts.clear();
+    gl_dirty_polys.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Regenerates the portion of the render buffers affected by the changes recorded
+// since the last update. Assumes the buffers are in sync with the mesh
+//
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::gl_update_dirty()
+{
+    // polys hidden/unhidden are detected by comparing HIDDEN flags with the
+    // ones the buffers were generated for, hence they need no explicit mark
+    bool hidden_changed = gl_rebuild(true);
+
+    if(gl_dirty & DIRTY_COLORS)
     {
-        for(uint pid=0; pid<this->num_polys(); ++pid)
-        {
-            if (this->poly_data(pid).flags[HIDDEN]) continue;
+        PARALLEL_FOR(0, this->num_polys(), 1000, [&](uint pid){ gl_write_poly(pid, BUFFER_COLORS); });
+        PARALLEL_FOR(0, this->num_edges(), 1000, [&](uint eid){ gl_write_edge(eid, BUFFER_COLORS); });
+    }
+
+    // moving a vertex changes the geometry of all its incident elements
+    std::vector<uint> pids = gl_dirty_polys;
+    std::vector<uint> eids;
+    for(uint vid : gl_dirty_verts)
+    {
+        for(uint pid : this->adj_v2p(vid)) pids.push_back(pid);
+        for(uint eid : this->adj_v2e(vid)) eids.push_back(eid);
+    }
+    REMOVE_DUPLICATES_FROM_VEC(eids);
+    PARALLEL_FOR(0, uint(eids.size()), 1000, [&](uint i){ gl_write_edge(eids.at(i), BUFFER_COORDS); });
+
+    // smooth normals and AO are averaged over the polys incident to each vertex,
+    // hence all the polys sharing a vertex with the dirty ones must be updated
+    std::vector<uint> dirty;
+    for(uint pid : pids)
+    for(uint vid : this->adj_p2v(pid))
+    for(uint nbr : this->adj_v2p(vid))
+    {
+        dirty.push_back(nbr);
+    }
+    REMOVE_DUPLICATES_FROM_VEC(dirty);
+    PARALLEL_FOR(0, uint(dirty.size()), 1000, [&](uint i){ gl_write_poly(dirty.at(i), BUFFER_ALL); });
 
-            vec3d n = this->poly_data(pid).normal;
+    if(hidden_changed || (gl_dirty & DIRTY_VISIBILITY) || !gl_dirty_verts.empty()) updateGL_marked();
+}
 
-            for(uint i=0; i<this->poly_tessellation(pid).size()/3; ++i)
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+bool AbstractDrawablePolygonMesh<Mesh>::gl_buffers_in_sync() const
+{
+    const int attributes = DRAW_TRI_SMOOTH    | DRAW_TRI_FLAT      |
+                           DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY |
+                           DRAW_TRI_TEXTURE1D | DRAW_TRI_TEXTURE2D;
+
+    return this->num_polys() > 0                          &&
+           gl_poly_tris.size() == this->num_polys() + 1   &&
+           gl_edge_segs.size() == this->num_edges() + 1   &&
+           gl_attributes == (drawlist.draw_mode & attributes);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Computes the layout of the render buffers for the current HIDDEN flags and
+// fills them. If reuse_buffers is true the current buffers are assumed to be
+// in sync with the mesh, and only polys whose rendering depends on a poly that
+// was hidden/unhidden are regenerated. All other elements are copied as is.
+// Returns false if the buffers were reused and nothing had to be done
+//
+template<class Mesh>
+CINO_INLINE
+bool AbstractDrawablePolygonMesh<Mesh>::gl_rebuild(const bool reuse_buffers)
+{
+    uint np = this->num_polys();
+    uint ne = this->num_edges();
+
+    std::vector<char> hidden(np);
+    std::vector<uint> poly_tris(np+1, 0);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        hidden[pid]      = this->poly_data(pid).flags[HIDDEN];
+        poly_tris[pid+1] = poly_tris[pid] + (hidden[pid] ? 0 : uint(this->poly_tessellation(pid).size()/3));
+    }
+
+    // smooth normals and AO are averaged over the visible polys incident to each
+    // vertex, hence hiding/unhiding a poly affects all polys sharing a vertex with it
+    std::vector<char> dirty(np, !reuse_buffers);
+    if(reuse_buffers)
+    {
+        bool changed = false;
+        for(uint pid=0; pid<np; ++pid)
+        {
+            if(hidden[pid] != gl_poly_hidden.at(pid))
             {
-                uint vid0 = this->poly_tessellation(pid).at(3*i+0);
-                uint vid1 = this->poly_tessellation(pid).at(3*i+1);
-                uint vid2 = this->poly_tessellation(pid).at(3*i+2);
-
-                // average AO with adjacent visible faces having dihedral angle lower than 60 degrees
-                auto  vid0_vis_pids = this->vert_adj_visible_polys(vid0, n, 60.0);
-                auto  vid1_vis_pids = this->vert_adj_visible_polys(vid1, n, 60.0);
-                auto  vid2_vis_pids = this->vert_adj_visible_polys(vid2, n, 60.0);
-                float AO_vid0 = 0.f;
-                float AO_vid1 = 0.f;
-                float AO_vid2 = 0.f;
-                for(uint pid : vid0_vis_pids) AO_vid0 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                for(uint pid : vid1_vis_pids) AO_vid1 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                for(uint pid : vid2_vis_pids) AO_vid2 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                AO_vid0 /= static_cast<float>(vid0_vis_pids.size());
-                AO_vid1 /= static_cast<float>(vid1_vis_pids.size());
-                AO_vid2 /= static_cast<float>(vid2_vis_pids.size());
-
-                uint base_addr = uint(drawlist.tri_coords.size()/3);
-
-                drawlist.tris.push_back(base_addr    );
-                drawlist.tris.push_back(base_addr + 1);
-                drawlist.tris.push_back(base_addr + 2);
-
-                drawlist.tri_coords.push_back(float(this->vert(vid0).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid0).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid0).z()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).z()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).z()));
-
-                if (drawlist.draw_mode & DRAW_TRI_SMOOTH)
+                for(uint vid : this->adj_p2v(pid))
+                for(uint nbr : this->adj_v2p(vid))
                 {
-                    // average normals with adjacent visible faces having dihedral angle lower than 60 degrees
-                    vec3d n_vid0(0,0,0);
-                    vec3d n_vid1(0,0,0);
-                    vec3d n_vid2(0,0,0);
-                    for(uint pid : vid0_vis_pids) n_vid0 += this->poly_data(pid).normal;
-                    for(uint pid : vid1_vis_pids) n_vid1 += this->poly_data(pid).normal;
-                    for(uint pid : vid2_vis_pids) n_vid2 += this->poly_data(pid).normal;
-                    n_vid0 /= static_cast<double>(vid0_vis_pids.size());
-                    n_vid1 /= static_cast<double>(vid1_vis_pids.size());
-                    n_vid2 /= static_cast<double>(vid2_vis_pids.size());
-
-                    drawlist.tri_v_norms.push_back(float(n_vid0.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid0.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid0.z()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.z()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.z()));
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_FLAT)
-                {
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
+                    dirty[nbr] = true;
                 }
+                changed = true;
+            }
+            else if(poly_tris[pid+1] - poly_tris[pid] != gl_poly_tris.at(pid+1) - gl_poly_tris.at(pid))
+            {
+                dirty[pid] = true; // tessellation changed
+                changed    = true;
+            }
+        }
+        if(!changed) return false;
+    }
 
-                if (drawlist.draw_mode & DRAW_TRI_TEXTURE1D)
-                {
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[0]));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[0]));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[0]));
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_TEXTURE2D)
-                {
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[1]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[1]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[1]*drawlist.texture.scaling_factor));
-                }
+    std::vector<uint> edge_segs(ne+1, 0);
+    for(uint eid=0; eid<ne; ++eid)
+    {
+        bool visible = false;
+        for(uint pid : this->adj_e2p(eid))
+        {
+            if(!hidden[pid])
+            {
+                visible = true;
+                break;
+            }
+        }
+        edge_segs[eid+1] = edge_segs[eid] + (visible ? 1 : 0);
+    }
 
-                if (drawlist.draw_mode & DRAW_TRI_FACECOLOR) // replicate f color on each vertex
-                {
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_VERTCOLOR)
-                {
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.a);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.a);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.a);
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_QUALITY)
-                {
-                    float q = this->poly_data(pid).quality;
-                    Color c = Color::red_white_blue_ramp_01(q);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.a);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.a);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.a);
-                }
+    std::vector<uint>  old_poly_tris, old_edge_segs;
+    std::vector<float> old_coords, old_norms, old_text, old_colors, old_seg_coords, old_seg_colors;
+    old_poly_tris.swap(gl_poly_tris);
+    old_edge_segs.swap(gl_edge_segs);
+    old_coords.swap(drawlist.tri_coords);
+    old_norms.swap(drawlist.tri_v_norms);
+    old_text.swap(drawlist.tri_text);
+    old_colors.swap(drawlist.tri_v_colors);
+    old_seg_coords.swap(drawlist.seg_coords);
+    old_seg_colors.swap(drawlist.seg_colors);
+
+    const int mode     = drawlist.draw_mode;
+    const uint n_norms  = (mode & (DRAW_TRI_SMOOTH | DRAW_TRI_FLAT)) ? 9 : 0;
+    const uint n_text   = (mode & DRAW_TRI_TEXTURE1D) ? 3 : ((mode & DRAW_TRI_TEXTURE2D) ? 6 : 0);
+    const uint n_colors = (mode & (DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY)) ? 12 : 0;
+    const uint nt       = poly_tris.back();
+    const uint ns       = edge_segs.back();
+
+    gl_poly_tris.swap(poly_tris);
+    gl_edge_segs.swap(edge_segs);
+    gl_poly_hidden.swap(hidden);
+    gl_attributes = mode & (DRAW_TRI_SMOOTH    | DRAW_TRI_FLAT      |
+                            DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY |
+                            DRAW_TRI_TEXTURE1D | DRAW_TRI_TEXTURE2D);
+
+    drawlist.tris.resize(3*nt);
+    drawlist.tri_coords.resize(9*nt);
+    drawlist.tri_v_norms.resize(n_norms*nt);
+    drawlist.tri_text.resize(n_text*nt);
+    drawlist.tri_v_colors.resize(n_colors*nt);
+    drawlist.segs.resize(2*ns);
+    drawlist.seg_coords.resize(6*ns);
+    drawlist.seg_colors.resize(8*ns);
+
+    auto copy = [](const std::vector<float> & src, const uint src_beg, std::vector<float> & dst, const uint dst_beg, const uint n)
+    {
+        if(n>0) std::memcpy(dst.data()+dst_beg, src.data()+src_beg, n*sizeof(float));
+    };
+
+    PARALLEL_FOR(0, np, 1000, [&](uint pid)
+    {
+        uint beg = gl_poly_tris[pid];
+        uint end = gl_poly_tris[pid+1];
+        if(beg==end) return;
+        for(uint i=3*beg; i<3*end; ++i) drawlist.tris[i] = i;
+        if(dirty[pid])
+        {
+            gl_write_poly(pid, BUFFER_ALL);
+            return;
+        }
+        uint old = old_poly_tris[pid];
+        uint n   = end - beg;
+        copy(old_coords, 9*old,        drawlist.tri_coords,   9*beg,        9*n);
+        copy(old_norms,  n_norms*old,  drawlist.tri_v_norms,  n_norms*beg,  n_norms*n);
+        copy(old_text,   n_text*old,   drawlist.tri_text,     n_text*beg,   n_text*n);
+        copy(old_colors, n_colors*old, drawlist.tri_v_colors, n_colors*beg, n_colors*n);
+    });
+
+    PARALLEL_FOR(0, ne, 1000, [&](uint eid)
+    {
+        uint beg = gl_edge_segs[eid];
+        if(beg==gl_edge_segs[eid+1]) return;
+        drawlist.segs[2*beg  ] = 2*beg;
+        drawlist.segs[2*beg+1] = 2*beg+1;
+        if(reuse_buffers && old_edge_segs[eid]!=old_edge_segs[eid+1])
+        {
+            uint old = old_edge_segs[eid];
+            copy(old_seg_coords, 6*old, drawlist.seg_coords, 6*beg, 6);
+            copy(old_seg_colors, 8*old, drawlist.seg_colors, 8*beg, 8);
+        }
+        else gl_write_edge(eid, BUFFER_ALL);
+    });
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::gl_write_poly(const uint pid, const int what)
+{
+    uint t = gl_poly_tris.at(pid);
+    if(t == gl_poly_tris.at(pid+1)) return; // hidden
+
+    vec3d n = this->poly_data(pid).normal;
+    const std::vector<uint> & tess = this->poly_tessellation(pid);
+
+    for(uint i=0; i<tess.size()/3; ++i, ++t)
+    {
+        uint vid0 = tess.at(3*i+0);
+        uint vid1 = tess.at(3*i+1);
+        uint vid2 = tess.at(3*i+2);
+
+        if(what & BUFFER_COORDS)
+        {
+            float *c = &drawlist.tri_coords[9*t];
+            c[0] = float(this->vert(vid0).x());
+            c[1] = float(this->vert(vid0).y());
+            c[2] = float(this->vert(vid0).z());
+            c[3] = float(this->vert(vid1).x());
+            c[4] = float(this->vert(vid1).y());
+            c[5] = float(this->vert(vid1).z());
+            c[6] = float(this->vert(vid2).x());
+            c[7] = float(this->vert(vid2).y());
+            c[8] = float(this->vert(vid2).z());
+        }
+
+        if(what & BUFFER_TEXTURE)
+        {
+            if (drawlist.draw_mode & DRAW_TRI_TEXTURE1D)
+            {
+                float *tx = &drawlist.tri_text[3*t];
+                tx[0] = float(this->vert_data(vid0).uvw[0]);
+                tx[1] = float(this->vert_data(vid1).uvw[0]);
+                tx[2] = float(this->vert_data(vid2).uvw[0]);
+            }
+            else if (drawlist.draw_mode & DRAW_TRI_TEXTURE2D)
+            {
+                float *tx = &drawlist.tri_text[6*t];
+                tx[0] = float(this->vert_data(vid0).uvw[0]*drawlist.texture.scaling_factor);
+                tx[1] = float(this->vert_data(vid0).uvw[1]*drawlist.texture.scaling_factor);
+                tx[2] = float(this->vert_data(vid1).uvw[0]*drawlist.texture.scaling_factor);
+                tx[3] = float(this->vert_data(vid1).uvw[1]*drawlist.texture.scaling_factor);
+                tx[4] = float(this->vert_data(vid2).uvw[0]*drawlist.texture.scaling_factor);
+                tx[5] = float(this->vert_data(vid2).uvw[1]*drawlist.texture.scaling_factor);
             }
         }
 
-        for(uint eid=0; eid<this->num_edges(); ++eid)
+        if(!(what & (BUFFER_NORMALS | BUFFER_COLORS))) continue;
+
+        // average normals and AO with adjacent visible faces having dihedral angle lower than 60 degrees
+        auto vid0_vis_pids = this->vert_adj_visible_polys(vid0, n, 60.0);
+        auto vid1_vis_pids = this->vert_adj_visible_polys(vid1, n, 60.0);
+        auto vid2_vis_pids = this->vert_adj_visible_polys(vid2, n, 60.0);
+
+        if(what & BUFFER_NORMALS)
         {
-            bool hidden = true;
-            for(uint pid : this->adj_e2p(eid))
+            if (drawlist.draw_mode & DRAW_TRI_SMOOTH)
             {
-                if(!this->poly_data(pid).flags[HIDDEN])
+                vec3d n_vid0(0,0,0);
+                vec3d n_vid1(0,0,0);
+                vec3d n_vid2(0,0,0);
+                for(uint pid : vid0_vis_pids) n_vid0 += this->poly_data(pid).normal;
+                for(uint pid : vid1_vis_pids) n_vid1 += this->poly_data(pid).normal;
+                for(uint pid : vid2_vis_pids) n_vid2 += this->poly_data(pid).normal;
+                n_vid0 /= static_cast<double>(vid0_vis_pids.size());
+                n_vid1 /= static_cast<double>(vid1_vis_pids.size());
+                n_vid2 /= static_cast<double>(vid2_vis_pids.size());
+
+                float *nn = &drawlist.tri_v_norms[9*t];
+                nn[0] = float(n_vid0.x());
+                nn[1] = float(n_vid0.y());
+                nn[2] = float(n_vid0.z());
+                nn[3] = float(n_vid1.x());
+                nn[4] = float(n_vid1.y());
+                nn[5] = float(n_vid1.z());
+                nn[6] = float(n_vid2.x());
+                nn[7] = float(n_vid2.y());
+                nn[8] = float(n_vid2.z());
+            }
+            else if (drawlist.draw_mode & DRAW_TRI_FLAT)
+            {
+                float *nn = &drawlist.tri_v_norms[9*t];
+                for(uint j=0; j<3; ++j)
                 {
-                    hidden = false;
-                    break;
+                    nn[3*j+0] = float(n.x());
+                    nn[3*j+1] = float(n.y());
+                    nn[3*j+2] = float(n.z());
                 }
             }
-            if(hidden) continue;
+        }
 
-            uint base_addr = uint(drawlist.seg_coords.size()/3);
-            drawlist.segs.push_back(base_addr    );
-            drawlist.segs.push_back(base_addr + 1);
-
-            vec3d vid0 = this->edge_vert(eid,0);
-            vec3d vid1 = this->edge_vert(eid,1);
-
-            drawlist.seg_coords.push_back(float(vid0.x()));
-            drawlist.seg_coords.push_back(float(vid0.y()));
-            drawlist.seg_coords.push_back(float(vid0.z()));
-            drawlist.seg_coords.push_back(float(vid1.x()));
-            drawlist.seg_coords.push_back(float(vid1.y()));
-            drawlist.seg_coords.push_back(float(vid1.z()));
-
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.a);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.a);
+        if(what & BUFFER_COLORS)
+        {
+            float AO_vid0 = 0.f;
+            float AO_vid1 = 0.f;
+            float AO_vid2 = 0.f;
+            for(uint pid : vid0_vis_pids) AO_vid0 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
+            for(uint pid : vid1_vis_pids) AO_vid1 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
+            for(uint pid : vid2_vis_pids) AO_vid2 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
+            AO_vid0 /= static_cast<float>(vid0_vis_pids.size());
+            AO_vid1 /= static_cast<float>(vid1_vis_pids.size());
+            AO_vid2 /= static_cast<float>(vid2_vis_pids.size());
+
+            Color c0, c1, c2;
+            if (drawlist.draw_mode & DRAW_TRI_FACECOLOR) // replicate f color on each vertex
+            {
+                c0 = c1 = c2 = this->poly_data(pid).color;
+            }
+            else if (drawlist.draw_mode & DRAW_TRI_VERTCOLOR)
+            {
+                c0 = this->vert_data(vid0).color;
+                c1 = this->vert_data(vid1).color;
+                c2 = this->vert_data(vid2).color;
+            }
+            else if (drawlist.draw_mode & DRAW_TRI_QUALITY)
+            {
+                c0 = c1 = c2 = Color::red_white_blue_ramp_01(this->poly_data(pid).quality);
+            }
+            else continue;
+
+            float *cc = &drawlist.tri_v_colors[12*t];
+            cc[ 0] = c0.r*AO_vid0;
+            cc[ 1] = c0.g*AO_vid0;
+            cc[ 2] = c0.b*AO_vid0;
+            cc[ 3] = c0.a;
+            cc[ 4] = c1.r*AO_vid1;
+            cc[ 5] = c1.g*AO_vid1;
+            cc[ 6] = c1.b*AO_vid1;
+            cc[ 7] = c1.a;
+            cc[ 8] = c2.r*AO_vid2;
+            cc[ 9] = c2.g*AO_vid2;
+            cc[10] = c2.b*AO_vid2;
+            cc[11] = c2.a;
         }
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::gl_write_edge(const uint eid, const int what)
+{
+    uint s = gl_edge_segs.at(eid);
+    if(s == gl_edge_segs.at(eid+1)) return; // hidden
+
+    if(what & BUFFER_COORDS)
+    {
+        vec3d vid0 = this->edge_vert(eid,0);
+        vec3d vid1 = this->edge_vert(eid,1);
+
+        float *c = &drawlist.seg_coords[6*s];
+        c[0] = float(vid0.x());
+        c[1] = float(vid0.y());
+        c[2] = float(vid0.z());
+        c[3] = float(vid1.x());
+        c[4] = float(vid1.y());
+        c[5] = float(vid1.z());
+    }
+
+    if(what & BUFFER_COLORS)
+    {
+        const Color & col = this->edge_data(eid).color;
+        float *c = &drawlist.seg_colors[8*s];
+        c[0] = c[4] = col.r;
+        c[1] = c[5] = col.g;
+        c[2] = c[6] = col.b;
+        c[3] = c[7] = col.a;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_mesh(const bool b)
@@ -345,7 +603,7 @@ CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_AO_alpha(const float alpha)
 {
     AO_alpha = alpha;
-    updateGL();
+    updateGL_colors();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -486,7 +744,6 @@ CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_wireframe_color(const Color & c)
 {
     this->edge_set_color(c); // NOTE: this will change alpha for ANY adge (both interior and boundary)
-    updateGL();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -505,7 +762,6 @@ CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_wireframe_transparency(const float alpha)
 {
     this->edge_set_alpha(alpha); // NOTE: this will change alpha for ANY adge (both interior and boundary)
-    updateGL();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -49,6 +49,44 @@ namespace cinolib
 template<class Mesh>
 class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
 {
+    protected:
+
+        // layout of the render buffers in drawlist, used for incremental updates.
+        // The triangles of poly pid are [gl_poly_tris[pid], gl_poly_tris[pid+1]),
+        // and the segments of edge eid are [gl_edge_segs[eid], gl_edge_segs[eid+1]).
+        // Hidden elements span empty ranges
+        std::vector<uint> gl_poly_tris;
+        std::vector<uint> gl_edge_segs;
+        std::vector<char> gl_poly_hidden;    // HIDDEN flags the buffers were generated for
+        int               gl_attributes = 0; // draw mode bits that define the buffer content
+
+        // changes recorded since the last update, consumed by updateGL()
+        int               gl_dirty = 0;      // DIRTY_* bits
+        std::vector<uint> gl_dirty_verts;    // verts moved
+        std::vector<uint> gl_dirty_polys;    // polys whose attributes changed
+
+        enum
+        {
+            BUFFER_COORDS  = 0x1,
+            BUFFER_NORMALS = 0x2,
+            BUFFER_COLORS  = 0x4,
+            BUFFER_TEXTURE = 0x8,
+            BUFFER_ALL     = 0xF,
+        };
+
+        enum
+        {
+            DIRTY_COLORS     = 0x1, // colors/alpha of any element, or AO_alpha
+            DIRTY_VISIBILITY = 0x2, // HIDDEN flags of some polys
+        };
+
+        bool gl_buffers_in_sync() const;
+        bool gl_rebuild(const bool reuse_buffers);
+        void gl_write_poly(const uint pid, const int what);
+        void gl_write_edge(const uint eid, const int what);
+        void gl_update_dirty();
+        void gl_clear_dirty();
+
     public:
 
         Material   material_;
@@ -77,12 +115,12 @@ class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        void vert_set_color(const Color & c) { Mesh::vert_set_color(c); updateGL(); }
-        void edge_set_color(const Color & c) { Mesh::edge_set_color(c); updateGL(); }
-        void poly_set_color(const Color & c) { Mesh::poly_set_color(c); updateGL(); }
-        void vert_set_alpha(const float   a) { Mesh::vert_set_alpha(a); updateGL(); }
-        void edge_set_alpha(const float   a) { Mesh::edge_set_alpha(a); updateGL(); }
-        void poly_set_alpha(const float   a) { Mesh::poly_set_alpha(a); updateGL(); }
+        void vert_set_color(const Color & c) { Mesh::vert_set_color(c); mark_dirty_colors(); updateGL(); }
+        void edge_set_color(const Color & c) { Mesh::edge_set_color(c); mark_dirty_colors(); updateGL(); }
+        void poly_set_color(const Color & c) { Mesh::poly_set_color(c); mark_dirty_colors(); updateGL(); }
+        void vert_set_alpha(const float   a) { Mesh::vert_set_alpha(a); mark_dirty_colors(); updateGL(); }
+        void edge_set_alpha(const float   a) { Mesh::edge_set_alpha(a); mark_dirty_colors(); updateGL(); }
+        void poly_set_alpha(const float   a) { Mesh::poly_set_alpha(a); mark_dirty_colors(); updateGL(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -90,10 +128,29 @@ class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // If some changes were recorded with the mark_dirty_* methods below, and the
+        // draw mode and the number of elements did not change since the last update,
+        // updateGL() regenerates only the portion of the render buffers affected by
+        // them. Otherwise, it regenerates the buffers from scratch. Polys that were
+        // hidden or unhidden since the last update are always taken into account.
+        // Direct edits of element data (e.g. poly_data(pid).color) are not tracked:
+        // mark them, or call updateGL() with no pending marks to rebuild everything.
+        // The color/alpha setters above mark and update by themselves
         void updateGL();        // regenerates rendering data for both mesh and marked elements
         void updateGL_mesh();   // regenerates rendering data for mesh elements
         void updateGL_marked(); // regenerates rendering data for marked mesh elements
 
+        void mark_dirty_colors();                              // vert/edge/poly colors, alpha or AO_alpha changed
+        void mark_dirty_visibility();                          // polys hidden/unhidden (e.g. slicing)
+        void mark_dirty_verts(const std::vector<uint> & vids); // verts moved (normals must be already updated)
+        void mark_dirty_polys(const std::vector<uint> & pids); // poly attributes changed (color, normal, AO, quality)
+
+        // shortcuts to mark a single kind of change and update right away
+        void updateGL_colors()                              { mark_dirty_colors();      updateGL(); }
+        void updateGL_visibility()                          { mark_dirty_visibility();  updateGL(); }
+        void updateGL_verts(const std::vector<uint> & vids) { mark_dirty_verts(vids);   updateGL(); }
+        void updateGL_polys(const std::vector<uint> & pids) { mark_dirty_polys(pids);   updateGL(); }
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         const Material & material() const { return material_; }
@@ -37,6 +37,11 @@
 #include <cinolib/meshes/mesh_attributes.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/io/binary_mesh.h>
+#include <cinolib/how_many_seconds.h>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
@@ -108,6 +113,257 @@ void AbstractMesh<M,V,E,P>::clear()
     e2p.clear();
     p2e.clear();
     p2p.clear();
+    //
+    topology_frozen = false;
+    polys_csr.clear();
+    v2v_csr.clear();
+    v2e_csr.clear();
+    v2p_csr.clear();
+    e2p_csr.clear();
+    p2e_csr.clear();
+    p2p_csr.clear();
+    polys_nested.reset();
+    //
+    operator_cache_clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::topology_freeze()
+{
+    if(topology_frozen) return;
+
+    // compress one container at a time and release it right away,
+    // so that peak memory does not double on big meshes
+    auto freeze = [](std::vector<std::vector<uint>> & lists, CSRIndices & csr)
+    {
+        csr.assign(lists);
+        std::vector<std::vector<uint>>().swap(lists);
+    };
+    freeze(polys, polys_csr);
+    freeze(v2v,   v2v_csr);
+    freeze(v2e,   v2e_csr);
+    freeze(v2p,   v2p_csr);
+    freeze(e2p,   e2p_csr);
+    freeze(p2e,   p2e_csr);
+    freeze(p2p,   p2p_csr);
+    polys_nested.reset();
+    topology_frozen = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::topology_thaw()
+{
+    op_cache.clear();
+    if(!topology_frozen) return;
+
+    auto thaw = [](CSRIndices & csr, std::vector<std::vector<uint>> & lists)
+    {
+        lists = csr.to_nested();
+        csr.clear();
+    };
+    thaw(polys_csr, polys);
+    thaw(v2v_csr,   v2v);
+    thaw(v2e_csr,   v2e);
+    thaw(v2p_csr,   v2p);
+    thaw(e2p_csr,   e2p);
+    thaw(p2e_csr,   p2e);
+    thaw(p2p_csr,   p2p);
+    polys_nested.reset();
+    topology_frozen = false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const std::vector<std::vector<uint>> & AbstractMesh<M,V,E,P>::vector_polys() const
+{
+    if(topology_frozen) return polys_nested.get(polys_csr);
+    return polys;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<std::vector<uint>> & AbstractMesh<M,V,E,P>::vector_polys()
+{
+    topology_thaw();
+    return polys;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const std::vector<std::vector<uint>> & AbstractMesh<M,V,E,P>::vector_polys(std::vector<std::vector<uint>> & buf) const
+{
+    if(!topology_frozen) return polys;
+    buf = polys_csr.to_nested();
+    return buf;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::binary_write(BinaryMeshWriter & out) const
+{
+    auto lists = [&](const char * tag, const std::vector<std::vector<uint>> & nested, const CSRIndices & csr)
+    {
+        if(topology_frozen) out.add_lists(tag, csr);
+        else                out.add_lists(tag, nested);
+    };
+    out.add_array("verts", verts);
+    out.add_array("edges", edges);
+    lists("polys", polys, polys_csr);
+    lists("v2v",   v2v,   v2v_csr);
+    lists("v2e",   v2e,   v2e_csr);
+    lists("v2p",   v2p,   v2p_csr);
+    lists("e2p",   e2p,   e2p_csr);
+    lists("p2e",   p2e,   p2e_csr);
+    lists("p2p",   p2p,   p2p_csr);
+    out.add_attributes("v_data", v_data);
+    out.add_attributes("e_data", e_data);
+    out.add_attributes("p_data", p_data);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractMesh<M,V,E,P>::binary_read(const BinaryMeshReader & in, bool & has_attributes)
+{
+    topology_frozen = true;
+    if(!in.read_array("verts", verts)     ||
+       !in.read_array("edges", edges)     ||
+       !in.read_lists("polys", polys_csr) ||
+       !in.read_lists("v2v",   v2v_csr)   ||
+       !in.read_lists("v2e",   v2e_csr)   ||
+       !in.read_lists("v2p",   v2p_csr)   ||
+       !in.read_lists("e2p",   e2p_csr)   ||
+       !in.read_lists("p2e",   p2e_csr)   ||
+       !in.read_lists("p2p",   p2p_csr))
+    {
+        return false;
+    }
+
+    // ids are adopted as they are, hence they must be in range. Poly ids refer
+    // to verts or faces, depending on the mesh, and are checked by subclasses
+    uint nv = num_verts();
+    uint ne = num_edges();
+    uint np = num_polys();
+    if(edges.size()%2 != 0 ||
+       v2v_csr.size() != nv || v2e_csr.size() != nv || v2p_csr.size() != nv ||
+       e2p_csr.size() != ne || p2e_csr.size() != np || p2p_csr.size() != np)
+    {
+        return false;
+    }
+    for(uint vid : edges) if(vid >= nv) return false;
+    if(!v2v_csr.ids_below(nv) || !v2e_csr.ids_below(ne) || !v2p_csr.ids_below(np) ||
+       !e2p_csr.ids_below(np) || !p2e_csr.ids_below(ne) || !p2p_csr.ids_below(np))
+    {
+        return false;
+    }
+
+    has_attributes = true;
+    if(!in.read_attributes("v_data", v_data) || v_data.size() != nv) { v_data.assign(nv, V()); has_attributes = false; }
+    if(!in.read_attributes("e_data", e_data) || e_data.size() != ne) { e_data.assign(ne, E()); has_attributes = false; }
+    if(!in.read_attributes("p_data", p_data) || p_data.size() != np) { p_data.assign(np, P()); has_attributes = false; }
+
+    update_bbox();
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::save_binary(const char * filename) const
+{
+    BinaryMeshWriter out(mesh_type());
+    binary_write(out);
+    out.write(filename);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractMesh<M,V,E,P>::load_binary(const char * filename)
+{
+    return binary_load(filename, false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractMesh<M,V,E,P>::load_binary_frozen(const char * filename)
+{
+    return binary_load(filename, true);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractMesh<M,V,E,P>::binary_load(const char * filename, const bool keep_frozen)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+    clear();
+    mesh_data().filename = std::string(filename);
+
+    BinaryMeshReader in;
+    if(!in.open(filename))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : " << filename << " is not a valid binary mesh" << std::endl;
+        return false;
+    }
+
+    // generic polygon/polyhedral meshes can also host their specialized types
+    MeshType type = in.mesh_type();
+    bool same_family = (type <= POLYGONMESH) == (mesh_type() <= POLYGONMESH);
+    if(type != mesh_type() && !(same_family && (mesh_type()==POLYGONMESH || mesh_type()==POLYHEDRALMESH)))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : " << filename << " contains a different type of mesh" << std::endl;
+        return false;
+    }
+
+    bool has_attributes = false;
+    if(!binary_read(in, has_attributes))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : " << filename << " is corrupted" << std::endl;
+        std::string fname = mesh_data().filename;
+        clear();
+        mesh_data().filename = fname;
+        return false;
+    }
+
+    if(!has_attributes)
+    {
+        if(mesh_data().update_normals) update_normals();
+        copy_xyz_to_uvw(UVW_param);
+    }
+
+    if(!keep_frozen) topology_thaw();
+
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    std::cout << "load mesh\t"   <<
+                 num_verts()     << "V / " <<
+                 num_edges()     << "E / " <<
+                 num_polys()     << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -128,6 +384,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::translate(const vec3d & delta)
 {
+    op_cache.clear();
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) += delta;
     bb.min += delta;
     bb.max += delta;
@@ -139,6 +396,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::rotate(const vec3d & axis, const double angle)
 {
+    op_cache.clear();
     vec3d  c = centroid();
     mat3d R = mat3d::ROT_3D(axis, angle);
 
@@ -159,6 +417,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::scale(const double scale_factor)
 {
+    op_cache.clear();
     vec3d c = centroid();
     translate(-c);
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) *= scale_factor;
@@ -174,6 +433,7 @@ void AbstractMesh<M,V,E,P>::scale(const double sx,
                                   const double sy,
                                   const double sz)
 {
+    op_cache.clear();
     vec3d c = centroid();
     translate(-c);
     for(uint vid=0; vid<num_verts(); ++vid)
@@ -192,6 +452,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::transform(const mat3d & T)
 {
+    op_cache.clear();
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) = T*vert(vid);
     if(m_data.update_bbox)    update_bbox();
     if(m_data.update_normals) update_normals();
@@ -203,6 +464,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::transform(const mat4d & T)
 {
+    op_cache.clear();
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) = (T*vert(vid).add_coord(1)).rem_coord();
     if(m_data.update_bbox)    update_bbox();
     if(m_data.update_normals) update_normals();
@@ -214,6 +476,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::normalize_bbox()
 {
+    op_cache.clear();
     double s = 1.0/bbox().diag();
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) *= s;
     if(m_data.update_bbox) update_bbox();
@@ -225,6 +488,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::update_bbox()
 {
+    op_cache.clear();
     bb.reset();
     bb.push(this->verts);
 }
@@ -447,6 +711,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::copy_uvw_to_xyz(const int mode)
 {
+    op_cache.clear();
     for(uint vid=0; vid<num_verts(); ++vid)
     {
         switch (mode)
@@ -475,6 +740,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::swap_xyz_uvw(const bool normals, const bool bbox)
 {
+    op_cache.clear();
     for(uint vid=0; vid<num_verts(); ++vid)
     {
         std::swap(vert(vid),vert_data(vid).uvw);
@@ -1195,6 +1461,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractMesh<M,V,E,P>::center_bbox()
 {
+    op_cache.clear();
     vec3d center = bb.center();
     for(uint vid=0; vid<num_verts(); ++vid) vert(vid) -= center;
     bb.min -= center;
@@ -45,6 +45,8 @@
 #include <cinolib/color.h>
 #include <cinolib/symbols.h>
 #include <cinolib/ipair.h>
+#include <cinolib/csr_indices.h>
+#include <cinolib/operator_cache.h>
 
 typedef enum
 {
@@ -61,6 +63,9 @@ MeshType;
 namespace cinolib
 {
 
+class  BinaryMeshWriter; // see io/binary_mesh.h
+class  BinaryMeshReader; // see io/binary_mesh.h
+
 template<class M, // mesh attributes
          class V, // vert attributes
          class E, // edge attributes
@@ -87,6 +92,32 @@ class AbstractMesh
         std::vector<std::vector<uint>> p2e; // poly to edge adjacency
         std::vector<std::vector<uint>> p2p; // poly to poly adjacency
 
+        // frozen topology: polys and adjacencies above are moved into compressed
+        // (CSR) storage, and the vectors of vectors are released (see topology_freeze)
+        bool       topology_frozen = false;
+        CSRIndices polys_csr;
+        CSRIndices v2v_csr;
+        CSRIndices v2e_csr;
+        CSRIndices v2p_csr;
+        CSRIndices e2p_csr;
+        CSRIndices p2e_csr;
+        CSRIndices p2p_csr;
+        CSRNestedCache polys_nested; // serves vector_polys() const on frozen meshes
+
+        // per element coefficients of the geometric operators (Laplacian, mass,
+        // gradient), kept only if operator caching is enabled (see operator_cache.h)
+        mutable OperatorCache op_cache;
+
+        // native binary format (.cino, see io/binary_mesh.h). Topology is stored
+        // and read in frozen (CSR) form, and all ids are range checked before being
+        // adopted. Meshes that override these methods must call the base version
+        // first. Attributes are restored only if they are trivially copyable and of
+        // the same type of the saved ones (has_attributes=false otherwise, and they
+        // are reset to their defaults)
+        virtual void binary_write(BinaryMeshWriter & out) const;
+        virtual bool binary_read (const BinaryMeshReader & in, bool & has_attributes);
+                bool binary_load (const char * filename, const bool keep_frozen);
+
     public:
 
         typedef M M_type;
@@ -112,9 +143,18 @@ class AbstractMesh
         virtual void load(const char * filename) = 0;
         virtual void save(const char * filename) const = 0;
 
+        // .cino files (also handled by load/save). By default meshes are loaded
+        // editable, as with any other format (i.e. thawed, see topology_freeze).
+        // Read-only workloads can opt in to load_binary_frozen, which adopts the
+        // stored CSR topology as is, skipping the expansion into nested containers.
+        // Topology editing on a mesh loaded this way requires topology_thaw first
+                void save_binary       (const char * filename) const;
+                bool load_binary       (const char * filename);
+                bool load_binary_frozen(const char * filename);
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                void update_bbox();
+        virtual void update_bbox();
         virtual void update_normals() = 0;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -137,13 +177,13 @@ class AbstractMesh
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         virtual uint verts_per_poly(const uint pid) const = 0;
-        virtual uint edges_per_poly(const uint pid) const { return uint(this->p2e.at(pid).size()); }
+        virtual uint edges_per_poly(const uint pid) const { return this->adj_p2e(pid).size(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         uint num_verts() const { return uint(verts.size());   }
         uint num_edges() const { return uint(edges.size()/2); }
-        uint num_polys() const { return uint(polys.size());   }
+        uint num_polys() const { return topology_frozen ? polys_csr.size() : uint(polys.size()); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -152,8 +192,9 @@ class AbstractMesh
               std::vector<vec3d>             & vector_verts()        { return verts; }
         const std::vector<uint>              & vector_edges()  const { return edges; }
               std::vector<uint>              & vector_edges()        { return edges; }
-        const std::vector<std::vector<uint>> & vector_polys()  const { return polys; }
-              std::vector<std::vector<uint>> & vector_polys()        { return polys; }
+        const std::vector<std::vector<uint>> & vector_polys()  const; // frozen meshes expand polys into a copy, kept until the next thaw/freeze
+              std::vector<std::vector<uint>> & vector_polys();        // thaws frozen meshes
+        const std::vector<std::vector<uint>> & vector_polys(std::vector<std::vector<uint>> & buf) const; // any mode (frozen polys are expanded into buf)
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -178,22 +219,46 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                const std::vector<uint> & adj_v2v(const uint vid) const { return v2v.at(vid); }
-                      std::vector<uint> & adj_v2v(const uint vid)       { return v2v.at(vid); }
-                const std::vector<uint> & adj_v2e(const uint vid) const { return v2e.at(vid); }
-                      std::vector<uint> & adj_v2e(const uint vid)       { return v2e.at(vid); }
-                const std::vector<uint> & adj_v2p(const uint vid) const { return v2p.at(vid); }
-                      std::vector<uint> & adj_v2p(const uint vid)       { return v2p.at(vid); }
-                      std::vector<uint>   adj_e2v(const uint eid) const;
-                      std::vector<uint>   adj_e2e(const uint eid) const;
-                const std::vector<uint> & adj_e2p(const uint eid) const { return e2p.at(eid); }
-                      std::vector<uint> & adj_e2p(const uint eid)       { return e2p.at(eid); }
-                const std::vector<uint> & adj_p2e(const uint pid) const { return p2e.at(pid); }
-                      std::vector<uint> & adj_p2e(const uint pid)       { return p2e.at(pid); }
-                const std::vector<uint> & adj_p2p(const uint pid) const { return p2p.at(pid); }
-                      std::vector<uint> & adj_p2p(const uint pid)       { return p2p.at(pid); }
-        virtual const std::vector<uint> & adj_p2v(const uint pid) const = 0;
-        virtual       std::vector<uint> & adj_p2v(const uint pid)       = 0;
+        // Static meshes can be frozen to store polys and adjacencies in compact
+        // CSR form (roughly half the memory, and better locality). The adj_*
+        // accessors work the same way in both modes. Editing operations need
+        // the editable representation, and thaw frozen meshes automatically.
+        // Since they all call topology_thaw before changing the topology, it
+        // also drops any cached operator coefficients (see operator_cache.h).
+        //
+        // BREAKING CHANGE: since frozen meshes have no nested vectors to refer to,
+        // adj_* return an IndexSpan (a read only view, convertible to std::vector<uint>)
+        // and their mutable overloads (e.g. std::vector<uint> & adj_v2v(vid)) have
+        // been removed: a non const overload would thaw the mesh at each query.
+        // Code that edited adjacency lists in place no longer compiles, and should
+        // use the editing operations instead (derived classes may access the
+        // containers directly). Code that stored the result of adj_* in a
+        // std::vector<uint> keeps working, as spans convert implicitly.
+        // vector_polys() const works in both modes, but on frozen meshes it
+        // expands polys into a copy on first call (see vector_polys)
+        virtual void topology_freeze();
+        virtual void topology_thaw();
+                bool topology_is_frozen() const { return topology_frozen; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // operator caching is off by default (see operator_cache.h). Disabling it frees the cached coefficients
+        void            operator_cache_enable(const bool b) { op_cache.enable(b); }
+        bool            operator_cache_is_enabled() const   { return op_cache.is_enabled(); }
+        void            operator_cache_clear()              { op_cache.clear(); }
+        OperatorCache & operator_cache() const              { return op_cache; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+                IndexSpan adj_v2v(const uint vid) const { return topology_frozen ? v2v_csr.at(vid) : IndexSpan(v2v.at(vid)); }
+                IndexSpan adj_v2e(const uint vid) const { return topology_frozen ? v2e_csr.at(vid) : IndexSpan(v2e.at(vid)); }
+                IndexSpan adj_v2p(const uint vid) const { return topology_frozen ? v2p_csr.at(vid) : IndexSpan(v2p.at(vid)); }
+        std::vector<uint> adj_e2v(const uint eid) const;
+        std::vector<uint> adj_e2e(const uint eid) const;
+                IndexSpan adj_e2p(const uint eid) const { return topology_frozen ? e2p_csr.at(eid) : IndexSpan(e2p.at(eid)); }
+                IndexSpan adj_p2e(const uint pid) const { return topology_frozen ? p2e_csr.at(pid) : IndexSpan(p2e.at(pid)); }
+                IndexSpan adj_p2p(const uint pid) const { return topology_frozen ? p2p_csr.at(pid) : IndexSpan(p2p.at(pid)); }
+        virtual IndexSpan adj_p2v(const uint pid) const = 0;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
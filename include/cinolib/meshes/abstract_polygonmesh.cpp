@@ -40,10 +40,15 @@
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/geometry/polygon_utils.h>
 #include <cinolib/vector_serialization.h>
+#include <cinolib/string_utilities.h>
+#include <cinolib/io/binary_mesh.h>
 #include <cinolib/how_many_seconds.h>
 #include <cinolib/deg_rad.h>
 #include <unordered_set>
 #include <cinolib/ANSI_color_codes.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cstdint>
 #include <queue>
 
 namespace cinolib
@@ -88,6 +93,12 @@ void AbstractPolygonMesh<M,V,E,P>::load(const char * filename)
         read_STL(filename, pos, tris);
         poly_pos = polys_from_serialized_vids(tris, 3);
     }
+    else if (get_file_extension(str).compare("cino") == 0 ||
+             get_file_extension(str).compare("CINO") == 0)
+    {
+        this->load_binary(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
@@ -102,7 +113,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 {
+    assert(!has_dead_elements() && "compact the mesh before saving it");
     std::vector<double> coords = serialized_xyz_from_vec3d(this->verts);
+    std::vector<std::vector<uint>> buf; // used only by frozen meshes
+    const std::vector<std::vector<uint>> & polys = this->vector_polys(buf);
 
     std::string str(filename);
     std::string filetype = str.substr(str.size()-3,3);
@@ -110,16 +124,16 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
     if (filetype.compare("off") == 0 ||
         filetype.compare("OFF") == 0)
     {
-        write_OFF(filename, coords, this->polys);
+        write_OFF(filename, coords, polys);
     }
     else if (filetype.compare("obj") == 0 ||
              filetype.compare("OBJ") == 0)
     {
         if(this->polys_are_colored())
         {
-            write_OBJ(filename, coords, this->polys, this->vector_poly_colors());
+            write_OBJ(filename, coords, polys, this->vector_poly_colors());
         }
-        else write_OBJ(filename, coords, this->polys);
+        else write_OBJ(filename, coords, polys);
     }
     else if (filetype.compare("stl") == 0 ||
              filetype.compare("STL") == 0)
@@ -133,7 +147,12 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
             normals.push_back(this->poly_data(pid).normal.z());
         }
 
-        write_STL(filename, serialized_xyz_from_vec3d(this->vector_verts()), this->polys, normals);
+        write_STL(filename, serialized_xyz_from_vec3d(this->vector_verts()), polys, normals);
+    }
+    else if (get_file_extension(str).compare("cino") == 0 ||
+             get_file_extension(str).compare("CINO") == 0)
+    {
+        this->save_binary(filename);
     }
     else
     {
@@ -143,12 +162,56 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::binary_write(BinaryMeshWriter & out) const
+{
+    AbstractMesh<M,V,E,P>::binary_write(out);
+    out.add_lists("poly_tris", poly_triangles);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractPolygonMesh<M,V,E,P>::binary_read(const BinaryMeshReader & in, bool & has_attributes)
+{
+    if(!AbstractMesh<M,V,E,P>::binary_read(in, has_attributes) ||
+       !this->polys_csr.ids_below(this->num_verts()))
+    {
+        return false;
+    }
+
+    // tessellations are not part of the frozen topology, and remain editable
+    CSRIndices tris;
+    if(in.read_lists("poly_tris", tris) && tris.size()==this->num_polys() && tris.ids_below(this->num_verts())) poly_triangles = tris.to_nested();
+    else update_p_tessellations();
+
+    if(!has_attributes)
+    {
+        for(uint eid=0; eid<this->num_edges(); ++eid)
+        {
+            this->edge_data(eid).flags[MARKED] = (this->edge_is_boundary(eid) || !this->edge_is_manifold(eid));
+        }
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::clear()
 {
     AbstractMesh<M,V,E,P>::clear();
     poly_triangles.clear();
+    deferred_delete = false;
+    v_dead.clear();
+    e_dead.clear();
+    p_dead.clear();
+    n_dead_verts = 0;
+    n_dead_edges = 0;
+    n_dead_polys = 0;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -180,7 +243,8 @@ void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & v
 
     // initialize mesh connectivity (and normals)
     for(auto v : verts) this->vert_add(v);
-    for(auto p : polys) this->poly_add(p);
+    if(this->num_polys()==0 && this->num_edges()==0) polys_add_bulk(polys);
+    else for(auto p : polys) this->poly_add(p);
 
     if(this->mesh_data().update_normals) this->update_v_normals();
 
@@ -289,6 +353,224 @@ void AbstractPolygonMesh<M,V,E,P>::init(      std::vector<vec3d>             & p
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::polys_add_bulk(const std::vector<std::vector<uint>> & plist)
+{
+    assert(this->num_edges()==0);
+    assert(this->num_polys()==0);
+
+    uint nv = this->num_verts();
+    uint np = uint(plist.size());
+
+    // sorted copy of each polygon, serialized in a single buffer
+    std::vector<uint> p_off(np+1,0);
+    for(uint i=0; i<np; ++i) p_off[i+1] = p_off[i] + uint(plist[i].size());
+    std::vector<uint> p_sorted(p_off.back());
+    PARALLEL_FOR(0, np, 10000, [&](const uint i)
+    {
+        std::copy(plist[i].begin(), plist[i].end(), p_sorted.begin()+p_off[i]);
+        std::sort(p_sorted.begin()+p_off[i], p_sorted.begin()+p_off[i+1]);
+    });
+
+    // bucket polygons by their smallest vertex (counting sort, stable w.r.t. input order)
+    std::vector<uint> b_off(nv+1,0);
+    std::vector<uint> b_items(np);
+    for(uint i=0; i<np; ++i)
+    {
+        assert(!plist[i].empty());
+        ++b_off[p_sorted[p_off[i]]+1];
+    }
+    for(uint vid=0; vid<nv; ++vid) b_off[vid+1] += b_off[vid];
+    {
+        std::vector<uint> pos(b_off.begin(), b_off.end()-1);
+        for(uint i=0; i<np; ++i) b_items[pos[p_sorted[p_off[i]]]++] = i;
+    }
+
+    // duplicated polygons share the same bucket. Sorting each bucket by sorted vertex list
+    // (ties broken by input order) makes them contiguous, and as in poly_add only the first
+    // one is kept. This stays O(k log k) even for huge buckets (e.g. fans around a cone apex)
+    auto same_poly = [&](const uint pj, const uint pk)
+    {
+        return p_off[pj+1]-p_off[pj]==p_off[pk+1]-p_off[pk] &&
+               std::equal(p_sorted.begin()+p_off[pj], p_sorted.begin()+p_off[pj+1], p_sorted.begin()+p_off[pk]);
+    };
+    std::vector<char> is_dup(np,false);
+    PARALLEL_FOR(0, nv, 10000, [&](const uint vid)
+    {
+        if(b_off[vid+1]-b_off[vid]<2) return;
+        std::sort(b_items.begin()+b_off[vid], b_items.begin()+b_off[vid+1], [&](const uint pj, const uint pk)
+        {
+            if(p_off[pj+1]-p_off[pj]!=p_off[pk+1]-p_off[pk]) return p_off[pj+1]-p_off[pj]<p_off[pk+1]-p_off[pk];
+            int cmp = 0;
+            for(uint i=0; i<p_off[pj+1]-p_off[pj] && cmp==0; ++i)
+            {
+                uint vj = p_sorted[p_off[pj]+i];
+                uint vk = p_sorted[p_off[pk]+i];
+                cmp = (vj<vk) ? -1 : (vj>vk) ? 1 : 0;
+            }
+            return (cmp!=0) ? cmp<0 : pj<pk;
+        });
+        for(uint j=b_off[vid]+1; j<b_off[vid+1]; ++j)
+        {
+            if(same_poly(b_items[j], b_items[j-1])) is_dup[b_items[j]] = true;
+        }
+    });
+
+    // create polygons
+    this->polys.reserve(np);
+    for(uint i=0; i<np; ++i)
+    {
+        if(is_dup[i])
+        {
+            std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
+            continue;
+        }
+#ifndef NDEBUG
+        for(uint vid : plist[i]) assert(vid < nv);
+#endif
+        this->polys.push_back(plist[i]);
+    }
+    np = this->num_polys();
+    this->p_data.resize(np);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+    this->poly_triangles.resize(np);
+
+    // enumerate half edges, and bucket them by their smallest vertex
+    std::vector<uint> h_off(np+1,0);
+    for(uint pid=0; pid<np; ++pid) h_off[pid+1] = h_off[pid] + this->verts_per_poly(pid);
+    uint nh = h_off.back();
+    std::vector<uint> h_v0(nh), h_v1(nh);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        const std::vector<uint> & p = this->polys[pid];
+        for(uint i=0; i<p.size(); ++i)
+        {
+            h_v0[h_off[pid]+i] = p[i];
+            h_v1[h_off[pid]+i] = p[(i+1)%p.size()];
+        }
+    }
+    std::fill(b_off.begin(), b_off.end(), 0);
+    for(uint h=0; h<nh; ++h) ++b_off[std::min(h_v0[h],h_v1[h])+1];
+    for(uint vid=0; vid<nv; ++vid) b_off[vid+1] += b_off[vid];
+    std::vector<uint64_t> h_keys(nh);
+    {
+        std::vector<uint> pos(b_off.begin(), b_off.end()-1);
+        for(uint h=0; h<nh; ++h)
+        {
+            uint lo = std::min(h_v0[h],h_v1[h]);
+            uint hi = std::max(h_v0[h],h_v1[h]);
+            h_keys[pos[lo]++] = (uint64_t(hi)<<32) | h;
+        }
+    }
+
+    // within each bucket, half edges with the same opposite vertex are the same edge.
+    // Each half edge is mapped to the first half edge (in input order) that spans its edge
+    std::vector<uint> h_first(nh);
+    PARALLEL_FOR(0, nv, 10000, [&](const uint vid)
+    {
+        auto beg = h_keys.begin()+b_off[vid];
+        auto end = h_keys.begin()+b_off[vid+1];
+        std::sort(beg, end);
+        uint first = 0;
+        for(auto it=beg; it!=end; ++it)
+        {
+            uint hi = uint(*it >> 32);
+            uint h  = uint(*it & 0xffffffff);
+            if(it==beg || hi!=uint(*(it-1) >> 32)) first = h;
+            h_first[h] = first;
+        }
+    });
+
+    // edges are numbered by first occurrence, like in a sequence of poly_add calls
+    std::vector<uint> h_eid(nh);
+    uint ne = 0;
+    for(uint h=0; h<nh; ++h)
+    {
+        h_eid[h] = (h_first[h]==h) ? ne++ : h_eid[h_first[h]];
+    }
+    this->edges.resize(2*ne);
+    this->e_data.resize(ne);
+    this->e2p.resize(ne);
+    for(uint h=0; h<nh; ++h)
+    {
+        if(h_first[h]!=h) continue;
+        this->edges[2*h_eid[h]  ] = h_v0[h];
+        this->edges[2*h_eid[h]+1] = h_v1[h];
+    }
+
+    // vert to vert/edge/poly adjacency (memory is reserved upfront to avoid reallocations)
+    std::vector<uint> v_deg(nv,0), v_star(nv,0);
+    for(uint eid=0; eid<ne; ++eid)
+    {
+        ++v_deg[this->edges[2*eid  ]];
+        ++v_deg[this->edges[2*eid+1]];
+    }
+    for(uint pid=0; pid<np; ++pid)
+    for(uint vid : this->polys[pid]) ++v_star[vid];
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        this->v2v[vid].reserve(v_deg [vid]);
+        this->v2e[vid].reserve(v_deg [vid]);
+        this->v2p[vid].reserve(v_star[vid]);
+    }
+    for(uint eid=0; eid<ne; ++eid)
+    {
+        uint vid0 = this->edges[2*eid  ];
+        uint vid1 = this->edges[2*eid+1];
+        this->v2v[vid1].push_back(vid0);
+        this->v2v[vid0].push_back(vid1);
+        this->v2e[vid0].push_back(eid);
+        this->v2e[vid1].push_back(eid);
+    }
+    for(uint pid=0; pid<np; ++pid)
+    for(uint vid : this->polys[pid]) this->v2p[vid].push_back(pid);
+
+    // edge to poly and poly to edge adjacency
+    std::vector<uint> e_star(ne,0);
+    for(uint h=0; h<nh; ++h) ++e_star[h_eid[h]];
+    for(uint eid=0; eid<ne; ++eid) this->e2p[eid].reserve(e_star[eid]);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        this->p2e[pid].reserve(h_off[pid+1]-h_off[pid]);
+        for(uint h=h_off[pid]; h<h_off[pid+1]; ++h)
+        {
+            this->e2p[h_eid[h]].push_back(pid);
+            this->p2e[pid].push_back(h_eid[h]);
+        }
+    }
+
+    // poly to poly adjacency. Lists are filled in the same order of poly_add, that is: first
+    // the neighbors already in the mesh (sorted by shared edge), then the ones added later
+    for(uint pid=0; pid<np; ++pid)
+    {
+        uint n_nbrs = 0;
+        for(uint eid : this->p2e[pid]) n_nbrs += e_star[eid]-1;
+        this->p2p[pid].reserve(n_nbrs);
+    }
+    for(uint pid=0; pid<np; ++pid)
+    {
+        for(uint eid : this->p2e[pid])
+        for(uint nbr : this->e2p[eid])
+        {
+            if(nbr>=pid) break; // e2p lists are sorted by pid
+            if(CONTAINS_VEC(this->p2p[pid],nbr)) continue;
+            this->p2p[nbr].push_back(pid);
+            this->p2p[pid].push_back(nbr);
+        }
+    }
+
+    // per polygon tessellation and normals
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        if(this->mesh_data().update_normals) this->update_p_normal(pid);
+        update_p_tessellation(pid);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
@@ -300,9 +582,9 @@ void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
     std::vector<vec3d> n;
     for(uint i=2; i<this->verts_per_poly(pid); ++i)
     {
-        uint vid0 = this->polys.at(pid).at( 0 );
-        uint vid1 = this->polys.at(pid).at(i-1);
-        uint vid2 = this->polys.at(pid).at( i );
+        uint vid0 = this->adj_p2v(pid).at( 0 );
+        uint vid1 = this->adj_p2v(pid).at(i-1);
+        uint vid2 = this->adj_p2v(pid).at( i );
 
         poly_triangles.at(pid).push_back(vid0);
         poly_triangles.at(pid).push_back(vid1);
@@ -374,6 +656,7 @@ void AbstractPolygonMesh<M,V,E,P>::update_p_normals()
 {
     for(uint pid=0; pid<this->num_polys(); ++pid)
     {
+        if(poly_is_dead(pid)) continue;
         update_p_normal(pid);
     }
 }
@@ -386,6 +669,7 @@ void AbstractPolygonMesh<M,V,E,P>::update_p_tessellations()
 {
     for(uint pid=0; pid<this->num_polys(); ++pid)
     {
+        if(poly_is_dead(pid)) continue;
         update_p_tessellation(pid);
     }
 }
@@ -398,29 +682,60 @@ void AbstractPolygonMesh<M,V,E,P>::update_v_normals()
 {
     for(uint vid=0; vid<this->num_verts(); ++vid)
     {
+        if(vert_is_dead(vid)) continue;
         update_v_normal(vid);
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::update_bbox()
+{
+    if(n_dead_verts==0)
+    {
+        AbstractMesh<M,V,E,P>::update_bbox();
+        return;
+    }
+    this->operator_cache_clear();
+    this->bb.reset();
+    for(uint vid=0; vid<this->num_verts(); ++vid)
+    {
+        if(!vert_is_dead(vid)) this->bb.push(this->vert(vid));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_normals()
 {
+    this->operator_cache_clear();
     this->update_p_normals();
     this->update_v_normals();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::topology_freeze()
+{
+    assert(!has_dead_elements() && "compact the mesh before freezing it");
+    AbstractMesh<M,V,E,P>::topology_freeze();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 int AbstractPolygonMesh<M,V,E,P>::Euler_characteristic() const
 {
-    uint nv = this->num_verts();
-    uint ne = this->num_edges();
-    uint np = this->num_polys();
+    uint nv = this->num_verts() - n_dead_verts;
+    uint ne = this->num_edges() - n_dead_edges;
+    uint np = this->num_polys() - n_dead_polys;
     return nv - ne + np;
 }
 
@@ -573,14 +888,15 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_order_one_ring(const uint vid)
 {
+    this->topology_thaw();
     std::vector<uint> v_link;
     std::vector<uint> f_star;
     std::vector<uint> e_star;
     std::vector<uint> e_link;
     this->vert_ordered_one_ring(vid,v_link,f_star,e_star,e_link);
-    this->adj_v2v(vid) = v_link;
-    this->adj_v2e(vid) = e_star;
-    this->adj_v2p(vid) = f_star;
+    this->v2v.at(vid) = v_link;
+    this->v2e.at(vid) = e_star;
+    this->v2p.at(vid) = f_star;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -899,6 +1215,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractPolygonMesh<M,V,E,P>::vert_add(const vec3d & pos)
 {
+    this->topology_thaw();
     uint vid = this->num_verts();
     //
     this->verts.push_back(pos);
@@ -925,6 +1242,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::vert_merge(const uint vid0, const uint vid1)
 {
+    this->topology_thaw();
     std::vector<uint> old_polys = this->adj_v2p(vid1);
     std::vector<std::vector<uint>> new_polys;
     for(uint pid : old_polys)
@@ -949,6 +1267,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_switch_id(const uint vid0, const uint vid1)
 {
+    this->topology_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (vid0 == vid1) return;
@@ -1011,6 +1330,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_remove(const uint vid)
 {
+    this->topology_thaw();
     polys_remove(this->adj_v2p(vid));
 }
 
@@ -1020,9 +1340,18 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_remove_unreferenced(const uint vid)
 {
+    this->topology_thaw();
     this->v2v.at(vid).clear();
     this->v2e.at(vid).clear();
     this->v2p.at(vid).clear();
+    if(deferred_delete)
+    {
+        if(v_dead.size()<this->num_verts()) v_dead.resize(this->num_verts(), false);
+        assert(!v_dead.at(vid));
+        v_dead.at(vid) = true;
+        ++n_dead_verts;
+        return;
+    }
     vert_switch_id(vid, this->num_verts()-1);
     this->verts.pop_back();
     this->v_data.pop_back();
@@ -1116,6 +1445,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractPolygonMesh<M,V,E,P>::edge_add(const uint vid0, const uint vid1)
 {
+    this->topology_thaw();
     assert(this->edge_id(vid0, vid1)==-1); // make sure it doesn't exist already
     assert(vid0 < this->num_verts());
     assert(vid1 < this->num_verts());
@@ -1148,6 +1478,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_switch_id(const uint eid0, const uint eid1)
 {
+    this->topology_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (eid0 == eid1) return;
@@ -1192,6 +1523,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_remove(const uint eid)
 {
+    this->topology_thaw();
     polys_remove(this->adj_e2p(eid));
 }
 
@@ -1201,7 +1533,16 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_remove_unreferenced(const uint eid)
 {
+    this->topology_thaw();
     this->e2p.at(eid).clear();
+    if(deferred_delete)
+    {
+        if(e_dead.size()<this->num_edges()) e_dead.resize(this->num_edges(), false);
+        assert(!e_dead.at(eid));
+        e_dead.at(eid) = true;
+        ++n_dead_edges;
+        return;
+    }
     edge_switch_id(eid, this->num_edges()-1);
     this->edges.resize(this->edges.size()-2);
     this->e_data.pop_back();
@@ -1419,6 +1760,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_switch_id(const uint pid0, const uint pid1)
 {
+    this->topology_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (pid0 == pid1) return;
@@ -1475,6 +1817,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractPolygonMesh<M,V,E,P>::poly_add(const std::vector<uint> & vlist)
 {
+    this->topology_thaw();
     if(poly_id(vlist)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
@@ -1541,6 +1884,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::polys_remove(const std::vector<uint> & pids)
 {
+    this->topology_thaw();
     // in order to avoid id conflicts remove all the
     // polys starting from the one with highest id
     //
@@ -1556,6 +1900,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_remove(const uint pid)
 {
+    this->topology_thaw();
     // [28 Aug 2017] Tested on progressive random removal until almost no polys are left: PASSED
 
     std::set<uint,std::greater<uint>> dangling_verts; // higher ids first
@@ -1608,9 +1953,19 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_remove_unreferenced(const uint pid)
 {
+    this->topology_thaw();
     this->polys.at(pid).clear();
     this->p2e.at(pid).clear();
     this->p2p.at(pid).clear();
+    if(deferred_delete)
+    {
+        if(p_dead.size()<this->num_polys()) p_dead.resize(this->num_polys(), false);
+        assert(!p_dead.at(pid));
+        p_dead.at(pid) = true;
+        ++n_dead_polys;
+        this->poly_triangles.at(pid).clear();
+        return;
+    }
     poly_switch_id(pid, this->num_polys()-1);
     this->polys.pop_back();
     this->p_data.pop_back();
@@ -1693,6 +2048,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_flip_winding_order(const uint pid)
 {
+    this->topology_thaw();
     std::reverse(this->polys.at(pid).begin(), this->polys.at(pid).end());
 
     if(this->mesh_data().update_normals)
@@ -1708,6 +2064,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P> & m)
 {
+    this->topology_thaw();
     uint nv = this->num_verts();
     uint ne = this->num_edges();
     uint np = this->num_polys();
@@ -1772,6 +2129,142 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::deferred_delete_begin()
+{
+    this->topology_thaw();
+    deferred_delete = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::deferred_delete_end()
+{
+    compact();
+    deferred_delete = false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::compact()
+{
+    std::vector<int> v_map, e_map, p_map;
+    compact(v_map, e_map, p_map);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// assigns consecutive ids to the n elements that are not flagged as dead
+// (-1 to the dead ones). Returns the number of alive elements
+CINO_INLINE
+static uint compact_ids(const std::vector<bool> & dead, const uint n, std::vector<int> & map)
+{
+    map.resize(n);
+    uint count = 0;
+    for(uint i=0; i<n; ++i)
+    {
+        map[i] = (i<dead.size() && dead[i]) ? -1 : int(count++);
+    }
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::compact(std::vector<int> & v_map,
+                                           std::vector<int> & e_map,
+                                           std::vector<int> & p_map)
+{
+    this->topology_thaw();
+
+    uint nv = compact_ids(v_dead, this->num_verts(), v_map);
+    uint ne = compact_ids(e_dead, this->num_edges(), e_map);
+    uint np = compact_ids(p_dead, this->num_polys(), p_map);
+
+    v_dead.clear();
+    e_dead.clear();
+    p_dead.clear();
+    n_dead_verts = 0;
+    n_dead_edges = 0;
+    n_dead_polys = 0;
+
+    if(nv==this->num_verts() && ne==this->num_edges() && np==this->num_polys()) return;
+
+    // move alive elements to their new slot. New ids are never bigger than
+    // the old ones, hence this can be done in place scanning ids upwards
+    for(uint vid=0; vid<this->num_verts(); ++vid)
+    {
+        if(v_map[vid]<0 || uint(v_map[vid])==vid) continue;
+        uint i = uint(v_map[vid]);
+        this->verts [i] = this->verts[vid];
+        this->v_data[i] = std::move(this->v_data[vid]);
+        this->v2v   [i] = std::move(this->v2v[vid]);
+        this->v2e   [i] = std::move(this->v2e[vid]);
+        this->v2p   [i] = std::move(this->v2p[vid]);
+    }
+    for(uint eid=0; eid<this->num_edges(); ++eid)
+    {
+        if(e_map[eid]<0 || uint(e_map[eid])==eid) continue;
+        uint i = uint(e_map[eid]);
+        this->edges[2*i  ] = this->edges[2*eid  ];
+        this->edges[2*i+1] = this->edges[2*eid+1];
+        this->e_data[i]    = std::move(this->e_data[eid]);
+        this->e2p   [i]    = std::move(this->e2p[eid]);
+    }
+    for(uint pid=0; pid<this->num_polys(); ++pid)
+    {
+        if(p_map[pid]<0 || uint(p_map[pid])==pid) continue;
+        uint i = uint(p_map[pid]);
+        this->polys         [i] = std::move(this->polys[pid]);
+        this->p_data        [i] = std::move(this->p_data[pid]);
+        this->p2e           [i] = std::move(this->p2e[pid]);
+        this->p2p           [i] = std::move(this->p2p[pid]);
+        this->poly_triangles[i] = std::move(this->poly_triangles[pid]);
+    }
+    this->verts.resize(nv);
+    this->v_data.resize(nv);
+    this->v2v.resize(nv);
+    this->v2e.resize(nv);
+    this->v2p.resize(nv);
+    this->edges.resize(2*ne);
+    this->e_data.resize(ne);
+    this->e2p.resize(ne);
+    this->polys.resize(np);
+    this->p_data.resize(np);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+    this->poly_triangles.resize(np);
+
+    // renumber references. Dead elements have no adjacency, so they are never referenced
+    PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
+    {
+        for(uint & nbr : this->v2v[vid]) nbr = uint(v_map[nbr]);
+        for(uint & eid : this->v2e[vid]) eid = uint(e_map[eid]);
+        for(uint & pid : this->v2p[vid]) pid = uint(p_map[pid]);
+    });
+    PARALLEL_FOR(0, ne, 1000, [&](const uint eid)
+    {
+        this->edges[2*eid  ] = uint(v_map[this->edges[2*eid  ]]);
+        this->edges[2*eid+1] = uint(v_map[this->edges[2*eid+1]]);
+        for(uint & pid : this->e2p[eid]) pid = uint(p_map[pid]);
+    });
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        for(uint & vid : this->polys[pid])          vid = uint(v_map[vid]);
+        for(uint & vid : this->poly_triangles[pid]) vid = uint(v_map[vid]);
+        for(uint & eid : this->p2e[pid])            eid = uint(e_map[eid]);
+        for(uint & nbr : this->p2p[pid])            nbr = uint(p_map[nbr]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<uint> AbstractPolygonMesh<M,V,E,P>::get_ordered_boundary_vertices() const
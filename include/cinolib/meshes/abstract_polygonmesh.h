@@ -55,6 +55,23 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         std::vector<std::vector<uint>> poly_triangles; // triangles covering each quad. Useful for
                                                        // robust normal estimation and rendering
 
+        // deferred deletion (see deferred_delete_begin)
+        bool              deferred_delete = false;
+        std::vector<bool> v_dead;
+        std::vector<bool> e_dead;
+        std::vector<bool> p_dead;
+        uint              n_dead_verts = 0;
+        uint              n_dead_edges = 0;
+        uint              n_dead_polys = 0;
+
+        // builds the connectivity of a mesh that has vertices but no edges/polys yet.
+        // Produces exactly the same element ordering of a sequence of poly_add calls,
+        // but processes all half edges at once in linear time
+        void polys_add_bulk(const std::vector<std::vector<uint>> & plist);
+
+        void binary_write(BinaryMeshWriter & out) const override;
+        bool binary_read (const BinaryMeshReader & in, bool & has_attributes) override;
+
     public:
 
         explicit AbstractPolygonMesh() : AbstractMesh<M,V,E,P>() {}
@@ -81,6 +98,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+                void update_bbox() override;
                 void update_normals() override;
                 void update_p_tessellation(const uint pid);
         virtual void update_p_normal(const uint pid);
@@ -91,17 +109,20 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        void topology_freeze() override;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         int Euler_characteristic() const override;
         int genus() const override;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        uint verts_per_poly(const uint pid) const override { return uint(this->polys.at(pid).size()); }
+        uint verts_per_poly(const uint pid) const override { return this->adj_p2v(pid).size(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        const std::vector<uint> & adj_p2v(const uint pid) const override { return this->polys.at(pid); }
-              std::vector<uint> & adj_p2v(const uint pid)       override { return this->polys.at(pid); }
+        IndexSpan adj_p2v(const uint pid) const override { return this->topology_frozen ? this->polys_csr.at(pid) : IndexSpan(this->polys.at(pid)); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -109,6 +130,38 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // Deferred deletion for edit-heavy operations (remeshing, decimation...).
+        // By default, removing an element moves the last element of the same kind
+        // into its slot, which rewrites the adjacency of unrelated elements and
+        // changes their ids. In deferred mode removed elements are only flagged as
+        // dead, and ids remain stable. Dead elements have empty adjacency, therefore
+        // they are never reached by local traversals. Loops over all the elements
+        // should skip them with vert/edge/poly_is_dead. Newly added elements are
+        // always appended at the end. compact() renumbers all the alive elements at
+        // once, and returns their new ids (-1 for dead elements). Note that dead
+        // elements still count in num_verts/num_edges/num_polys. The whole-mesh
+        // updates of bbox, normals and tessellations skip them, whereas saving,
+        // freezing and rendering require a compacted mesh (this is asserted).
+        //
+        // Edit-heavy algorithms that use multiple threads (e.g. remeshing and QEM
+        // decimation) build on this. Mesh edits are not thread safe, hence they
+        // group operations in batches of elements with pairwise disjoint
+        // neighborhoods, so that no operation in a batch can change the validity of
+        // the others. The checks for a whole batch run in parallel, and the edits are
+        // then applied serially. Since ids remain stable, the element lists collected
+        // for a batch stay valid while it is applied, and the mesh is compacted only
+        // once at the end
+        void deferred_delete_begin();
+        void deferred_delete_end(); // compacts the mesh
+        bool deferred_delete_is_active() const { return deferred_delete; }
+        bool has_dead_elements()         const { return n_dead_verts + n_dead_edges + n_dead_polys > 0; }
+        void compact();
+        void compact(std::vector<int> & v_map,
+                     std::vector<int> & e_map,
+                     std::vector<int> & p_map);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         std::vector<uint>  get_boundary_vertices()         const;
         std::vector<uint>  get_ordered_boundary_vertices() const;
         std::vector<ipair> get_boundary_edges()            const;
@@ -133,6 +186,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         void              vert_switch_id          (const uint vid0, const uint vid1);
         void              vert_remove             (const uint vid);
         void              vert_remove_unreferenced(const uint vid);
+        bool              vert_is_dead            (const uint vid) const { return deferred_delete && vid<v_dead.size() && v_dead[vid]; }
         uint              vert_add                (const vec3d & pos);
         bool              vert_merge              (const uint vid0, const uint vid1);
         void              vert_cluster_one_ring   (const uint vid, std::vector<std::vector<uint>> & clusters, const bool marked_edges_are_borders);
@@ -165,6 +219,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         uint   edge_add                       (const uint vid0, const uint vid1);
         void   edge_remove                    (const uint eid);
         void   edge_remove_unreferenced       (const uint eid);
+        bool   edge_is_dead                   (const uint eid) const { return deferred_delete && eid<e_dead.size() && e_dead[eid]; }
         void   edge_mark_labeling_boundaries  ();
         void   edge_mark_color_discontinuities();
         void   edge_mark_boundaries           ();
@@ -189,6 +244,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
               void                 poly_remove_unreferenced(const uint pid);
               void                 poly_remove             (const uint pid);
               void                 polys_remove            (const std::vector<uint> & pids);
+              bool                 poly_is_dead            (const uint pid) const { return deferred_delete && pid<p_dead.size() && p_dead[pid]; }
               int                  poly_opposite_to        (const uint eid, const uint pid) const;
               bool                 poly_verts_are_CCW      (const uint pid, const uint curr, const uint prev) const;
               std::vector<vec3d>   poly_vlist              (const uint pid) const;
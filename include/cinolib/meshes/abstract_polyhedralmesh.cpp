@@ -37,10 +37,14 @@
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/polygon_utils.h>
 #include <cinolib/how_many_seconds.h>
+#include <cinolib/io/binary_mesh.h>
+#include <cinolib/parallel_for.h>
 #include <unordered_set>
 #include <unordered_map>
 #include <cinolib/ANSI_color_codes.h>
 #include <queue>
+#include <algorithm>
+#include <stdexcept>
 
 namespace cinolib
 {
@@ -63,6 +67,157 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::clear()
     f2f.clear();
     f2p.clear();
     p2v.clear();
+    //
+    faces_csr.clear();
+    polys_face_winding_csr.clear();
+    v2f_csr.clear();
+    e2f_csr.clear();
+    f2e_csr.clear();
+    f2f_csr.clear();
+    f2p_csr.clear();
+    p2v_csr.clear();
+    face_triangles_csr.clear();
+    faces_nested.reset();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::topology_freeze()
+{
+    if(this->topology_frozen) return;
+
+    // windings are stored as 0/1 flags with the same layout of the polys
+    std::vector<uint> offsets(polys_face_winding.size()+1, 0);
+    for(uint pid=0; pid<polys_face_winding.size(); ++pid)
+    {
+        offsets[pid+1] = offsets[pid] + uint(polys_face_winding[pid].size());
+    }
+    std::vector<uint> flags;
+    flags.reserve(offsets.back());
+    for(const auto & w : polys_face_winding) for(bool b : w) flags.push_back(b ? 1 : 0);
+    polys_face_winding_csr.assign(std::move(offsets), std::move(flags));
+    std::vector<std::vector<bool>>().swap(polys_face_winding);
+
+    auto freeze = [](std::vector<std::vector<uint>> & lists, CSRIndices & csr)
+    {
+        csr.assign(lists);
+        std::vector<std::vector<uint>>().swap(lists);
+    };
+    freeze(faces,          faces_csr);
+    freeze(v2f,            v2f_csr);
+    freeze(e2f,            e2f_csr);
+    freeze(f2e,            f2e_csr);
+    freeze(f2f,            f2f_csr);
+    freeze(f2p,            f2p_csr);
+    freeze(p2v,            p2v_csr);
+    freeze(face_triangles, face_triangles_csr);
+    faces_nested.reset();
+
+    AbstractMesh<M,V,E,P>::topology_freeze();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::topology_thaw()
+{
+    this->operator_cache_clear();
+    if(!this->topology_frozen) return;
+
+    polys_face_winding = vector_poly_faces_winding();
+    polys_face_winding_csr.clear();
+
+    auto thaw = [](CSRIndices & csr, std::vector<std::vector<uint>> & lists)
+    {
+        lists = csr.to_nested();
+        csr.clear();
+    };
+    thaw(faces_csr,          faces);
+    thaw(v2f_csr,            v2f);
+    thaw(e2f_csr,            e2f);
+    thaw(f2e_csr,            f2e);
+    thaw(f2f_csr,            f2f);
+    thaw(f2p_csr,            f2p);
+    thaw(p2v_csr,            p2v);
+    thaw(face_triangles_csr, face_triangles);
+    faces_nested.reset();
+
+    AbstractMesh<M,V,E,P>::topology_thaw();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::binary_write(BinaryMeshWriter & out) const
+{
+    AbstractMesh<M,V,E,P>::binary_write(out);
+
+    auto lists = [&](const char * tag, const std::vector<std::vector<uint>> & nested, const CSRIndices & csr)
+    {
+        if(this->topology_frozen) out.add_lists(tag, csr);
+        else                      out.add_lists(tag, nested);
+    };
+    lists("faces",     faces,          faces_csr);
+    lists("v2f",       v2f,            v2f_csr);
+    lists("e2f",       e2f,            e2f_csr);
+    lists("f2e",       f2e,            f2e_csr);
+    lists("f2f",       f2f,            f2f_csr);
+    lists("f2p",       f2p,            f2p_csr);
+    lists("p2v",       p2v,            p2v_csr);
+    lists("face_tris", face_triangles, face_triangles_csr);
+    if(this->topology_frozen) out.add_lists("winding", polys_face_winding_csr);
+    else                      out.add_lists("winding", polys_face_winding);
+    out.add_attributes("f_data", f_data);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+bool AbstractPolyhedralMesh<M,V,E,F,P>::binary_read(const BinaryMeshReader & in, bool & has_attributes)
+{
+    if(!AbstractMesh<M,V,E,P>::binary_read(in, has_attributes) ||
+       !in.read_lists("faces",     faces_csr)                   ||
+       !in.read_lists("v2f",       v2f_csr)                     ||
+       !in.read_lists("e2f",       e2f_csr)                     ||
+       !in.read_lists("f2e",       f2e_csr)                     ||
+       !in.read_lists("f2f",       f2f_csr)                     ||
+       !in.read_lists("f2p",       f2p_csr)                     ||
+       !in.read_lists("p2v",       p2v_csr)                     ||
+       !in.read_lists("face_tris", face_triangles_csr)          ||
+       !in.read_lists("winding",   polys_face_winding_csr))
+    {
+        return false;
+    }
+
+    uint nf = num_faces();
+    if(v2f_csr.size() != this->num_verts() || e2f_csr.size() != this->num_edges() ||
+       f2e_csr.size() != nf || f2f_csr.size() != nf || f2p_csr.size() != nf || face_triangles_csr.size() != nf ||
+       p2v_csr.size() != this->num_polys() || polys_face_winding_csr.vector_offsets() != this->polys_csr.vector_offsets())
+    {
+        return false;
+    }
+
+    uint nv = this->num_verts();
+    uint ne = this->num_edges();
+    uint np = this->num_polys();
+    if(!this->polys_csr.ids_below(nf) || !faces_csr.ids_below(nv) || !face_triangles_csr.ids_below(nv) ||
+       !v2f_csr.ids_below(nf) || !e2f_csr.ids_below(nf) || !f2e_csr.ids_below(ne) ||
+       !f2f_csr.ids_below(nf) || !f2p_csr.ids_below(np) || !p2v_csr.ids_below(nv))
+    {
+        return false;
+    }
+
+    if(!in.read_attributes("f_data", f_data) || f_data.size() != nf)
+    {
+        f_data.assign(nf, F());
+        has_attributes = false;
+    }
+    return true;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -105,8 +260,16 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
     this->polys_face_winding.reserve(np);
 
     for(auto v : verts) vert_add(v);
-    for(auto f : faces) face_add(f);
-    for(uint pid=0; pid<polys.size(); ++pid) this->poly_add(polys.at(pid), polys_face_winding.at(pid));
+    if(this->num_edges()==0 && this->num_faces()==0 && this->num_polys()==0)
+    {
+        faces_add_bulk(faces);
+        polys_add_bulk(polys, polys_face_winding);
+    }
+    else
+    {
+        for(auto f : faces) face_add(f);
+        for(uint pid=0; pid<polys.size(); ++pid) this->poly_add(polys.at(pid), polys_face_winding.at(pid));
+    }
     if(this->mesh_data().update_normals) this->update_v_normals();
 
     this->copy_xyz_to_uvw(UVW_param);
@@ -147,7 +310,14 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
     this->polys_face_winding.reserve(np);
 
     for(auto v : verts) vert_add(v);
-    for(auto p : polys) poly_add(p);
+    if(this->num_edges()==0 && this->num_faces()==0 && this->num_polys()==0)
+    {
+        polys_add_bulk(polys);
+    }
+    else
+    {
+        for(auto p : polys) poly_add(p);
+    }
     if(this->mesh_data().update_normals) this->update_v_normals();
 
     this->copy_xyz_to_uvw(UVW_param);
@@ -195,6 +365,457 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Given n lists of ids serialized in (off,ids), finds the lists that contain the same
+// ids regardless of their order. For each list returns the index of the first list (in
+// input order) that is identical to it. Ids must be smaller than range
+CINO_INLINE
+static std::vector<uint> bulk_first_occurrences(const std::vector<uint> & off,
+                                                const std::vector<uint> & ids,
+                                                const uint                range)
+{
+    uint n = uint(off.size())-1;
+
+    // sorted copy of each list
+    std::vector<uint> sorted(ids);
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        std::sort(sorted.begin()+off[i], sorted.begin()+off[i+1]);
+    });
+
+    // bucket lists by their smallest id (counting sort)
+    std::vector<uint> b_off(range+1,0);
+    std::vector<uint> b_items(n);
+    for(uint i=0; i<n; ++i)
+    {
+        assert(off[i]<off[i+1]);
+        ++b_off[sorted[off[i]]+1];
+    }
+    for(uint b=0; b<range; ++b) b_off[b+1] += b_off[b];
+    {
+        std::vector<uint> pos(b_off.begin(), b_off.end()-1);
+        for(uint i=0; i<n; ++i) b_items[pos[sorted[off[i]]]++] = i;
+    }
+
+    // sort each bucket lexicographically (ties are broken by index) so that identical
+    // lists are consecutive, and the first of each run is the first in input order
+    auto list_less = [&](const uint i, const uint j)
+    {
+        return std::lexicographical_compare(sorted.begin()+off[i], sorted.begin()+off[i+1],
+                                            sorted.begin()+off[j], sorted.begin()+off[j+1]);
+    };
+    std::vector<uint> first(n);
+    PARALLEL_FOR(0, range, 10000, [&](const uint b)
+    {
+        auto beg = b_items.begin()+b_off[b];
+        auto end = b_items.begin()+b_off[b+1];
+        std::sort(beg, end, [&](const uint i, const uint j)
+        {
+            if(list_less(i,j)) return true;
+            if(list_less(j,i)) return false;
+            return i<j;
+        });
+        for(auto it=beg; it!=end; ++it)
+        {
+            bool dup = (it!=beg) && !list_less(*(it-1),*it);
+            first[*it] = (dup) ? first[*(it-1)] : *it;
+        }
+    });
+    return first;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::faces_add_bulk(const std::vector<std::vector<uint>> & flist)
+{
+    this->topology_thaw();
+    std::vector<uint> f_off(flist.size()+1,0);
+    for(uint i=0; i<flist.size(); ++i) f_off[i+1] = f_off[i] + uint(flist[i].size());
+    std::vector<uint> f_vids;
+    f_vids.reserve(f_off.back());
+    for(const auto & f : flist) f_vids.insert(f_vids.end(), f.begin(), f.end());
+    return faces_add_bulk(f_off, f_vids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::faces_add_bulk(const std::vector<uint> & f_off,
+                                                                    const std::vector<uint> & f_vids,
+                                                                    const bool                warn_duplicates)
+{
+    this->topology_thaw();
+    assert(this->num_edges()==0);
+    assert(this->num_faces()==0);
+    assert(this->num_polys()==0);
+#ifndef NDEBUG
+    for(uint vid : f_vids) assert(vid < this->num_verts());
+#endif
+
+    uint nv = this->num_verts();
+    uint n  = uint(f_off.size())-1;
+
+    // create faces. As in face_add, duplicated faces are only added once
+    std::vector<uint> first = bulk_first_occurrences(f_off, f_vids, nv);
+    std::vector<uint> fids(n);
+    for(uint i=0; i<n; ++i)
+    {
+        if(first[i]!=i)
+        {
+            if(warn_duplicates) std::cout << ANSI_fg_color_red << "WARNING: adding duplicated face!" << ANSI_fg_color_default << std::endl;
+            fids[i] = fids[first[i]];
+            continue;
+        }
+        fids[i] = uint(this->faces.size());
+        this->faces.push_back(std::vector<uint>(f_vids.begin()+f_off[i], f_vids.begin()+f_off[i+1]));
+    }
+    uint nf = this->num_faces();
+    this->f_data.resize(nf);
+    this->f2e.resize(nf);
+    this->f2f.resize(nf);
+    this->f2p.resize(nf);
+    this->face_triangles.resize(nf);
+
+    // enumerate half edges, and bucket them by their smallest vertex
+    std::vector<uint> h_off(nf+1,0);
+    for(uint fid=0; fid<nf; ++fid) h_off[fid+1] = h_off[fid] + uint(this->faces[fid].size());
+    uint nh = h_off.back();
+    std::vector<uint> h_v0(nh), h_v1(nh);
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        const std::vector<uint> & f = this->faces[fid];
+        for(uint i=0; i<f.size(); ++i)
+        {
+            h_v0[h_off[fid]+i] = f[i];
+            h_v1[h_off[fid]+i] = f[(i+1)%f.size()];
+        }
+    }
+    std::vector<uint> b_off(nv+1,0);
+    for(uint h=0; h<nh; ++h) ++b_off[std::min(h_v0[h],h_v1[h])+1];
+    for(uint vid=0; vid<nv; ++vid) b_off[vid+1] += b_off[vid];
+    std::vector<uint64_t> h_keys(nh);
+    {
+        std::vector<uint> pos(b_off.begin(), b_off.end()-1);
+        for(uint h=0; h<nh; ++h)
+        {
+            uint lo = std::min(h_v0[h],h_v1[h]);
+            uint hi = std::max(h_v0[h],h_v1[h]);
+            h_keys[pos[lo]++] = (uint64_t(hi)<<32) | h;
+        }
+    }
+
+    // within each bucket, half edges with the same opposite vertex are the same edge.
+    // Each half edge is mapped to the first half edge (in input order) that spans its edge
+    std::vector<uint> h_first(nh);
+    PARALLEL_FOR(0, nv, 10000, [&](const uint vid)
+    {
+        auto beg = h_keys.begin()+b_off[vid];
+        auto end = h_keys.begin()+b_off[vid+1];
+        std::sort(beg, end);
+        uint first = 0;
+        for(auto it=beg; it!=end; ++it)
+        {
+            uint hi = uint(*it >> 32);
+            uint h  = uint(*it & 0xffffffff);
+            if(it==beg || hi!=uint(*(it-1) >> 32)) first = h;
+            h_first[h] = first;
+        }
+    });
+
+    // edges are numbered by first occurrence, like in a sequence of face_add calls
+    std::vector<uint> h_eid(nh);
+    uint ne = 0;
+    for(uint h=0; h<nh; ++h)
+    {
+        h_eid[h] = (h_first[h]==h) ? ne++ : h_eid[h_first[h]];
+    }
+    this->edges.resize(2*ne);
+    this->e_data.resize(ne);
+    this->e2f.resize(ne);
+    this->e2p.resize(ne);
+    for(uint h=0; h<nh; ++h)
+    {
+        if(h_first[h]!=h) continue;
+        this->edges[2*h_eid[h]  ] = h_v0[h];
+        this->edges[2*h_eid[h]+1] = h_v1[h];
+    }
+
+    // vert to vert/edge/face adjacency (memory is reserved upfront to avoid reallocations)
+    std::vector<uint> v_deg(nv,0), v_star(nv,0);
+    for(uint eid=0; eid<ne; ++eid)
+    {
+        ++v_deg[this->edges[2*eid  ]];
+        ++v_deg[this->edges[2*eid+1]];
+    }
+    for(uint fid=0; fid<nf; ++fid)
+    for(uint vid : this->faces[fid]) ++v_star[vid];
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        this->v2v[vid].reserve(v_deg [vid]);
+        this->v2e[vid].reserve(v_deg [vid]);
+        this->v2f[vid].reserve(v_star[vid]);
+    }
+    for(uint eid=0; eid<ne; ++eid)
+    {
+        uint vid0 = this->edges[2*eid  ];
+        uint vid1 = this->edges[2*eid+1];
+        this->v2v[vid1].push_back(vid0);
+        this->v2v[vid0].push_back(vid1);
+        this->v2e[vid0].push_back(eid);
+        this->v2e[vid1].push_back(eid);
+    }
+    for(uint fid=0; fid<nf; ++fid)
+    for(uint vid : this->faces[fid]) this->v2f[vid].push_back(fid);
+
+    // edge to face and face to edge adjacency
+    std::vector<uint> e_star(ne,0);
+    for(uint h=0; h<nh; ++h) ++e_star[h_eid[h]];
+    for(uint eid=0; eid<ne; ++eid) this->e2f[eid].reserve(e_star[eid]);
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        this->f2e[fid].reserve(h_off[fid+1]-h_off[fid]);
+        for(uint h=h_off[fid]; h<h_off[fid+1]; ++h)
+        {
+            this->e2f[h_eid[h]].push_back(fid);
+            this->f2e[fid].push_back(h_eid[h]);
+        }
+    }
+
+    // face to face adjacency. Lists are filled in the same order of face_add, that is: first
+    // the neighbors already in the mesh (sorted by shared edge), then the ones added later
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        uint deg = 0;
+        for(uint eid : this->f2e[fid]) deg += uint(this->e2f[eid].size())-1;
+        this->f2f[fid].reserve(deg);
+    }
+    for(uint fid=0; fid<nf; ++fid)
+    {
+        for(uint eid : this->f2e[fid])
+        for(uint nbr : this->e2f[eid])
+        {
+            if(nbr>=fid) break; // e2f lists are sorted by fid
+            if(CONTAINS_VEC(this->f2f[fid],nbr)) continue;
+            this->f2f[nbr].push_back(fid);
+            this->f2f[fid].push_back(nbr);
+        }
+    }
+
+    // per face normals and tessellation
+    PARALLEL_FOR(0, nf, 1000, [&](const uint fid)
+    {
+        this->update_f_normal(fid);
+        update_f_tessellation(fid);
+    });
+
+    return fids;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::polys_add_bulk(const std::vector<std::vector<uint>> & flist,
+                                                                    const std::vector<std::vector<bool>> & fwinding)
+{
+    this->topology_thaw();
+    assert(this->num_polys()==0);
+    assert(flist.size()==fwinding.size());
+
+    uint nv = this->num_verts();
+    uint nf = this->num_faces();
+    uint n  = uint(flist.size());
+
+    // create polys. As in poly_add, duplicated polys are only added once
+    std::vector<uint> p_off(n+1,0);
+    for(uint i=0; i<n; ++i) p_off[i+1] = p_off[i] + uint(flist[i].size());
+    std::vector<uint> p_fids;
+    p_fids.reserve(p_off.back());
+    for(const auto & p : flist) p_fids.insert(p_fids.end(), p.begin(), p.end());
+#ifndef NDEBUG
+    for(uint fid : p_fids) assert(fid < nf);
+    for(uint i=0; i<n; ++i) assert(flist[i].size()==fwinding[i].size());
+#endif
+    std::vector<uint> first = bulk_first_occurrences(p_off, p_fids, nf);
+    std::vector<uint> pids(n);
+    this->polys.reserve(n);
+    this->polys_face_winding.reserve(n);
+    for(uint i=0; i<n; ++i)
+    {
+        if(first[i]!=i)
+        {
+            std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
+            pids[i] = pids[first[i]];
+            continue;
+        }
+        pids[i] = uint(this->polys.size());
+        this->polys.push_back(flist[i]);
+        this->polys_face_winding.push_back(fwinding[i]);
+    }
+    uint np = this->num_polys();
+    this->p_data.resize(np);
+    this->p2v.resize(np);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+
+    // poly to vert and poly to edge adjacency, ordered as in poly_add
+    // (i.e. by first occurrence along the face loops)
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        for(uint fid : this->polys[pid])
+        {
+            const std::vector<uint> & f = this->faces[fid];
+            for(uint i=0; i<f.size(); ++i)
+            {
+                uint eid = this->f2e[fid][i]; // edge (f[i],f[i+1])
+                if(DOES_NOT_CONTAIN_VEC(this->p2e[pid],eid )) this->p2e[pid].push_back(eid);
+                if(DOES_NOT_CONTAIN_VEC(this->p2v[pid],f[i])) this->p2v[pid].push_back(f[i]);
+            }
+        }
+    });
+
+    // vert/edge/face to poly adjacency, sorted by pid
+    std::vector<uint> v_star(nv,0);
+    for(uint pid=0; pid<np; ++pid)
+    for(uint vid : this->p2v[pid]) ++v_star[vid];
+    for(uint vid=0; vid<nv; ++vid) this->v2p[vid].reserve(v_star[vid]);
+    std::vector<uint> e_star(this->num_edges(),0);
+    for(uint pid=0; pid<np; ++pid)
+    for(uint eid : this->p2e[pid]) ++e_star[eid];
+    for(uint eid=0; eid<this->num_edges(); ++eid) this->e2p[eid].reserve(e_star[eid]);
+    for(uint pid=0; pid<np; ++pid)
+    {
+        for(uint vid : this->p2v  [pid]) this->v2p[vid].push_back(pid);
+        for(uint eid : this->p2e  [pid]) this->e2p[eid].push_back(pid);
+        for(uint fid : this->polys[pid]) this->f2p[fid].push_back(pid);
+    }
+
+    // poly to poly adjacency. Lists are filled in the same order of poly_add, that is: first
+    // the neighbors already in the mesh (sorted by shared face), then the ones added later
+    for(uint pid=0; pid<np; ++pid)
+    {
+        for(uint fid : this->polys[pid])
+        for(uint nbr : this->f2p[fid])
+        {
+            if(nbr>=pid) break; // f2p lists are sorted by pid
+            if(CONTAINS_VEC(this->p2p[pid],nbr)) continue;
+            this->p2p[nbr].push_back(pid);
+            this->p2p[pid].push_back(nbr);
+        }
+    }
+
+    // enforce standard vertex ordering
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        if(this->poly_is_hexahedron(pid) || this->poly_is_tetrahedron(pid))
+        {
+            this->poly_reorder_p2v(pid);
+        }
+    });
+
+    return pids;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::polys_add_bulk(const std::vector<std::vector<uint>> & vlist)
+{
+    this->topology_thaw();
+    assert(this->num_faces()==0);
+    uint n = uint(vlist.size());
+
+    // faces of each element, listed as in poly_add
+    auto num_faces = [](const std::vector<uint> & p) -> uint
+    {
+        switch(p.size())
+        {
+            case 4 : return 4; // tetrahedron
+            case 8 : return 6; // hexahedron
+            case 6 : return 5; // triangular prism
+            case 5 : return 5; // squared pyramid
+            default: assert(false && "Unknown polyhedral element!");
+        }
+        return 0;
+    };
+    auto face_size = [](const std::vector<uint> & p, const uint i) -> uint
+    {
+        switch(p.size())
+        {
+            case 4 : return 3;
+            case 8 : return 4;
+            case 6 : return (i<2)  ? 3 : 4;
+            case 5 : return (i==0) ? 4 : 3;
+        }
+        return 0;
+    };
+    auto face_vert = [](const std::vector<uint> & p, const uint i, const uint j) -> uint
+    {
+        switch(p.size())
+        {
+            case 4 : return p.at(TET_FACES    [i][j]);
+            case 8 : return p.at(HEXA_FACES   [i][j]);
+            case 6 : return p.at(PRISM_FACES  [i][j]);
+            case 5 : return p.at(PYRAMID_FACES[i][j]);
+        }
+        return 0;
+    };
+
+    // serialize faces. Poly i has faces p_off[i]...p_off[i+1]-1
+    std::vector<uint> p_off(n+1,0);
+    for(uint i=0; i<n; ++i) p_off[i+1] = p_off[i] + num_faces(vlist[i]);
+    std::vector<uint> f_off(p_off.back()+1,0);
+    for(uint i=0; i<n; ++i)
+    for(uint j=0; j<p_off[i+1]-p_off[i]; ++j)
+    {
+        f_off[p_off[i]+j+1] = f_off[p_off[i]+j] + face_size(vlist[i],j);
+    }
+    std::vector<uint> f_vids(f_off.back());
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        for(uint j=0; j<p_off[i+1]-p_off[i]; ++j)
+        {
+            uint f = p_off[i]+j;
+            for(uint k=0; k<f_off[f+1]-f_off[f]; ++k) f_vids[f_off[f]+k] = face_vert(vlist[i],j,k);
+        }
+    });
+
+    // faces shared by multiple polys are added only once
+    std::vector<uint> fids = faces_add_bulk(f_off, f_vids, false);
+
+    // assign face winding
+    std::vector<std::vector<uint>> flist(n);
+    std::vector<std::vector<bool>> fwinding(n);
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        for(uint f=p_off[i]; f<p_off[i+1]; ++f)
+        {
+            flist[i].push_back(fids[f]);
+            fwinding[i].push_back(this->face_verts_are_CCW(fids[f], f_vids[f_off[f]+1], f_vids[f_off[f]]));
+        }
+    });
+
+    std::vector<uint> pids = polys_add_bulk(flist, fwinding);
+
+    // restore standard vertex ordering from input file
+    for(uint i=0; i<n; ++i)
+    {
+        if(vlist[i].size()==6 || vlist[i].size()==5) this->p2v.at(pids[i]) = vlist[i];
+    }
+
+    PARALLEL_FOR(0, this->num_polys(), 1000, [&](const uint pid)
+    {
+        update_p_quality(pid);
+    });
+
+    return pids;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 double AbstractPolyhedralMesh<M,V,E,F,P>::mesh_srf_area() const
@@ -303,6 +924,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_normals()
 {
+    this->operator_cache_clear();
     update_f_normals();
     update_v_normals();
 }
@@ -367,11 +989,20 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_f_tessellation()
 {
-    this->face_triangles.resize(this->num_faces());
+    // frozen meshes are tessellated from scratch and compressed again
+    if(this->topology_frozen) this->face_triangles.assign(this->num_faces(), std::vector<uint>());
+    else                      this->face_triangles.resize(this->num_faces());
+
     for(uint fid=0; fid<this->num_faces(); ++fid)
     {
         update_f_tessellation(fid);
     }
+
+    if(this->topology_frozen)
+    {
+        face_triangles_csr.assign(face_triangles);
+        std::vector<std::vector<uint>>().swap(face_triangles);
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -386,9 +1017,9 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::update_f_tessellation(const uint fid)
     std::vector<vec3d> n;
     for (uint i=2; i<this->verts_per_face(fid); ++i)
     {
-        uint vid0 = this->faces.at(fid).at( 0 );
-        uint vid1 = this->faces.at(fid).at(i-1);
-        uint vid2 = this->faces.at(fid).at( i );
+        uint vid0 = this->face_vert_id(fid, 0 );
+        uint vid1 = this->face_vert_id(fid,i-1);
+        uint vid2 = this->face_vert_id(fid, i );
 
         face_triangles.at(fid).push_back(vid0);
         face_triangles.at(fid).push_back(vid1);
@@ -520,7 +1151,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::face_tessellation(const uint fid) const
 {
-    return face_triangles.at(fid);
+    return this->topology_frozen ? face_triangles_csr.at(fid).to_vector() : face_triangles.at(fid);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -634,6 +1265,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::face_split_in_triangles(const uint fid, const vec3d & p)
 {
+    this->topology_thaw();
     assert(this->face_has_no_duplicate_verts(fid));
 
     uint new_vid = this->vert_add(p);
@@ -673,6 +1305,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::face_split_along_new_edge(const uint fid, uint vid0, uint vid1)
 {
+    this->topology_thaw();
     assert(this->verts_per_face(fid)>3);
     assert(this->face_contains_vert(fid, vid0));
     assert(this->face_contains_vert(fid, vid1));
@@ -718,6 +1351,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_split_along_new_face(const uint pid, const std::vector<uint> & f)
 {
+    this->topology_thaw();
 #ifndef NDEBUG
     for(uint vid : f) assert(this->poly_contains_vert(pid,vid));
 #endif
@@ -918,6 +1552,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::edge_split(const uint eid, const vec3d & p)
 {
+    this->topology_thaw();
     uint new_vid = this->vert_add(p);
     uint v0      = this->edge_vert_id(eid, 0);
     uint v1      = this->edge_vert_id(eid, 1);
@@ -1063,7 +1698,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_face_id(const uint pid, const uint off) const
 {
-    return this->polys.at(pid).at(off);
+    return this->adj_p2f(pid).at(off);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1072,6 +1707,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_face_flip_winding(const uint pid, const uint fid)
 {
+    this->topology_thaw();
     uint off = poly_face_offset(pid, fid);
     polys_face_winding.at(pid).at(off) = !polys_face_winding.at(pid).at(off);
 }
@@ -1084,6 +1720,7 @@ bool AbstractPolyhedralMesh<M,V,E,F,P>::poly_face_winding(const uint pid, const
 {
     assert(this->poly_contains_face(pid,fid));
     uint off = poly_face_offset(pid, fid);
+    if(this->topology_frozen) return polys_face_winding_csr.at(pid).at(off) != 0;
     return polys_face_winding.at(pid).at(off);
 }
 
@@ -1093,6 +1730,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_flip_winding(const uint pid)
 {
+    this->topology_thaw();
     for(uint fid : this->adj_p2f(pid))
     {
         this->poly_face_flip_winding(pid,fid);
@@ -1106,7 +1744,7 @@ CINO_INLINE
 bool AbstractPolyhedralMesh<M,V,E,F,P>::poly_face_is_CW(const uint pid, const uint fid) const
 {
     uint off = poly_face_offset(pid, fid);
-    return (polys_face_winding.at(pid).at(off) == false);
+    return (poly_face_winding(pid,fid) == false);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1125,7 +1763,7 @@ CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_face_offset(const uint pid, const uint fid) const
 {
     assert(poly_contains_face(pid,fid));
-    for(uint off=0; off<this->polys.at(pid).size(); ++off)
+    for(uint off=0; off<this->faces_per_poly(pid); ++off)
     {
         if (poly_face_id(pid,off) == fid) return off;
     }
@@ -1293,7 +1931,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::face_vert_id(const uint fid, const uint off) const
 {
-    return faces.at(fid).at(off);
+    return this->adj_f2v(fid).at(off);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1970,6 +2608,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_switch_id(const uint vid0, const uint vid1)
 {
+    this->topology_thaw();
     if(vid0 == vid1) return;
 
     std::swap(this->verts.at(vid0),   this->verts.at(vid1));
@@ -2044,6 +2683,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_remove(const uint vid)
 {
+    this->topology_thaw();
     polys_remove(this->adj_v2p(vid));
 }
 
@@ -2053,6 +2693,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_remove_unreferenced(const uint vid)
 {
+    this->topology_thaw();
     this->v2v.at(vid).clear();
     this->v2e.at(vid).clear();
     this->v2f.at(vid).clear();
@@ -2072,6 +2713,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::vert_add(const vec3d & pos)
 {
+    this->topology_thaw();
     uint vid = this->num_verts();
     //
     this->verts.push_back(pos);
@@ -2097,6 +2739,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_switch_id(const uint eid0, const uint eid1)
 {
+    this->topology_thaw();
     if (eid0 == eid1) return;
 
     for(uint off=0; off<2; ++off) std::swap(this->edges.at(2*eid0+off), this->edges.at(2*eid1+off));
@@ -2152,6 +2795,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::edge_add(const uint vid0, const uint vid1)
 {
+    this->topology_thaw();
     assert(this->edge_id(vid0, vid1)==-1); // make sure it doesn't exist already
     assert(vid0 < this->num_verts());
     assert(vid1 < this->num_verts());
@@ -2186,6 +2830,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_remove(const uint eid)
 {
+    this->topology_thaw();
     polys_remove(this->adj_e2p(eid));
 }
 
@@ -2195,6 +2840,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_remove_unreferenced(const uint eid)
 {
+    this->topology_thaw();
     this->e2f.at(eid).clear();
     this->e2p.at(eid).clear();
     edge_switch_id(eid, this->num_edges()-1);
@@ -2210,6 +2856,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::face_switch_id(const uint fid0, const uint fid1)
 {
+    this->topology_thaw();
     // should I do something for poly_face_winding?
 
     if (fid0 == fid1) return;
@@ -2280,6 +2927,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::face_add(const std::vector<uint> & f)
 {
+    this->topology_thaw();
     if(face_id(f)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated face!" << ANSI_fg_color_default << std::endl;
@@ -2347,6 +2995,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::face_remove(const uint fid)
 {
+    this->topology_thaw();
     polys_remove(this->adj_f2p(fid));
 }
 
@@ -2356,6 +3005,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::face_remove_unreferenced(const uint fid)
 {
+    this->topology_thaw();
     this->faces.at(fid).clear();
     this->f2e.at(fid).clear();
     this->f2f.at(fid).clear();
@@ -2376,6 +3026,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_switch_id(const uint pid0, const uint pid1)
 {
+    this->topology_thaw();
     if (pid0 == pid1) return;
 
     std::swap(this->polys.at(pid0),              this->polys.at(pid1));
@@ -2445,6 +3096,7 @@ CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<uint> & flist,
                                                  const std::vector<bool> & fwinding)
 {
+    this->topology_thaw();
     if(poly_id(flist)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
@@ -2518,6 +3170,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<uint> & vlist)
 {
+    this->topology_thaw();
     if(vlist.size()==4) // tetrahedron
     {
         // detect faces
@@ -2643,7 +3296,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<uint> & vlist
                              static_cast<uint>(fid4)},w);
 
         // restore standard vertex ordering from input file
-        this->adj_p2v(pid) = vlist;
+        this->p2v.at(pid) = vlist;
         return pid;
     }
     else if(vlist.size()==5) // squared pyramid
@@ -2685,7 +3338,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<uint> & vlist
                              static_cast<uint>(fid4)},w);
 
         // restore standard vertex ordering from input file
-        this->adj_p2v(pid) = vlist;
+        this->p2v.at(pid) = vlist;
         return pid;
     }
     else assert(false && "Unknown polyhedral element!");
@@ -2698,6 +3351,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_reorder_p2v(const uint pid)
 {
+    this->topology_thaw();
     if(this->verts_per_poly(pid)==4)
     {
         /* ensures standard tetrahedron vert ordering in the p2v adjacency
@@ -2764,6 +3418,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_remove_unreferenced(const uint pid)
 {
+    this->topology_thaw();
     this->polys.at(pid).clear();
     this->p2v.at(pid).clear();
     this->p2e.at(pid).clear();
@@ -2784,6 +3439,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_remove(const uint pid, const bool delete_dangling_elements)
 {
+    this->topology_thaw();
     std::set<uint,std::greater<uint>> dangling_verts; // higher ids first
     std::set<uint,std::greater<uint>> dangling_edges; // higher ids first
     std::set<uint,std::greater<uint>> dangling_faces; // higher ids first
@@ -2866,6 +3522,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::polys_remove(const std::vector<uint> & pids)
 {
+    this->topology_thaw();
     // in order to avoid id conflicts remove all the
     // polys starting from the one with highest id
     //
@@ -3088,11 +3745,49 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 std::vector<bool> AbstractPolyhedralMesh<M,V,E,F,P>::poly_faces_winding(const uint pid) const
 {
+    if(this->topology_frozen)
+    {
+        IndexSpan flags = polys_face_winding_csr.at(pid);
+        return std::vector<bool>(flags.begin(), flags.end());
+    }
     return this->polys_face_winding.at(pid);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+const std::vector<std::vector<uint>> & AbstractPolyhedralMesh<M,V,E,F,P>::vector_faces() const
+{
+    if(this->topology_frozen) return faces_nested.get(faces_csr);
+    return faces;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+const std::vector<std::vector<uint>> & AbstractPolyhedralMesh<M,V,E,F,P>::vector_faces(std::vector<std::vector<uint>> & buf) const
+{
+    if(!this->topology_frozen) return faces;
+    buf = faces_csr.to_nested();
+    return buf;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+std::vector<std::vector<bool>> AbstractPolyhedralMesh<M,V,E,F,P>::vector_poly_faces_winding() const
+{
+    if(!this->topology_frozen) return polys_face_winding;
+    std::vector<std::vector<bool>> res(this->num_polys());
+    for(uint pid=0; pid<this->num_polys(); ++pid) res.at(pid) = poly_faces_winding(pid);
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint AbstractPolyhedralMesh<M,V,E,F,P>::pick_face(const vec3d & p) const
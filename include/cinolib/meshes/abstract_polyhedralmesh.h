@@ -66,6 +66,36 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         std::vector<std::vector<uint>> face_triangles; // per face serialized triangulation (e.g., for rendering)
 
+        // frozen topology: faces and face adjacencies in compressed (CSR) storage
+        // (see AbstractMesh::topology_freeze). Windings are stored as 0/1 flags
+        CSRIndices faces_csr;
+        CSRIndices polys_face_winding_csr;
+        CSRIndices v2f_csr;
+        CSRIndices e2f_csr;
+        CSRIndices f2e_csr;
+        CSRIndices f2f_csr;
+        CSRIndices f2p_csr;
+        CSRIndices p2v_csr;
+        CSRIndices face_triangles_csr;
+        CSRNestedCache faces_nested; // serves vector_faces() const on frozen meshes
+
+        // bulk construction of the connectivity of a mesh that has vertices but no
+        // edges/faces/polys yet. They produce exactly the same element ordering of a
+        // sequence of face_add/poly_add calls, but shared faces and edges are found
+        // all at once sorting canonical keys, rather than searching the adjacency of
+        // a vertex for each face. Return the id of each input element (duplicated
+        // elements are added only once, as in face_add/poly_add)
+        std::vector<uint> faces_add_bulk(const std::vector<std::vector<uint>> & flist);
+        std::vector<uint> faces_add_bulk(const std::vector<uint> & f_off,   // face i spans f_vids[f_off[i]...f_off[i+1]-1]
+                                         const std::vector<uint> & f_vids,
+                                         const bool                warn_duplicates = true);
+        std::vector<uint> polys_add_bulk(const std::vector<std::vector<uint>> & flist,
+                                         const std::vector<std::vector<bool>> & fwinding); // requires faces
+        std::vector<uint> polys_add_bulk(const std::vector<std::vector<uint>> & vlist);   // tets, hexas, prisms and pyramids
+
+        void binary_write(BinaryMeshWriter & out) const override;
+        bool binary_read (const BinaryMeshReader & in, bool & has_attributes) override;
+
     public:
 
         typedef F F_type;
@@ -77,6 +107,9 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         void clear() override;
 
+        void topology_freeze() override;
+        void topology_thaw() override;
+
         void init(const std::vector<vec3d>             & verts,
                   const std::vector<std::vector<uint>> & faces,
                   const std::vector<std::vector<uint>> & polys,
@@ -122,10 +155,10 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        virtual uint verts_per_poly(const uint pid) const override { return uint(this->p2v.at(pid).size());   }
-        virtual uint faces_per_poly(const uint pid) const          { return uint(this->polys.at(pid).size()); }
-        virtual uint verts_per_face(const uint fid) const          { return uint(this->faces.at(fid).size()); }
-        virtual uint edges_per_face(const uint fid) const          { return uint(this->faces.at(fid).size()); }
+        virtual uint verts_per_poly(const uint pid) const override { return this->adj_p2v(pid).size(); }
+        virtual uint faces_per_poly(const uint pid) const          { return this->adj_p2f(pid).size(); }
+        virtual uint verts_per_face(const uint fid) const          { return this->adj_f2v(fid).size(); }
+        virtual uint edges_per_face(const uint fid) const          { return this->adj_f2v(fid).size(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -133,11 +166,14 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
         uint num_srf_edges() const;
         uint num_srf_faces() const;
         uint num_srf_polys() const;
-        uint num_faces()     const { return uint(faces.size()); }
+        uint num_faces()     const { return this->topology_frozen ? faces_csr.size() : uint(faces.size()); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        const std::vector<std::vector<uint>> & vector_faces() const { return faces; }
+        const std::vector<std::vector<uint>> & vector_faces()      const; // frozen meshes expand faces into a copy, kept until the next thaw/freeze
+        const std::vector<std::vector<uint>> & vector_faces(std::vector<std::vector<uint>> & buf) const; // any mode (frozen faces are expanded into buf)
+        std::vector<std::vector<uint>> vector_poly_verts()         const { return this->topology_frozen ? p2v_csr.to_nested()   : p2v;   }
+        std::vector<std::vector<bool>> vector_poly_faces_winding() const;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -147,22 +183,14 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        const std::vector<uint> & adj_v2f(const uint vid) const          { return v2f.at(vid);         }
-              std::vector<uint> & adj_v2f(const uint vid)                { return v2f.at(vid);         }
-        const std::vector<uint> & adj_e2f(const uint eid) const          { return e2f.at(eid);         }
-              std::vector<uint> & adj_e2f(const uint eid)                { return e2f.at(eid);         }
-        const std::vector<uint> & adj_f2v(const uint fid) const          { return this->faces.at(fid); }
-              std::vector<uint> & adj_f2v(const uint fid)                { return this->faces.at(fid); }
-        const std::vector<uint> & adj_f2e(const uint fid) const          { return f2e.at(fid);         }
-              std::vector<uint> & adj_f2e(const uint fid)                { return f2e.at(fid);         }
-        const std::vector<uint> & adj_f2f(const uint fid) const          { return f2f.at(fid);         }
-              std::vector<uint> & adj_f2f(const uint fid)                { return f2f.at(fid);         }
-        const std::vector<uint> & adj_f2p(const uint fid) const          { return f2p.at(fid);         }
-              std::vector<uint> & adj_f2p(const uint fid)                { return f2p.at(fid);         }
-        const std::vector<uint> & adj_p2f(const uint pid) const          { return this->polys.at(pid); }
-              std::vector<uint> & adj_p2f(const uint pid)                { return this->polys.at(pid); }
-        const std::vector<uint> & adj_p2v(const uint pid) const override { return p2v.at(pid);         }
-              std::vector<uint> & adj_p2v(const uint pid)       override { return p2v.at(pid);         }
+        IndexSpan                 adj_v2f(const uint vid) const          { return this->topology_frozen ? v2f_csr.at(vid)   : IndexSpan(v2f.at(vid));         }
+        IndexSpan                 adj_e2f(const uint eid) const          { return this->topology_frozen ? e2f_csr.at(eid)   : IndexSpan(e2f.at(eid));         }
+        IndexSpan                 adj_f2v(const uint fid) const          { return this->topology_frozen ? faces_csr.at(fid) : IndexSpan(this->faces.at(fid)); }
+        IndexSpan                 adj_f2e(const uint fid) const          { return this->topology_frozen ? f2e_csr.at(fid)   : IndexSpan(f2e.at(fid));         }
+        IndexSpan                 adj_f2f(const uint fid) const          { return this->topology_frozen ? f2f_csr.at(fid)   : IndexSpan(f2f.at(fid));         }
+        IndexSpan                 adj_f2p(const uint fid) const          { return this->topology_frozen ? f2p_csr.at(fid)   : IndexSpan(f2p.at(fid));         }
+        IndexSpan                 adj_p2f(const uint pid) const          { return this->topology_frozen ? this->polys_csr.at(pid) : IndexSpan(this->polys.at(pid)); }
+        IndexSpan                 adj_p2v(const uint pid) const override { return this->topology_frozen ? p2v_csr.at(pid) : IndexSpan(p2v.at(pid)); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
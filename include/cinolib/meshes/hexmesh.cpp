@@ -121,6 +121,12 @@ void Hexmesh<M,V,E,F,P>::load(const char * filename)
     {
         read_VTK(filename, tmp_verts, tmp_polys);
     }
+    else if (filetype.compare(".cino") == 0 ||
+             filetype.compare(".CINO") == 0)
+    {
+        this->load_binary(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
@@ -143,30 +149,36 @@ void Hexmesh<M,V,E,F,P>::save(const char * filename) const
     {
         if(this->polys_are_labeled())
         {
-            write_MESH(filename, this->verts, this->p2v, std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
+            write_MESH(filename, this->verts, this->vector_poly_verts(), std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
         }
-        else write_MESH(filename, this->verts, this->p2v);
+        else write_MESH(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("vtu") == 0 ||
              filetype.compare("VTU") == 0)
     {
-        write_VTU(filename, this->verts, this->p2v);
+        write_VTU(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("vtk") == 0 ||
              filetype.compare("VTK") == 0)
     {
-        write_VTK(filename, this->verts, this->p2v);
+        write_VTK(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("hedra") == 0 ||
              filetype.compare("HEDRA") == 0)
     {
-        write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+        std::vector<std::vector<uint>> f_buf, p_buf; // used only by frozen meshes
+        write_HEDRA(filename, this->verts, this->vector_faces(f_buf), this->vector_polys(p_buf), this->vector_poly_faces_winding());
     }
     else if (filetype.compare("ovm") == 0 ||
              filetype.compare("OVM") == 0)
     {
         write_OVM(filename, *this);
     }
+    else if (filetype.compare("cino") == 0 ||
+             filetype.compare("CINO") == 0)
+    {
+        this->save_binary(filename);
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : file format not supported yet " << std::endl;
@@ -403,6 +415,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void Hexmesh<M,V,E,F,P>::poly_subdivide(const std::vector<std::vector<std::vector<uint>>> & poly_split_scheme)
 {
+    this->topology_thaw();
     std::vector<vec3d> new_verts;
     std::vector<uint>  new_polys;
     std::map<std::vector<uint>,uint> v_map;
@@ -34,6 +34,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/meshes/mesh_slicer.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
 #include <sstream>
 
 namespace cinolib
@@ -96,33 +98,124 @@ std::string MeshSlicer::serialize() const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+void MeshSlicer::clear_cache()
+{
+    cache_np = 0;
+    for(int i=0; i<4; ++i) cache_order[i].clear();
+    cache_pass.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
-void MeshSlicer::slice(AbstractMesh<M,V,E,P> & m)
+std::vector<uint> MeshSlicer::slice(AbstractMesh<M,V,E,P> & m)
 {
-    double X_abs_thresh = m.bbox().min[0] + m.bbox().delta()[0] * (X_thresh);
-    double Y_abs_thresh = m.bbox().min[1] + m.bbox().delta()[1] * (Y_thresh);
-    double Z_abs_thresh = m.bbox().min[2] + m.bbox().delta()[2] * (Z_thresh);
+    enum { PASS_X = 0x1, PASS_Y = 0x2, PASS_Z = 0x4, PASS_Q = 0x8, PASS_L = 0x10, PASS_ALL = 0x1F };
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
+    uint   np        = m.num_polys();
+    double thresh[4] =
     {
-        vec3d c = m.poly_centroid(pid);
-        float q = m.poly_data(pid).quality;
-        int   l = m.poly_data(pid).label;
+        m.bbox().min[0] + m.bbox().delta()[0] * (X_thresh),
+        m.bbox().min[1] + m.bbox().delta()[1] * (Y_thresh),
+        m.bbox().min[2] + m.bbox().delta()[2] * (Z_thresh),
+        Q_thresh
+    };
+    bool leq[4] = { X_leq, Y_leq, Z_leq, Q_leq };
 
-        bool pass_X = (X_leq) ? (c.x() <= X_abs_thresh) : (c.x() >= X_abs_thresh);
-        bool pass_Y = (Y_leq) ? (c.y() <= Y_abs_thresh) : (c.y() >= Y_abs_thresh);
-        bool pass_Z = (Z_leq) ? (c.z() <= Z_abs_thresh) : (c.z() >= Z_abs_thresh);
-        bool pass_Q = (Q_leq) ? (q     <= Q_thresh    ) : (q     >= Q_thresh);
-        bool pass_L = (L_is ) ? (L_filter==-1 || l == L_filter) : (L_filter == -1 || l != L_filter);
+    auto value = [&m](const uint pid, const int i) -> double
+    {
+        return (i<3) ? m.poly_centroid(pid)[i] : m.poly_data(pid).quality;
+    };
+    auto pass = [&](const double v, const int i) -> bool
+    {
+        return (leq[i]) ? (v <= thresh[i]) : (v >= thresh[i]);
+    };
+    auto pass_L = [&](const uint pid) -> bool
+    {
+        int l = m.poly_data(pid).label;
+        return (L_is) ? (L_filter==-1 || l == L_filter) : (L_filter == -1 || l != L_filter);
+    };
+    auto set_bit = [&](const uint pid, const char bit, const bool b) -> bool
+    {
+        char old = cache_pass[pid];
+        cache_pass[pid] = (b) ? (old | bit) : (old & ~bit);
+        return cache_pass[pid] != old;
+    };
 
-        bool b = (mode_AND) ? ( pass_X &&  pass_Y &&  pass_Z &&  pass_L &&  pass_Q)
-                            : (!pass_X || !pass_Y || !pass_Z || !pass_L || !pass_Q);
+    if(cache_np != np || !(cache_bbox.min == m.bbox().min) || !(cache_bbox.max == m.bbox().max))
+    {
+        std::vector<vec3d> c(np);
+        PARALLEL_FOR(0, np, 1000, [&](uint pid){ c[pid] = m.poly_centroid(pid); });
+
+        PARALLEL_FOR(0, 4, 0, [&](uint i)
+        {
+            std::vector<std::pair<double,uint>> tmp(np);
+            for(uint pid=0; pid<np; ++pid) tmp[pid] = std::make_pair((i<3) ? c[pid][i] : m.poly_data(pid).quality, pid);
+            std::sort(tmp.begin(), tmp.end());
+            cache_order[i].resize(np);
+            for(uint j=0; j<np; ++j) cache_order[i][j] = tmp[j].second;
+        });
 
-        m.poly_data(pid).flags[HIDDEN] = !b;
+        cache_pass.resize(np);
+        PARALLEL_FOR(0, np, 1000, [&](uint pid)
+        {
+            char mask = 0;
+            if(pass(c[pid][0],0))                mask |= PASS_X;
+            if(pass(c[pid][1],1))                mask |= PASS_Y;
+            if(pass(c[pid][2],2))                mask |= PASS_Z;
+            if(pass(m.poly_data(pid).quality,3)) mask |= PASS_Q;
+            if(pass_L(pid))                      mask |= PASS_L;
+            cache_pass[pid] = mask;
+        });
+    }
+    else
+    {
+        for(int i=0; i<4; ++i)
+        {
+            char bit = char(1<<i);
+            if(leq[i] != cache_leq[i])
+            {
+                PARALLEL_FOR(0, np, 1000, [&](uint pid){ set_bit(pid, bit, pass(value(pid,i),i)); });
+            }
+            else if(thresh[i] != cache_thresh[i])
+            {
+                // only polys in between the old and the new threshold may change
+                double lo = std::min(thresh[i], cache_thresh[i]);
+                double hi = std::max(thresh[i], cache_thresh[i]);
+                auto beg = std::lower_bound(cache_order[i].begin(), cache_order[i].end(), lo,
+                                            [&](const uint pid, const double v){ return value(pid,i) < v; });
+                auto end = std::upper_bound(beg, cache_order[i].end(), hi,
+                                            [&](const double v, const uint pid){ return v < value(pid,i); });
+                for(auto it=beg; it!=end; ++it) set_bit(*it, bit, pass(value(*it,i),i));
+            }
+        }
+        // labels are cheap to read, and may have been edited since the last call
+        PARALLEL_FOR(0, np, 1000, [&](uint pid){ set_bit(pid, PASS_L, pass_L(pid)); });
+    }
 
-        //std::cout << pass_X << " " << pass_Y << " " << pass_Z << " " << pass_Q << " " << pass_L << std::endl;
+    cache_np   = np;
+    cache_bbox = m.bbox();
+    for(int i=0; i<4; ++i)
+    {
+        cache_thresh[i] = thresh[i];
+        cache_leq[i]    = leq[i];
+    }
+
+    // all flags are checked, so that polys hidden or shown by someone else
+    // (e.g. manual digging) are restored, as in a slicing from scratch
+    std::vector<uint> changed;
+    for(uint pid=0; pid<np; ++pid)
+    {
+        bool hidden = (mode_AND) ? (cache_pass[pid] != PASS_ALL) : (cache_pass[pid] == PASS_ALL);
+        if(m.poly_data(pid).flags[HIDDEN] != hidden)
+        {
+            m.poly_data(pid).flags[HIDDEN] = hidden;
+            changed.push_back(pid);
+        }
     }
+    return changed;
 }
 
 }
@@ -73,8 +73,40 @@ class MeshSlicer
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // Sets the HIDDEN flag of each poly according to the current thresholds,
+        // and returns the list of polys whose visibility changed. The first time
+        // a mesh is sliced its polys are sorted by centroid X,Y,Z and by quality,
+        // so that subsequent calls only re-evaluate centroids and quality of the
+        // polys that lie between the old and the new thresholds.
+        //
+        // A slicer caches this state for one mesh at a time, and only checks that
+        // the number of polys and the bounding box did not change. Call clear_cache()
+        // before slicing a different mesh (or the same object after assigning a new
+        // mesh to it), or after editing the geometry or the quality of the mesh.
+        //
+        // Limitation: each call still makes a linear pass over all polys, which
+        // reads labels again and overwrites HIDDEN flags changed by someone else
+        // in between two calls (as a slicing from scratch would do). It is much
+        // cheaper than the sorting, but not proportional to the polys that change.
+        // Also, callers that refresh the whole GL buffers after slicing (e.g. the
+        // volume mesh controls, which call updateGL) pay a linear cost anyway
+        //
         template<class M, class V, class E, class P>
-        void slice(AbstractMesh<M,V,E,P> & m);
+        std::vector<uint> slice(AbstractMesh<M,V,E,P> & m);
+
+        void clear_cache(); // drops the per poly sorting (see slice)
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    private:
+
+        // state of the last slicing, used for incremental updates
+        uint               cache_np        = 0;
+        AABB               cache_bbox;
+        std::vector<uint>  cache_order[4];                         // polys sorted by centroid X,Y,Z and by quality
+        std::vector<char>  cache_pass;                             // per poly bitmask of passed tests (X,Y,Z,Q,L)
+        double             cache_thresh[4] = { 0, 0, 0, 0 };       // absolute X,Y,Z,Q thresholds
+        bool               cache_leq[4]    = { true, true, true, true };
 };
 
 }
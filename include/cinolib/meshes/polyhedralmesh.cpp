@@ -119,6 +119,12 @@ void Polyhedralmesh<M,V,E,F,P>::load(const char * filename)
         read_VTK(filename, tmp_verts, tmp_polys);
         this->init(tmp_verts, tmp_polys, vert_labels, poly_labels);
     }
+    else if (filetype.compare(".cino") == 0 ||
+             filetype.compare(".CINO") == 0)
+    {
+        this->load_binary(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
@@ -139,20 +145,26 @@ void Polyhedralmesh<M,V,E,F,P>::save(const char * filename) const
     {
         if(this->polys_are_labeled())
         {
-            write_MESH(filename, this->verts, this->p2v, std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
+            write_MESH(filename, this->verts, this->vector_poly_verts(), std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
         }
-        else write_MESH(filename, this->verts, this->p2v);
+        else write_MESH(filename, this->verts, this->vector_poly_verts());
     }
     else if(filetype.compare("hedra") == 0 ||
        filetype.compare("HEDRA") == 0)
     {
-        write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+        std::vector<std::vector<uint>> f_buf, p_buf; // used only by frozen meshes
+        write_HEDRA(filename, this->verts, this->vector_faces(f_buf), this->vector_polys(p_buf), this->vector_poly_faces_winding());
     }
     else if(filetype.compare("ovm") == 0 ||
             filetype.compare("OVM") == 0)
     {
         write_OVM(filename, *this);
     }
+    else if (filetype.compare("cino") == 0 ||
+             filetype.compare("CINO") == 0)
+    {
+        this->save_binary(filename);
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : file format not supported yet " << std::endl;
@@ -129,6 +129,12 @@ void Tetmesh<M,V,E,F,P>::load(const char * filename)
         read_OVM(filename, tmp_verts, edges, faces, polys);
         tmp_polys = polys_from_serialized_vids(polys,4);
     }
+    else if (filetype.compare(".cino") == 0 ||
+             filetype.compare(".CINO") == 0)
+    {
+        this->load_binary(filename);
+        return;
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load() : file format not supported yet " << std::endl;
@@ -151,35 +157,41 @@ void Tetmesh<M,V,E,F,P>::save(const char * filename) const
     {
         if(this->polys_are_labeled())
         {
-            write_MESH(filename, this->verts, this->p2v, std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
+            write_MESH(filename, this->verts, this->vector_poly_verts(), std::vector<int>(this->num_verts(),0), this->vector_poly_labels());
         }
-        else write_MESH(filename, this->verts, this->p2v);
+        else write_MESH(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("tet") == 0 ||
              filetype.compare("TET") == 0)
     {
-        write_TET(filename, this->verts, this->p2v);
+        write_TET(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("vtu") == 0 ||
              filetype.compare("VTU") == 0)
     {
-        write_VTU(filename, this->verts, this->p2v);
+        write_VTU(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("vtk") == 0 ||
              filetype.compare("VTK") == 0)
     {
-        write_VTK(filename, this->verts, this->p2v);
+        write_VTK(filename, this->verts, this->vector_poly_verts());
     }
     else if (filetype.compare("hedra") == 0 ||
              filetype.compare("HEDRA") == 0)
     {
-        write_HEDRA(filename, this->verts, this->faces, this->polys, this->polys_face_winding);
+        std::vector<std::vector<uint>> f_buf, p_buf; // used only by frozen meshes
+        write_HEDRA(filename, this->verts, this->vector_faces(f_buf), this->vector_polys(p_buf), this->vector_poly_faces_winding());
     }
     else if (filetype.compare("ovm") == 0 ||
              filetype.compare("OVM") == 0)
     {
         write_OVM(filename, *this);
     }
+    else if (filetype.compare("cino") == 0 ||
+             filetype.compare("CINO") == 0)
+    {
+        this->save_binary(filename);
+    }
     else
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write() : file format not supported yet " << std::endl;
@@ -221,6 +233,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::edge_split(const uint eid, const double lambda)
 {
+    this->topology_thaw();
     return edge_split(eid, this->edge_sample_at(eid,lambda));
 }
 
@@ -230,6 +243,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::edge_split(const uint eid, const uint split_point)
 {
+    this->topology_thaw();
     assert(this->edge_valence(eid)>0);
     // create sub-elements
     for(uint pid : this->adj_e2p(eid))
@@ -278,6 +292,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::edge_split(const uint eid, const vec3d & p)
 {
+    this->topology_thaw();
     assert(this->edge_valence(eid)>0);
     uint split_point = this->vert_add(p);
     return edge_split(eid,split_point);
@@ -399,6 +414,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 int Tetmesh<M,V,E,F,P>::edge_collapse(const uint eid, const double lambda, const double topologic_check, const double geometric_check)
 {
+    this->topology_thaw();
     vec3d p = this->edge_sample_at(eid, lambda);
     return edge_collapse(eid, p, topologic_check, geometric_check);
 }
@@ -409,6 +425,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 int Tetmesh<M,V,E,F,P>::edge_collapse(const uint eid, const vec3d & p, const double topologic_check, const double geometric_check)
 {
+    this->topology_thaw();
     if(topologic_check && !edge_is_topologically_collapsible(eid))    return -1;
     if(geometric_check && !edge_is_geometrically_collapsible(eid, p)) return -1;
 
@@ -531,6 +548,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 bool Tetmesh<M,V,E,F,P>::edge_flip(const uint eid, const bool geometric_check) // 3-to-2 flip
 {
+    this->topology_thaw();
     // "An edge is topologically unflippable if does not
     //  have exactly three incident faces or the face that
     //  would replace it is already in the complex"
@@ -634,6 +652,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::face_split(const uint fid, const std::vector<double> & bc)
 {
+    this->topology_thaw();
     assert(bc.size()==3);
 
     vec3d p = this->face_vert(fid,0) * bc.at(0) +
@@ -649,6 +668,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::face_split(const uint fid, const vec3d & p)
 {
+    this->topology_thaw();
     uint new_vid = this->vert_add(p);
 
     for(uint pid : this->adj_f2p(fid))
@@ -710,6 +730,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::vert_split(const uint vid, const std::vector<uint> & f_umbrella)
 {
+    this->topology_thaw();
     vec3d p(inf_double,inf_double,inf_double);
     return vert_split(vid,f_umbrella,p);
 }
@@ -720,6 +741,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::vert_split(const uint vid, const std::vector<uint> & f_umbrella, vec3d & p)
 {
+    this->topology_thaw();
     // reset local flags for faces and tets
     for(uint pid : this->adj_v2p(vid)) this->poly_data(pid).flags[MARKED_LOCAL] = false;
     for(uint fid : this->adj_v2f(vid)) this->face_data(fid).flags[MARKED_LOCAL] = false;
@@ -1018,6 +1040,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::poly_split(const uint pid, const std::vector<double> & bc)
 {
+    this->topology_thaw();
     assert(bc.size()==4);
 
     vec3d p = this->poly_vert(pid,0) * bc.at(0) +
@@ -1034,6 +1057,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::poly_split(const uint pid, const vec3d & p)
 {
+    this->topology_thaw();
     uint vid = this->vert_add(p);
     return this->poly_split(pid,vid);
 }
@@ -1044,6 +1068,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 uint Tetmesh<M,V,E,F,P>::poly_split(const uint pid, const uint vid)
 {
+    this->topology_thaw();
     assert(this->vert_valence(vid)==0);
     for(uint fid : this->adj_p2f(pid))
     {        
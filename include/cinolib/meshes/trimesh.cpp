@@ -174,9 +174,17 @@ bool Trimesh<M,V,E,P>::edge_is_topologically_collapsible(const uint eid) const
 template<class M, class V, class E, class P>
 CINO_INLINE
 bool Trimesh<M,V,E,P>::edge_is_geometrically_collapsible(const uint eid, const double lambda) const
+{
+    return edge_is_geometrically_collapsible(eid, this->edge_sample_at(eid, lambda));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool Trimesh<M,V,E,P>::edge_is_geometrically_collapsible(const uint eid, const vec3d & new_vert) const
 {
     // no triangle should flip or collapse
-    vec3d new_vert = this->edge_sample_at(eid, lambda);
     uint  vid0     = this->edge_vert_id(eid,0);
     uint  vid1     = this->edge_vert_id(eid,1);
 
@@ -277,8 +285,19 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int Trimesh<M,V,E,P>::edge_collapse(const uint eid, const double lambda, const bool topologic_check, const bool geometric_check)
 {
-    if(topologic_check && !edge_is_topologically_collapsible(eid))         return -1;
-    if(geometric_check && !edge_is_geometrically_collapsible(eid, lambda)) return -1;
+    this->topology_thaw();
+    return edge_collapse(eid, this->edge_sample_at(eid, lambda), topologic_check, geometric_check);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+int Trimesh<M,V,E,P>::edge_collapse(const uint eid, const vec3d & p, const bool topologic_check, const bool geometric_check)
+{
+    this->topology_thaw();
+    if(topologic_check && !edge_is_topologically_collapsible(eid))    return -1;
+    if(geometric_check && !edge_is_geometrically_collapsible(eid, p)) return -1;
 
 #ifndef NDEBUG
     int euler_before = this->Euler_characteristic();
@@ -288,7 +307,7 @@ int Trimesh<M,V,E,P>::edge_collapse(const uint eid, const double lambda, const b
     uint vert_to_remove = this->edge_vert_id(eid,1);
     if (vert_to_remove < vert_to_keep) std::swap(vert_to_keep, vert_to_remove); // remove vert with highest ID
 
-    this->vert(vert_to_keep) = this->edge_sample_at(eid, lambda); // reposition vertex
+    this->vert(vert_to_keep) = p; // reposition vertex
 
     for(uint pid : this->adj_v2p(vert_to_remove))
     {
@@ -322,6 +341,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::edge_split(const uint eid, const double lambda)
 {
+    this->topology_thaw();
     vec3d split_point = this->edge_sample_at(eid,lambda);
     uint  v_split     = this->vert_add(split_point);
     return edge_split(eid,v_split);
@@ -333,6 +353,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::edge_split(const uint eid, const vec3d & p)
 {
+    this->topology_thaw();
     uint v_split = this->vert_add(p);
     return edge_split(eid,v_split);
 }
@@ -343,6 +364,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::edge_split(const uint eid, const uint v_split)
 {
+    this->topology_thaw();
     uint vid0 = this->edge_vert_id(eid,0);
     uint vid1 = this->edge_vert_id(eid,1);
 
@@ -434,6 +456,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int Trimesh<M,V,E,P>::edge_flip(const uint eid, const bool geometric_check)
 {
+    this->topology_thaw();
     if(geometric_check && !edge_is_flippable(eid)) return -1;
 
     assert(this->adj_e2p(eid).size()==2);
@@ -449,12 +472,15 @@ int Trimesh<M,V,E,P>::edge_flip(const uint eid, const bool geometric_check)
     this->poly_add(p0);
     this->poly_add(p1);
 
-    this->edge_remove(eid);
-
-    // copy edge data
+    // copy edge data (before removal, which may reassign id eid to another edge)
     int new_eid = this->edge_id(opp0,opp1); assert(new_eid>=0);
     this->edge_data(new_eid) = this->edge_data(eid);
 
+    this->edge_remove(eid);
+
+    // removing eid may have changed the id of the new edge
+    new_eid = this->edge_id(opp0,opp1); assert(new_eid>=0);
+
     return new_eid;
 }
 
@@ -497,6 +523,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::poly_split(const uint pid)
 {
+    this->topology_thaw();
     // uses centroid as default split point
     return this->poly_split(pid, this->poly_centroid(pid));
 }
@@ -507,6 +534,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::poly_split(const uint pid, const vec3d & p)
 {
+    this->topology_thaw();
     uint vids[4] =
     {
         this->poly_vert_id(pid, 0),
@@ -572,6 +600,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint Trimesh<M,V,E,P>::poly_add(const uint vid0, const uint vid1, const uint vid2)
 {
+    this->topology_thaw();
     std::vector<uint> p = { vid0, vid1, vid2 };
     return this->poly_add(p);
 }
@@ -100,8 +100,10 @@ class Trimesh : public AbstractPolygonMesh<M,V,E,P>
 
         uint              edge_opposite_to                 (const uint pid, const uint vid) const;
         int               edge_collapse                    (const uint eid, const double lambda = 0.5, const bool topologic_check = true, const bool geometric_check = true);
+        int               edge_collapse                    (const uint eid, const vec3d & p,           const bool topologic_check = true, const bool geometric_check = true);
         bool              edge_is_collapsible              (const uint eid, const double lambda) const;
         bool              edge_is_geometrically_collapsible(const uint eid, const double lambda) const;
+        bool              edge_is_geometrically_collapsible(const uint eid, const vec3d & p) const;
         bool              edge_is_topologically_collapsible(const uint eid) const;
         uint              edge_split                       (const uint eid, const double lambda = 0.5);
         uint              edge_split                       (const uint eid, const vec3d & p);
@@ -36,33 +36,11 @@
 #include <cinolib/octree.h>
 #include <cinolib/how_many_seconds.h>
 #include <cinolib/parallel_for.h>
-#include <cinolib/geometry/point.h>
-#include <cinolib/geometry/sphere.h>
-#include <cinolib/geometry/segment.h>
-#include <cinolib/geometry/triangle.h>
-#include <cinolib/geometry/tetrahedron.h>
 #include <stack>
 
 namespace cinolib
 {
 
-CINO_INLINE
-OctreeNode::~OctreeNode()
-{
-    // "in a tree's node destructor, you only need to destroy the children pointers that are manually
-    //  allocated by you. You don't need to worry about the deallocation of the node itself."
-    //  https://stackoverflow.com/questions/34170164/destructor-for-binary-search-tree
-    for(int i=0; i<8; ++i)
-    {
-        if(children[i]!=nullptr)
-        {
-            delete children[i];
-        }
-    }
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
 CINO_INLINE
 Octree::Octree(const uint max_depth,
                const uint items_per_leaf)
@@ -72,104 +50,129 @@ Octree::Octree(const uint max_depth,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// creates the 8 octants of box in children (which are consecutive)
 CINO_INLINE
-Octree::~Octree()
+static void make_octants(const AABB & box, OctreeNode *children)
 {
-    // delete Octree
-    if(root!=nullptr) delete root;
+    vec3d min = box.min;
+    vec3d max = box.max;
+    vec3d avg = box.center();
+    children[0].bbox = AABB(vec3d(min[0], min[1], min[2]), vec3d(avg[0], avg[1], avg[2]));
+    children[1].bbox = AABB(vec3d(avg[0], min[1], min[2]), vec3d(max[0], avg[1], avg[2]));
+    children[2].bbox = AABB(vec3d(avg[0], avg[1], min[2]), vec3d(max[0], max[1], avg[2]));
+    children[3].bbox = AABB(vec3d(min[0], avg[1], min[2]), vec3d(avg[0], max[1], avg[2]));
+    children[4].bbox = AABB(vec3d(min[0], min[1], avg[2]), vec3d(avg[0], avg[1], max[2]));
+    children[5].bbox = AABB(vec3d(avg[0], min[1], avg[2]), vec3d(max[0], avg[1], max[2]));
+    children[6].bbox = AABB(vec3d(avg[0], avg[1], avg[2]), vec3d(max[0], max[1], max[2]));
+    children[7].bbox = AABB(vec3d(min[0], avg[1], avg[2]), vec3d(avg[0], max[1], max[2]));
+}
 
-    // delete item list
-    while(!items.empty())
-    {
-        delete items.back();
-        items.pop_back();
-    }
+// returns a mask where bit i is set if box overlaps the i-th octant of a node centered at c.
+// As long as box overlaps the node, this is equivalent to testing it against each octant
+CINO_INLINE
+static uint octants_mask(const AABB & box, const vec3d & c)
+{
+    uint m = 0xFF;
+    m &= (box.min[0]<=c[0] ? 0x99 : 0) | (box.max[0]>=c[0] ? 0x66 : 0); // x: octants 0,3,4,7 | 1,2,5,6
+    m &= (box.min[1]<=c[1] ? 0x33 : 0) | (box.max[1]>=c[1] ? 0xCC : 0); // y: octants 0,1,4,5 | 2,3,6,7
+    m &= (box.min[2]<=c[2] ? 0x0F : 0) | (box.max[2]>=c[2] ? 0xF0 : 0); // z: octants 0,1,2,3 | 4,5,6,7
+    assert(m!=0);
+    return m;
+}
+
+// returns the position of the lowest set bit of a non zero 8 bits mask (De Bruijn multiplication)
+CINO_INLINE
+static uint lowest_bit(const uint m)
+{
+    static const uint table[8] = { 0, 1, 2, 4, 7, 3, 6, 5 };
+    return table[(((m & (~m+1)) * 0x17) >> 5) & 7];
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// The top levels of the tree are split breadth first, using all threads to split each node, until
+// there are enough subtrees to keep all threads busy. Subtrees are then built depth first in parallel,
+// each by a single thread, and eventually appended to the node array. No node owns any memory, and
+// memory is allocated a few times per level (top levels) or per subtree (bottom levels).
+// Note: the tree is built top down rather than bottom up from Morton sorted items (as done for
+// BVHs/LBVHs), because items with extent are referenced by every leaf they overlap, and the leaf
+// an item falls into is not known until its ancestors are split. See example 57 for timings
 CINO_INLINE
 void Octree::build()
 {
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
+    nodes.clear();
+    leaf_items.clear();
+    leaves.clear();
+    tree_depth = 0;
+
     if(items.empty()) return;
 
     // initialize root with all items, also updating its AABB
-    assert(root==nullptr);
-    root = new OctreeNode(AABB());
-    root->item_indices.resize(items.size());
-    std::iota(root->item_indices.begin(),root->item_indices.end(),0);
-    for(auto it : items) root->bbox.push(it->aabb);
+    nodes.emplace_back();
+    nodes[0].bbox = PARALLEL_REDUCE(0, items.size(), 1000, AABB(), [&](const uint i, AABB & acc)
+    {
+        acc.push(items.aabb(i));
+    },
+    [](AABB b0, const AABB & b1)
+    {
+        // note: b0.push(b1) would break if b1 is empty (i.e. min=inf, max=-inf)
+        b0.min = b0.min.min(b1.min);
+        b0.max = b0.max.max(b1.max);
+        return b0;
+    });
 
-    root->bbox.scale(1.5); // enlarge bbox to account for queries outside legal area.
-                           // this should disappear eventually....
+    nodes[0].bbox.scale(1.5); // enlarge bbox to account for queries outside legal area.
+                              // this should disappear eventually....
+    tree_depth = 1;
 
-    if(root->item_indices.size()<items_per_leaf || max_depth==1)
+    if(items.size()<items_per_leaf || max_depth==1)
     {
-        leaves.push_back(root);
-        tree_depth = 1;
+        nodes[0].count = items.size();
+        leaf_items.resize(items.size());
+        std::iota(leaf_items.begin(), leaf_items.end(), 0);
+        leaves.push_back(0);
     }
     else
     {
-        subdivide(root);
-
-        if(max_depth==2)
+        std::vector<Subtree> subtrees(1);
+        subtrees[0].root  = 0;
+        subtrees[0].depth = 1;
+        subtrees[0].item_indices.resize(items.size());
+        std::iota(subtrees[0].item_indices.begin(), subtrees[0].item_indices.end(), 0);
+
+        const uint min_subtrees = 64;
+        while(!subtrees.empty() && subtrees.size()<min_subtrees)
         {
-            tree_depth = 2;
-            for(int i=0; i<8; ++i) leaves.push_back(root->children[i]);
+            std::vector<Subtree> next;
+            for(Subtree & s : subtrees) split(s, next);
+            subtrees.swap(next);
         }
-        else
-        {
-            // WORK IN PARALLEL ON EACH OCTANT
-            // To fully avoid syncrhonization between the threads global information
-            // such as vector of leaves and tree depth are duplicated, and will be
-            // merged after convergence.
-
-            uint octant_depth[8] = { 2, 2, 2, 2, 2, 2, 2, 2 };
-            std::vector<const OctreeNode*> octant_leaves[8];
-
-            std::queue<std::pair<OctreeNode*,uint>> splitlist[8]; // (node, depth)
-            for(int i=0; i<8; ++i)
-            {
-                if(root->children[i]->item_indices.size()>items_per_leaf)
-                {
-                    splitlist[i].push(std::make_pair(root->children[i],2));
-                }
-                else octant_leaves[i].push_back(root->children[i]);
-            }
 
-            PARALLEL_FOR(0,8,0,[&](uint i)
-            {
-                while(!splitlist[i].empty())
-                {
-                    auto pair  = splitlist[i].front();
-                    auto node  = pair.first;
-                    uint depth = pair.second + 1;
-                    splitlist[i].pop();
-
-                    subdivide(node);
-
-                    for(int j=0; j<8; ++j)
-                    {
-                        if(depth<max_depth && node->children[j]->item_indices.size()>items_per_leaf)
-                        {
-                            splitlist[i].push(std::make_pair(node->children[j], depth));
-                        }
-                        else octant_leaves[i].push_back(node->children[j]);
-                    }
-
-                    octant_depth[i] = std::max(octant_depth[i], depth);
-                }
-            });
+        PARALLEL_FOR(0, subtrees.size(), 2, 0, 1, [&](const uint i)
+        {
+            build_subtree(subtrees[i]);
+        });
 
-            // global merge of octant data
-            tree_depth = *std::max_element(octant_depth, octant_depth+8);
-            for(int i=0; i<8; ++i)
+        // move subtrees into the tree. The subtree root is local node zero,
+        // and local node i>0 goes at position nodes.size()+i-1
+        for(const Subtree & s : subtrees)
+        {
+            uint node_base = nodes.size() - 1;
+            uint leaf_base = leaf_items.size();
+            for(uint i=0; i<s.nodes.size(); ++i)
             {
-                std::copy(octant_leaves[i].begin(), octant_leaves[i].end(), std::back_inserter(leaves));
+                OctreeNode node = s.nodes[i];
+                if(node.is_inner()) node.children += node_base;
+                else                node.offset   += leaf_base;
+                if(i==0) nodes[s.root] = node;
+                else     nodes.push_back(node);
             }
+            for(uint l : s.leaves) leaves.push_back(l==0 ? s.root : l+node_base);
+            leaf_items.insert(leaf_items.end(), s.leaf_items.begin(), s.leaf_items.end());
+            tree_depth = std::max(tree_depth, s.tree_depth);
         }
     }
 
@@ -191,38 +194,172 @@ void Octree::build()
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// splits the root of subtree s using all threads. Items are processed in fixed blocks: each block
+// first counts how many of its items go into each octant, then copies them in their final position.
+// Children that must be further split are appended to next, the others become leaves
 CINO_INLINE
-void Octree::subdivide(OctreeNode * node)
+void Octree::split(Subtree & s, std::vector<Subtree> & next)
 {
-    // create children octants
-    vec3d min = node->bbox.min;
-    vec3d max = node->bbox.max;
-    vec3d avg = node->bbox.center();
-    node->children[0] = new OctreeNode(AABB(vec3d(min[0], min[1], min[2]), vec3d(avg[0], avg[1], avg[2])));
-    node->children[1] = new OctreeNode(AABB(vec3d(avg[0], min[1], min[2]), vec3d(max[0], avg[1], avg[2])));
-    node->children[2] = new OctreeNode(AABB(vec3d(avg[0], avg[1], min[2]), vec3d(max[0], max[1], avg[2])));
-    node->children[3] = new OctreeNode(AABB(vec3d(min[0], avg[1], min[2]), vec3d(avg[0], max[1], avg[2])));
-    node->children[4] = new OctreeNode(AABB(vec3d(min[0], min[1], avg[2]), vec3d(avg[0], avg[1], max[2])));
-    node->children[5] = new OctreeNode(AABB(vec3d(avg[0], min[1], avg[2]), vec3d(max[0], avg[1], max[2])));
-    node->children[6] = new OctreeNode(AABB(vec3d(avg[0], avg[1], avg[2]), vec3d(max[0], max[1], max[2])));
-    node->children[7] = new OctreeNode(AABB(vec3d(min[0], avg[1], avg[2]), vec3d(avg[0], max[1], max[2])));
-
-    for(uint it : node->item_indices)
-    {
-        bool orphan = true;
-        for(int i=0; i<8; ++i)
+    uint first = nodes.size();
+    nodes.resize(first + 8);
+    nodes[s.root].children = first;
+    make_octants(nodes[s.root].bbox, &nodes[first]);
+    vec3d c = nodes[s.root].bbox.center();
+
+    const uint n        = s.item_indices.size();
+    const uint n_blocks = std::min(64u, (n+8191)/8192);
+    const uint block    = (n + n_blocks - 1) / n_blocks;
+    std::vector<uint8_t> masks(n);
+    std::vector<uint>    count(8*n_blocks);
+    PARALLEL_FOR(0, n_blocks, 2, 0, 1, [&](const uint b)
+    {
+        uint cnt[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        for(uint j=b*block; j<std::min(n,(b+1)*block); ++j)
         {
-            assert(node->children[i]!=nullptr);
-            if(node->children[i]->bbox.intersects_box(items.at(it)->aabb))
-            {
-                node->children[i]->item_indices.push_back(it);
-                orphan = false;
-            }
+            uint m = octants_mask(items.aabb(s.item_indices[j]), c);
+            for(uint k=0; k<8; ++k) cnt[k] += (m >> k) & 1;
+            masks[j] = uint8_t(m);
+        }
+        std::copy(cnt, cnt+8, &count[8*b]);
+    });
+
+    // turn counts into positions in the items of each child
+    uint child_size[8];
+    for(uint k=0; k<8; ++k)
+    {
+        uint sum = 0;
+        for(uint b=0; b<n_blocks; ++b)
+        {
+            uint tmp = count[8*b+k];
+            count[8*b+k] = sum;
+            sum += tmp;
+        }
+        child_size[k] = sum;
+    }
+
+    uint depth = s.depth + 1;
+    tree_depth = std::max(tree_depth, depth);
+    uint slot[8];
+    for(uint k=0; k<8; ++k)
+    {
+        if(depth<max_depth && child_size[k]>items_per_leaf)
+        {
+            slot[k] = next.size();
+            next.emplace_back();
+            next.back().root  = first + k;
+            next.back().depth = depth;
+            next.back().item_indices.resize(child_size[k]);
+        }
+        else
+        {
+            slot[k] = max_uint;
+            nodes[first+k].offset = leaf_items.size();
+            nodes[first+k].count  = child_size[k];
+            leaf_items.resize(leaf_items.size() + child_size[k]);
+            leaves.push_back(first + k);
+        }
+    }
+    uint *dest[8];
+    for(uint k=0; k<8; ++k)
+    {
+        dest[k] = (slot[k]!=max_uint) ? next[slot[k]].item_indices.data() : leaf_items.data() + nodes[first+k].offset;
+    }
+
+    PARALLEL_FOR(0, n_blocks, 2, 0, 1, [&](const uint b)
+    {
+        uint *pos[8];
+        for(uint k=0; k<8; ++k) pos[k] = dest[k] + count[8*b+k];
+        for(uint j=b*block; j<std::min(n,(b+1)*block); ++j)
+        {
+            for(uint m=masks[j]; m!=0; m&=m-1) *pos[lowest_bit(m)]++ = s.item_indices[j];
+        }
+    });
+
+    s.item_indices.clear();
+    s.item_indices.shrink_to_fit();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// builds subtree s depth first, storing its nodes and leaves locally
+CINO_INLINE
+void Octree::build_subtree(Subtree & s) const
+{
+    s.nodes.assign(1, nodes[s.root]);
+    s.tree_depth = s.depth;
+
+    // the subtree works on a local copy of the AABBs of its items, which is
+    // small enough to be accessed much faster than the global item pool
+    std::vector<AABB> boxes(s.item_indices.size());
+    for(uint i=0; i<s.item_indices.size(); ++i) boxes[i] = items.aabb(s.item_indices[i]);
+
+    std::vector<uint> buf(s.item_indices.size());
+    std::iota(buf.begin(), buf.end(), 0);
+    std::vector<uint8_t> masks;
+    split_subtree_node(s, 0, s.depth, 0, s.item_indices.size(), s.item_indices.size(), boxes, buf, masks);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits local node nid of subtree s, which contains the (local) items buf[beg...end). Items of its children
+// are stored from buf[top] on, and buf is used as a stack: once the children are done, their space is reused
+CINO_INLINE
+void Octree::split_subtree_node(Subtree & s, const uint nid, const uint nid_depth, const uint beg, const uint end, const uint top,
+                                const std::vector<AABB> & boxes, std::vector<uint> & buf, std::vector<uint8_t> & masks) const
+{
+    uint first = s.nodes.size();
+    s.nodes.resize(first + 8);
+    s.nodes[nid].children = first;
+    make_octants(s.nodes[nid].bbox, &s.nodes[first]);
+    vec3d c = s.nodes[nid].bbox.center();
+
+    if(masks.size()<end) masks.resize(end);
+    uint count[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    uint    *item = buf.data();
+    uint8_t *mask = masks.data();
+    for(uint j=beg; j<end; ++j)
+    {
+        uint m = octants_mask(boxes[item[j]], c);
+        for(uint k=0; k<8; ++k) count[k] += (m >> k) & 1;
+        mask[j] = uint8_t(m);
+    }
+
+    uint depth   = nid_depth + 1;
+    s.tree_depth = std::max(s.tree_depth, depth);
+
+    uint pos[8];
+    uint child_top = top;
+    for(uint k=0; k<8; ++k)
+    {
+        pos[k] = child_top;
+        child_top += count[k];
+    }
+    if(buf.size()<child_top) buf.resize(child_top);
+
+    item = buf.data();
+    for(uint j=beg; j<end; ++j)
+    {
+        for(uint m=mask[j]; m!=0; m&=m-1) item[pos[lowest_bit(m)]++] = item[j];
+    }
+
+    bool inner[8];
+    for(uint k=0; k<8; ++k)
+    {
+        inner[k] = (depth<max_depth && count[k]>items_per_leaf);
+        if(!inner[k])
+        {
+            uint offset = s.leaf_items.size();
+            s.nodes[first+k].offset = offset;
+            s.nodes[first+k].count  = count[k];
+            for(uint j=pos[k]-count[k]; j<pos[k]; ++j) s.leaf_items.push_back(s.item_indices[buf[j]]);
+            s.leaves.push_back(first + k);
         }
-        assert(!orphan);
     }
 
-    node->item_indices.clear();
+    for(uint k=0; k<8; ++k)
+    {
+        if(inner[k]) split_subtree_node(s, first+k, depth, pos[k]-count[k], pos[k], child_top, boxes, buf, masks);
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -230,7 +367,7 @@ void Octree::subdivide(OctreeNode * node)
 CINO_INLINE
 void Octree::push_point(const uint id, const vec3d & v)
 {
-    items.push_back(new Point(id,v));
+    items.push_point(id,v);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -238,7 +375,7 @@ void Octree::push_point(const uint id, const vec3d & v)
 CINO_INLINE
 void Octree::push_sphere(const uint id, const vec3d & c, const double r)
 {
-    items.push_back(new Sphere(id,c,r));
+    items.push_sphere(id,c,r);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -246,7 +383,7 @@ void Octree::push_sphere(const uint id, const vec3d & c, const double r)
 CINO_INLINE
 void Octree::push_segment(const uint id, const vec3d & v0, const vec3d & v1)
 {
-    items.push_back(new Segment(id,v0,v1));
+    items.push_segment(id,v0,v1);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -254,7 +391,7 @@ void Octree::push_segment(const uint id, const vec3d & v0, const vec3d & v1)
 CINO_INLINE
 void Octree::push_triangle(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2)
 {
-    items.push_back(new Triangle(id,v0,v1,v2));
+    items.push_triangle(id,v0,v1,v2);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -262,7 +399,7 @@ void Octree::push_triangle(const uint id, const vec3d & v0, const vec3d & v1, co
 CINO_INLINE
 void Octree::push_tetrahedron(const uint id, const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & v3)
 {
-    items.push_back(new Tetrahedron(id,v0,v1,v2,v3));
+    items.push_tetrahedron(id,v0,v1,v2,v3);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -271,7 +408,7 @@ CINO_INLINE
 uint Octree::max_items_per_leaf() const
 {
     uint max=0;
-    for(auto l : leaves) max = std::max(max,(uint)l->item_indices.size());
+    for(uint l : leaves) max = std::max(max,nodes[l].count);
     return max;
 }
 
@@ -304,27 +441,28 @@ void Octree::closest_point(const vec3d  & p,            // query point
                                  vec3d  & pos,          // point in T closest to p
                                  double & d_sqrd) const // SQUARED distance between pos and p
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
     PrioQueue q;
-    if(root->is_inner())
+    if(root()->is_inner())
     {
         Obj obj;
-        obj.node = root;
-        obj.dist = root->bbox.dist_sqrd(p);
+        obj.node = root();
+        obj.dist = root()->bbox.dist_sqrd(p);
         q.push(obj);
     }
     else // in case the root is alrady a leaf...
     {
-        for(uint index : root->item_indices)
+        for(uint k=root()->offset; k<root()->offset+root()->count; ++k)
         {
+            uint index = leaf_items[k];
             Obj obj;
-            obj.node  = root;
+            obj.node  = root();
             obj.index = index;
-            obj.pos   = items.at(index)->point_closest_to(p);
+            obj.pos   = items.point_closest_to(index,p);
             obj.dist  = obj.pos.dist_sqrd(p);
             q.push(obj);
         }
@@ -337,7 +475,7 @@ void Octree::closest_point(const vec3d  & p,            // query point
 
         for(int i=0; i<8; ++i)
         {
-            OctreeNode *child = obj.node->children[i];
+            const OctreeNode *child = node_child(obj.node,i);
             if(child->is_inner())
             {
                 Obj obj;
@@ -347,12 +485,13 @@ void Octree::closest_point(const vec3d  & p,            // query point
             }
             else
             {
-                for(uint index : child->item_indices)
+                for(uint k=child->offset; k<child->offset+child->count; ++k)
                 {
+                    uint index = leaf_items[k];
                     Obj obj;
                     obj.node  = child;
                     obj.index = index;
-                    obj.pos   = items.at(index)->point_closest_to(p);
+                    obj.pos   = items.point_closest_to(index,p);
                     obj.dist  = obj.pos.dist_sqrd(p);
                     q.push(obj);
                 }
@@ -367,7 +506,7 @@ void Octree::closest_point(const vec3d  & p,            // query point
     }
 
     assert(q.top().index>=0);
-    id   = items.at(q.top().index)->id;
+    id   = items.id(q.top().index);
     pos  = q.top().pos;
     d_sqrd = q.top().dist;
 }
@@ -378,20 +517,20 @@ void Octree::closest_point(const vec3d  & p,            // query point
 CINO_INLINE
 bool Octree::contains(const vec3d & p, const bool strict, uint & id) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
-    std::stack<OctreeNode*> lifo;
-    if(root && root->bbox.contains(p,strict))
+    std::stack<const OctreeNode*> lifo;
+    if(root() && root()->bbox.contains(p,strict))
     {
-        lifo.push(root);
+        lifo.push(root());
     }
 
     while(!lifo.empty())
     {
-        OctreeNode *node = lifo.top();
+        const OctreeNode *node = lifo.top();
         lifo.pop();
         assert(node->bbox.contains(p, strict));
 
@@ -399,16 +538,17 @@ bool Octree::contains(const vec3d & p, const bool strict, uint & id) const
         {
             for(int i=0; i<8; ++i)
             {
-                if(node->children[i]->bbox.contains(p,strict)) lifo.push(node->children[i]);
+                if(node_child(node,i)->bbox.contains(p,strict)) lifo.push(node_child(node,i));
             }
         }
         else
         {
-            for(uint i : node->item_indices)
+            for(uint k=node->offset; k<node->offset+node->count; ++k)
             {
-                if(items.at(i)->contains(p,strict))
+                uint i = leaf_items[k];
+                if(items.contains(i,p,strict))
                 {
-                    id = items.at(i)->id;
+                    id = items.id(i);
                     if(print_debug_info)
                     {
                         Time::time_point t1 = Time::now();
@@ -429,20 +569,20 @@ bool Octree::contains(const vec3d & p, const bool strict, uint & id) const
 CINO_INLINE
 bool Octree::contains(const vec3d & p, const bool strict, std::unordered_set<uint> & ids) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
-    std::stack<OctreeNode*> lifo;
-    if(root && root->bbox.contains(p,strict))
+    std::stack<const OctreeNode*> lifo;
+    if(root() && root()->bbox.contains(p,strict))
     {
-        lifo.push(root);
+        lifo.push(root());
     }
 
     while(!lifo.empty())
     {
-        OctreeNode *node = lifo.top();
+        const OctreeNode *node = lifo.top();
         lifo.pop();
         assert(node->bbox.contains(p,strict));
 
@@ -450,16 +590,17 @@ bool Octree::contains(const vec3d & p, const bool strict, std::unordered_set<uin
         {
             for(int i=0; i<8; ++i)
             {
-                if(node->children[i]->bbox.contains(p,strict)) lifo.push(node->children[i]);
+                if(node_child(node,i)->bbox.contains(p,strict)) lifo.push(node_child(node,i));
             }
         }
         else
         {
-            for(uint i : node->item_indices)
+            for(uint k=node->offset; k<node->offset+node->count; ++k)
             {
-                if(items.at(i)->contains(p,strict))
+                uint i = leaf_items[k];
+                if(items.contains(i,p,strict))
                 {
-                    ids.insert(items.at(i)->id);
+                    ids.insert(items.id(i));
                 }
             }
         }
@@ -479,16 +620,16 @@ bool Octree::contains(const vec3d & p, const bool strict, std::unordered_set<uin
 CINO_INLINE
 bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
     vec3d  pos;
     double t=0.0;
-    if(root && !root->bbox.intersects_ray(p, dir, t, pos)) return false;
+    if(root() && !root()->bbox.intersects_ray(p, dir, t, pos)) return false;
     Obj obj;
-    obj.node = root;
+    obj.node = root();
     obj.dist = t;
 
     PrioQueue q;
@@ -501,7 +642,7 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
 
         for(int i=0; i<8; ++i)
         {
-            OctreeNode *child = obj.node->children[i];
+            const OctreeNode *child = node_child(obj.node,i);
             if(child->bbox.intersects_ray(p, dir, t, pos))
             {
                 if(child->is_inner())
@@ -513,13 +654,14 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
                 }
                 else
                 {
-                    for(uint i : child->item_indices)
+                    for(uint k=child->offset; k<child->offset+child->count; ++k)
                     {
-                        if(items.at(i)->intersects_ray(p, dir, t, pos))
+                        uint i = leaf_items[k];
+                        if(items.intersects_ray(i, p, dir, t, pos))
                         {
                             Obj obj;
                             obj.node  = child;
-                            obj.index = items.at(i)->id;
+                            obj.index = i;
                             obj.dist  = t;
                             q.push(obj);
                         }
@@ -537,7 +679,7 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
 
     if(q.empty()) return false;
     assert(q.top().index>=0);
-    id    = items.at(q.top().index)->id;
+    id    = items.id(q.top().index);
     min_t = q.top().dist;
     return true;
 }
@@ -547,16 +689,16 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
 CINO_INLINE
 bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,uint>> & all_hits) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
     vec3d  pos;
     double t=0.0;
-    if(root && !root->bbox.intersects_ray(p, dir, t, pos)) return false;
+    if(root() && !root()->bbox.intersects_ray(p, dir, t, pos)) return false;
     Obj obj;
-    obj.node = root;
+    obj.node = root();
     obj.dist = t;
 
     PrioQueue q;
@@ -569,7 +711,7 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
 
         for(int i=0; i<8; ++i)
         {
-            OctreeNode *child = obj.node->children[i];
+            const OctreeNode *child = node_child(obj.node,i);
             if(child->bbox.intersects_ray(p, dir, t, pos))
             {
                 if(child->is_inner())
@@ -581,11 +723,12 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
                 }
                 else
                 {
-                    for(uint i : child->item_indices)
+                    for(uint k=child->offset; k<child->offset+child->count; ++k)
                     {
-                        if(items.at(i)->intersects_ray(p, dir, t, pos))
+                        uint i = leaf_items[k];
+                        if(items.intersects_ray(i, p, dir, t, pos))
                         {
-                            all_hits.insert(std::make_pair(t,items.at(i)->id));
+                            all_hits.insert(std::make_pair(t,items.id(i)));
                         }
                     }
                 }
@@ -606,24 +749,49 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+void Octree::intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,
+                                   std::vector<uint>   & ids) const
+{
+    trace_rays(p, dir, skip_ids, min_t, ids, nullptr);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Octree::intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,
+                                   std::vector<uint>   & ids,
+                                   std::vector<uint>   & n_hits) const
+{
+    trace_rays(p, dir, skip_ids, min_t, ids, &n_hits);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
 CINO_INLINE
 bool Octree::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
     std::unordered_set<uint> tmp;
     std::vector<vec3d> list = {t[0],t[1],t[2]};
-    intersects_box(AABB(list), tmp);
+    items_in_box(AABB(list), tmp);
 
     for(uint i : tmp)
     {
-        if(items.at(i)->intersects_triangle(t, ignore_if_valid_complex))
+        if(items.intersects_triangle(i, t, ignore_if_valid_complex))
         {
-            ids.insert(items.at(i)->id);
+            ids.insert(items.id(i));
         }
     }
 
@@ -642,19 +810,19 @@ bool Octree::intersects_triangle(const vec3d t[], const bool ignore_if_valid_com
 CINO_INLINE
 bool Octree::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
     std::unordered_set<uint> tmp;
-    intersects_box(AABB(s[0],s[1]), tmp);
+    items_in_box(AABB(s[0],s[1]), tmp);
 
     for(uint i : tmp)
     {
-        if(items.at(i)->intersects_segment(s, ignore_if_valid_complex))
+        if(items.intersects_segment(i, s, ignore_if_valid_complex))
         {
-            ids.insert(items.at(i)->id);
+            ids.insert(items.id(i));
         }
     }
 
@@ -676,52 +844,178 @@ bool Octree::intersects_segment(const vec3d s[], const bool ignore_if_valid_comp
 CINO_INLINE
 bool Octree::intersects_box(const AABB & b, std::unordered_set<uint> & ids) const
 {
-    assert(root != nullptr);
+    assert(root() != nullptr);
 
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
-    std::stack<OctreeNode*> lifo;
-    if(root && root->bbox.intersects_box(b))
+    std::unordered_set<uint> tmp;
+    items_in_box(b, tmp);
+    for(uint i : tmp) ids.insert(items.id(i));
+
+    if(print_debug_info)
     {
-        lifo.push(root);
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects box\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// collects the indices (NOT the ids) of all items with AABB intersecting box b
+CINO_INLINE
+void Octree::items_in_box(const AABB & b, std::unordered_set<uint> & indices) const
+{
+    std::stack<const OctreeNode*> lifo;
+    if(root() && root()->bbox.intersects_box(b))
+    {
+        lifo.push(root());
     }
 
     while(!lifo.empty())
-    {        
-        OctreeNode *node = lifo.top();
+    {
+        const OctreeNode *node = lifo.top();
         lifo.pop();
         assert(node->bbox.intersects_box(b));
 
         if(node->is_inner())
-        {            
+        {
             for(int i=0; i<8; ++i)
             {
-                if(node->children[i]->bbox.intersects_box(b))
+                if(node_child(node,i)->bbox.intersects_box(b))
                 {
-                    lifo.push(node->children[i]);
+                    lifo.push(node_child(node,i));
                 }
             }
         }
         else
         {
-            for(uint i : node->item_indices)
+            for(uint k=node->offset; k<node->offset+node->count; ++k)
             {
-                if(items.at(i)->aabb.intersects_box(b))
+                uint i = leaf_items[k];
+                if(items.aabb(i).intersects_box(b))
                 {
-                    ids.insert(items.at(i)->id);
+                    indices.insert(i);
                 }
             }
         }
     }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// in first hit mode children are visited front to back, and nodes are tested again when popped from
+// the stack if, in the meantime, rays have been clipped by a closer hit
+CINO_INLINE
+void Octree::trace_packet(RayPacket & packet, std::vector<RayPacket::StackEntry<const OctreeNode*>> & stack) const
+{
+    typedef RayPacket::StackEntry<const OctreeNode*> Entry;
+    double t[RAY_PACKET_SIZE];
+
+    stack.clear();
+    uint mask = packet.intersects_box(root()->bbox.min.ptr(), root()->bbox.max.ptr(), packet.rays(), t);
+    if(mask) stack.push_back(Entry{root(), mask, 0});
+    while(!stack.empty())
+    {
+        Entry e = stack.back();
+        stack.pop_back();
+
+        const OctreeNode *node = e.node;
+        mask = e.mask;
+        if(e.clips!=packet.clips)
+        {
+            mask = packet.intersects_box(node->bbox.min.ptr(), node->bbox.max.ptr(), mask, t);
+            if(!mask) continue;
+        }
+
+        if(node->is_inner())
+        {
+            // push the hit children by decreasing distance, so that the closest one is popped first
+            uint   n = 0;
+            uint   child[8], child_mask[8];
+            double child_dist[8];
+            for(uint i=0; i<8; ++i)
+            {
+                const OctreeNode *c = node_child(node,i);
+                uint m = packet.intersects_box(c->bbox.min.ptr(), c->bbox.max.ptr(), mask, t);
+                if(!m) continue;
+                double d = inf_double;
+                for(uint j=0; j<RAY_PACKET_SIZE; ++j) if(m & (1u << j)) d = std::min(d, t[j]);
+                // insertion sort
+                uint k = n++;
+                for(; k>0 && child_dist[k-1]<d; --k)
+                {
+                    child     [k] = child     [k-1];
+                    child_mask[k] = child_mask[k-1];
+                    child_dist[k] = child_dist[k-1];
+                }
+                child     [k] = i;
+                child_mask[k] = m;
+                child_dist[k] = d;
+            }
+            for(uint i=0; i<n; ++i) stack.push_back(Entry{node_child(node,child[i]), child_mask[i], packet.clips});
+        }
+        else if(node->count>0)
+        {
+            packet.intersects_items(items, &leaf_items[node->offset], node->count, mask);
+        }
+    }
+    packet.finalize();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// if n_hits is null only first hits are searched, otherwise all hits are collected and counted
+CINO_INLINE
+void Octree::trace_rays(const std::vector<vec3d>  & p,
+                        const std::vector<vec3d>  & dir,
+                        const std::vector<uint>   & skip_ids,
+                              std::vector<double> & min_t,
+                              std::vector<uint>   & ids,
+                              std::vector<uint>   * n_hits) const
+{
+    assert(p.size()==dir.size());
+    assert(skip_ids.empty() || skip_ids.size()==p.size());
+
+    typedef std::chrono::steady_clock Time;
+    Time::time_point t0 = Time::now();
+
+    uint n_rays = p.size();
+    min_t.assign(n_rays, inf_double);
+    ids.assign(n_rays, max_uint);
+    if(n_hits) n_hits->assign(n_rays, 0);
+    if(n_rays==0 || root()==nullptr) return;
+
+    // threads process blocks of packets, reusing the same scratch buffers
+    const uint block_size = 16*RAY_PACKET_SIZE;
+    uint n_blocks = (n_rays + block_size - 1) / block_size;
+    PARALLEL_FOR(0, n_blocks, 2, 0, 1, [&](const uint b)
+    {
+        RayPacket packet;
+        std::vector<RayPacket::StackEntry<const OctreeNode*>> stack;
+        stack.reserve(7*tree_depth+8);
+        uint end = std::min(n_rays, (b+1)*block_size);
+        for(uint beg=b*block_size; beg<end; beg+=RAY_PACKET_SIZE)
+        {
+            uint size = std::min(RAY_PACKET_SIZE, end-beg);
+            packet.set(&p[beg], &dir[beg], skip_ids.empty() ? nullptr : &skip_ids[beg], size, n_hits!=nullptr);
+            trace_packet(packet, stack);
+            for(uint i=0; i<size; ++i)
+            {
+                min_t[beg+i] = packet.min_t[i];
+                ids  [beg+i] = packet.id[i];
+                if(n_hits) n_hits->at(beg+i) = packet.n_hits[i];
+            }
+        }
+    });
 
     if(print_debug_info)
     {
         Time::time_point t1 = Time::now();
-        std::cout << "Intersects box\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+        std::cout << "Intersects " << n_rays << " rays\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
     }
-
-    return !ids.empty();
 }
 
 }
@@ -36,22 +36,26 @@
 #ifndef CINO_OCTREE_H
 #define CINO_OCTREE_H
 
-#include <cinolib/geometry/spatial_data_structure_item.h>
+#include <cinolib/geometry/spatial_item_pool.h>
+#include <cinolib/geometry/ray_packet.h>
 #include <cinolib/meshes/meshes.h>
 #include <queue>
 
 namespace cinolib
 {
 
+// Nodes live in a contiguous array (Octree::nodes), with the root at position zero and the 8 children
+// of each inner node stored consecutively. Leaves do not own their items, but reference a range of
+// Octree::leaf_items, which in turn indexes Octree::items. This way the same item can be referenced by
+// all the leaves it overlaps without making copies of it, and the tree has no per-node allocations
 class OctreeNode
 {
     public:
-        OctreeNode(const AABB & bbox) : bbox(bbox) {}
-       ~OctreeNode();
-        AABB              bbox;
-        std::vector<uint> item_indices; // index Octree::items, avoiding to store a copy of the same object multiple times in each node it appears
-        OctreeNode       *children[8] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
-        bool              is_inner() const { return children[0]!=nullptr; }
+        AABB bbox;
+        uint children = 0; // inner nodes: position of the first child in Octree::nodes (zero for leaves, as the root is no one's child)
+        uint offset   = 0; // leaves: first item in Octree::leaf_items
+        uint count    = 0; // leaves: number of items
+        bool is_inner() const { return children!=0; }
 };
 // https://stackoverflow.com/questions/4306186/structure-padding-and-packing
 // http://www.catb.org/esr/structure-packing/
@@ -63,6 +67,15 @@ class OctreeNode
  *  i)   Create an empty octree
  *  ii)  Use the push_segment/triangle/tetrahedron facilities to populate it
  *  iii) Call build to make the tree
+ *
+ * Memory layout: items are stored by value in a SpatialItemPool (Octree::items), which keeps
+ * the vertices of each type of primitive in its own array and is accessed through an item index
+ * (use items.id(index) to get the id passed to push_*). Nodes are stored in the flat array
+ * Octree::nodes (see OctreeNode), and root() points into it. This replaced a layout where each
+ * item and each node were separately heap allocated, with items held as pointers to the virtual
+ * SpatialDataStructureItem interface and nodes linked through child pointers. Code that accessed
+ * Octree::items or walked the nodes directly must be ported accordingly. Example 56 compares
+ * the two layouts
 */
 
 class Octree
@@ -72,7 +85,7 @@ class Octree
         explicit Octree(const uint max_depth      = 7,
                         const uint items_per_leaf = 50);
 
-        virtual ~Octree();
+        virtual ~Octree() {}
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -88,10 +101,6 @@ class Octree
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        void subdivide(OctreeNode *node);
-
-        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
         template<class M, class V, class E, class P>
         void build_from_mesh_polys(const AbstractPolygonMesh<M,V,E,P> & m)
         {
@@ -116,7 +125,7 @@ class Octree
         void build_from_mesh_polys(const AbstractPolyhedralMesh<M,V,E,F,P> & m)
         {
             assert(items.empty());
-            items.reserve(m.num_polys());
+            items.reserve(m.num_polys(), TETRAHEDRON);
             for(uint pid=0; pid<m.num_polys(); ++pid)
             {
                 switch(m.mesh_type())
@@ -154,7 +163,7 @@ class Octree
         void build_from_mesh_edges(const AbstractMesh<M,V,E,P> & m)
         {
             assert(items.empty());
-            items.reserve(m.num_edges());
+            items.reserve(m.num_edges(), SEGMENT);
             for(uint eid=0; eid<m.num_edges(); ++eid)
             {
                 push_segment(eid, m.edge_vert(eid,0),
@@ -169,7 +178,7 @@ class Octree
         void build_from_mesh_points(const AbstractMesh<M,V,E,P> & m)
         {
             assert(items.empty());
-            items.reserve(m.num_verts());
+            items.reserve(m.num_verts(), POINT);
             for(uint vid=0; vid<m.num_verts(); ++vid)
             {
                 push_point(vid, m.vert(vid));
@@ -201,6 +210,24 @@ class Octree
         bool intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const; // first hit
         bool intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,uint>> & all_hits) const;
 
+        // batched ray queries, for rays R_i(t) := p[i] + t * dir[i]. Rays are traced in packets of
+        // RAY_PACKET_SIZE consecutive rays (see geometry/ray_packet.h), hence they should be sorted so
+        // that consecutive rays are coherent. Packets are distributed among threads. For each ray, hits
+        // with item skip_ids[i] that precede any other hit are ignored (skip_ids can be left empty).
+        // Rays that hit nothing get min_t[i] = inf_double and ids[i] = max_uint
+        void intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,   // first hit
+                                   std::vector<uint>   & ids) const;
+        // also returns the number of hits along each ray, at the price of a full traversal
+        void intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                             const std::vector<uint>   & skip_ids,
+                                   std::vector<double> & min_t,   // first hit
+                                   std::vector<uint>   & ids,
+                                   std::vector<uint>   & n_hits) const;
+
         // note: these queries become exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
         bool intersects_segment (const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
         bool intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
@@ -213,10 +240,13 @@ class Octree
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        const OctreeNode * root() const { return nodes.empty() ? nullptr : &nodes[0]; }
+
         // all items live here, and leaf nodes only store indices to items
-        std::vector<SpatialDataStructureItem*> items;
-        OctreeNode                            *root = nullptr;
-        std::vector<const OctreeNode*>         leaves;
+        SpatialItemPool         items;
+        std::vector<OctreeNode> nodes;      // nodes[0] is the root
+        std::vector<uint>       leaf_items; // item indices of all leaves, stored contiguously leaf by leaf
+        std::vector<uint>       leaves;     // positions of the leaves in nodes
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -231,10 +261,10 @@ class Octree
 
         struct Obj
         {
-            double      dist  = inf_double;
-            OctreeNode *node  = nullptr;
-            int         index = -1; // note: this is the item ID, NOT necessarily the index of vector items!!
-            vec3d       pos;        // closest point
+            double            dist  = inf_double;
+            const OctreeNode *node  = nullptr;
+            int               index = -1; // note: this is the index of the item in the pool, NOT its ID!!
+            vec3d             pos;        // closest point
         };
         struct Greater
         {
@@ -244,6 +274,31 @@ class Octree
             }
         };
         typedef std::priority_queue<Obj,std::vector<Obj>,Greater> PrioQueue;
+
+        // BUILD SUPPORT :::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        struct Subtree
+        {
+            uint                    root;         // position of the subtree root in Octree::nodes
+            uint                    depth;        // depth of the subtree root
+            std::vector<uint>       item_indices; // items of the subtree root
+            std::vector<OctreeNode> nodes;        // local nodes (the subtree root is at position zero)
+            std::vector<uint>       leaf_items;   // local leaf items
+            std::vector<uint>       leaves;       // local leaves
+            uint                    tree_depth;
+        };
+
+        void split             (Subtree & s, std::vector<Subtree> & next);
+        void build_subtree     (Subtree & s) const;
+        void split_subtree_node(Subtree & s, const uint nid, const uint nid_depth, const uint beg, const uint end, const uint top,
+                                const std::vector<AABB> & boxes, std::vector<uint> & buf, std::vector<uint8_t> & masks) const;
+
+        const OctreeNode * node_child(const OctreeNode *node, const uint i) const { return &nodes[node->children+i]; }
+
+        void items_in_box(const AABB & b, std::unordered_set<uint> & indices) const;
+        void trace_packet(RayPacket & packet, std::vector<RayPacket::StackEntry<const OctreeNode*>> & stack) const;
+        void trace_rays  (const std::vector<vec3d> & p, const std::vector<vec3d> & dir, const std::vector<uint> & skip_ids,
+                          std::vector<double> & min_t, std::vector<uint> & ids, std::vector<uint> * n_hits) const;
 };
 
 }
@@ -0,0 +1,108 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/operator_cache.h>
+#include <cinolib/parallel_for.h>
+#include <cassert>
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool OperatorCache::empty() const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return !slots.cot_weights && !slots.vert_mass && !slots.gradient;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void OperatorCache::clear()
+{
+    if(!enabled) return; // nothing is ever stored
+    std::lock_guard<std::mutex> lock(mtx);
+    slots = Slots();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class T, class Build>
+CINO_INLINE
+std::shared_ptr<const T> OperatorCache::get(std::shared_ptr<const T> Slots::*slot, const Build & build)
+{
+    if(!enabled) return std::make_shared<const T>(build());
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if(slots.*slot) return slots.*slot;
+    }
+    // build without holding the lock, so that requests for other coefficients
+    // are not blocked. If two threads race on the same slot, the first one wins
+    std::shared_ptr<const T> data = std::make_shared<const T>(build());
+    std::lock_guard<std::mutex> lock(mtx);
+    if(!(slots.*slot)) slots.*slot = data;
+    return slots.*slot;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::SparseMatrix<double> replicate_diagonally(Eigen::SparseMatrix<double> A, const int n)
+{
+    assert(n>=1);
+    if(n==1) return A;
+    A.makeCompressed();
+    const Eigen::SparseMatrix<double> & B = A;
+
+    int rows = int(B.rows());
+    int cols = int(B.cols());
+    int nnz  = int(B.nonZeros());
+
+    Eigen::SparseMatrix<double> R(n*rows, n*cols);
+    R.resizeNonZeros(n*nnz);
+    PARALLEL_FOR(0, n, 2, [&](const uint i)
+    {
+        for(int col=0; col<cols; ++col) R.outerIndexPtr()[i*cols+col] = i*nnz + B.outerIndexPtr()[col];
+        for(int k=0; k<nnz; ++k)
+        {
+            R.innerIndexPtr()[i*nnz+k] = i*rows + B.innerIndexPtr()[k];
+            R.valuePtr()     [i*nnz+k] = B.valuePtr()[k];
+        }
+    });
+    R.outerIndexPtr()[n*cols] = n*nnz;
+    return R;
+}
+
+}
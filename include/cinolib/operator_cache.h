@@ -0,0 +1,137 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_OPERATOR_CACHE_H
+#define CINO_OPERATOR_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <Eigen/Sparse>
+
+namespace cinolib
+{
+
+/* Iterative algorithms (smoothing, flows, geodesics, parameterization...)
+ * often rebuild the same geometric operators many times on the same mesh.
+ * Most of the cost of an operator goes in its per element coefficients
+ * (cotangent weights, vertex masses, per element gradients), which meshes can
+ * optionally keep in cache. Operators are still assembled at each request, but
+ * from the cached coefficients. Caching is off by default. It is turned on and
+ * off with m.operator_cache_enable(bool), and turning it off frees the memory.
+ *
+ * Cached coefficients are dropped by the mesh itself whenever it is edited:
+ * all topological editing operations (see AbstractMesh::topology_thaw), the
+ * global transformations (translate, rotate, scale, transform...) and calls to
+ * update_bbox() and update_normals() invalidate them. Vertices moved directly
+ * (e.g. through vert(vid) or vector_verts()) go unnoticed until one of these
+ * updates, which such code needs anyway to keep bbox and normals in sync, or
+ * until an explicit m.operator_cache_clear().
+ *
+ * Coefficients can be requested concurrently on the same mesh: the cache is
+ * guarded by a mutex, and coefficients are immutable shared arrays that remain
+ * valid for their users even if the cache is dropped. Copies of a mesh start
+ * with an empty cache.
+*/
+
+// per poly gradient coefficients (see gradient.h). For each vertex of each poly
+// they store the gradient of its basis function, up to the per poly measure
+struct GradientCoeffs
+{
+    std::vector<uint>   offset;  // coefficients of poly pid are in [offset[pid], offset[pid+1])
+    std::vector<uint>   vid;     // vertex each coefficient refers to
+    std::vector<vec3d>  coeff;   // gradient, not yet divided by measure
+    std::vector<double> measure; // per poly (clamped area or volume)
+    std::vector<double> weight;  // per poly, for per vertex averaging
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class OperatorCache
+{
+    public:
+
+        typedef std::shared_ptr<const std::vector<double>> Coeffs;
+        typedef std::shared_ptr<const GradientCoeffs>      Gradient;
+
+        struct Slots
+        {
+            Coeffs   cot_weights; // per edge
+            Coeffs   vert_mass;   // per vertex
+            Gradient gradient;    // per poly
+        };
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        OperatorCache() {}
+        OperatorCache(const OperatorCache & c) : enabled(c.enabled) {}
+        OperatorCache & operator=(const OperatorCache & c) { clear(); enabled = c.enabled; return *this; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void enable(const bool b) { if(!b) clear(); enabled = b; }
+        bool is_enabled() const   { return enabled; }
+        bool empty() const;
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // returns the coefficients stored in slot, building them with build() if
+        // missing. If caching is disabled they are just built, and nothing is stored
+        template<class T, class Build>
+        std::shared_ptr<const T> get(std::shared_ptr<const T> Slots::*slot, const Build & build);
+
+    private:
+
+        bool               enabled = false;
+        Slots              slots;
+        mutable std::mutex mtx;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// block diagonal matrix made of n copies of A (A itself, if n is one)
+CINO_INLINE
+Eigen::SparseMatrix<double> replicate_diagonally(Eigen::SparseMatrix<double> A, const int n);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "operator_cache.cpp"
+#endif
+
+#endif // CINO_OPERATOR_CACHE_H
@@ -34,9 +34,9 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/parallel_for.h>
-#include <thread>
+#include <cinolib/thread_pool.h>
 #include <vector>
-#include <cmath>
+#include <utility>
 
 namespace cinolib
 {
@@ -48,80 +48,79 @@ static void PARALLEL_FOR(      uint   beg,
                          const uint   serial_if_less_than,
                          const Func & func)
 {
-#ifndef SERIALIZE_PARALLEL_FOR
+    PARALLEL_FOR(beg, end, serial_if_less_than, 0, 0, func);
+}
 
-    uint n = end - beg + 1;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    if(n<serial_if_less_than)
-    {
-        for(uint i=beg; i<end; ++i) func(i);
-    }
-    else
-    {
-        // estimate number of threads in the pool
-        const static unsigned n_threads_hint = std::thread::hardware_concurrency();
-        const static unsigned n_threads      = (n_threads_hint==0u) ? 8u : n_threads_hint;
-        // parallelize the loop
-        PARALLEL_FOR(beg, end, serial_if_less_than, n_threads, func);
-    }
-#else
-    for(uint i=beg; i<end; ++i) func(i);
-#endif
+template<typename Func>
+CINO_INLINE
+static void PARALLEL_FOR(      uint   beg,
+                               uint   end,
+                         const uint   serial_if_less_than,
+                         const uint   n_threads_hint,
+                         const Func & func)
+{
+    PARALLEL_FOR(beg, end, serial_if_less_than, n_threads_hint, 0, func);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<typename Func>
 CINO_INLINE
 static void PARALLEL_FOR(      uint   beg,
                                uint   end,
                          const uint   serial_if_less_than,
                          const uint   n_threads_hint,
+                         const uint   grain,
                          const Func & func)
 {
 #ifndef SERIALIZE_PARALLEL_FOR
-
-    uint n = end - beg + 1;
-
-    if(n<serial_if_less_than)
+    if(end>beg && end-beg>=serial_if_less_than && !ThreadPool::in_parallel_region())
     {
-        for(uint i=beg; i<end; ++i) func(i);
-    }
-    else
-    {
-        // estimate number of threads in the pool
-        const static unsigned n_threads      = (n_threads_hint==0u) ? 8u : n_threads_hint;
-
-        // split the full range into sub ranges of equal size
-        uint slice = (uint)std::round(n/static_cast<double>(n_threads));
-        slice = std::max(slice,uint(1));
-
-        // helper function that handles a sub range
-        auto subrange_helper = [&func](uint k1, uint k2)
+        ThreadPool::instance().run(beg, end, n_threads_hint, grain, [&func](uint k1, uint k2, uint)
         {
             for(uint k=k1; k<k2; ++k) func(k);
-        };
+        });
+        return;
+    }
+#else
+    (void)n_threads_hint;
+    (void)grain;
+#endif
+    for(uint i=beg; i<end; ++i) func(i);
+}
 
-        // create pool and launch jobs
-        std::vector<std::thread> pool;
-        pool.reserve(n_threads);
-        uint i1 = beg;
-        uint i2 = std::min(beg + slice, end);
-        for(uint i=0; i+1<n_threads && i1<end; ++i)
-        {
-            pool.emplace_back(subrange_helper, i1, i2);
-            i1 = i2;
-            i2 = std::min(i2+slice, end);
-        }
-        if(i1<end) pool.emplace_back(subrange_helper, i1, end);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        // Wait for jobs to finish
-        for(std::thread & t : pool)
+template<typename T, typename Func, typename Reduce>
+CINO_INLINE
+static T PARALLEL_REDUCE(      uint     beg,
+                               uint     end,
+                         const uint     serial_if_less_than,
+                         const T      & identity,
+                         const Func   & func,
+                         const Reduce & reduce)
+{
+#ifndef SERIALIZE_PARALLEL_FOR
+    if(end>beg && end-beg>=serial_if_less_than && !ThreadPool::in_parallel_region())
+    {
+        // one accumulator per thread, padded to avoid false sharing
+        struct Acc { T val; char pad[64]; };
+        ThreadPool & pool = ThreadPool::instance();
+        std::vector<Acc> acc(pool.num_threads(), Acc{identity, {}});
+        pool.run(beg, end, 0, 0, [&](uint k1, uint k2, uint tid)
         {
-            if(t.joinable()) t.join();
-        }
+            for(uint k=k1; k<k2; ++k) func(k, acc[tid].val);
+        });
+        T res = identity;
+        for(const Acc & a : acc) res = reduce(std::move(res), a.val);
+        return res;
     }
-#else
-    for(uint i=beg; i<end; ++i) func(i);
 #endif
+    T res = identity;
+    for(uint i=beg; i<end; ++i) func(i, res);
+    return res;
 }
 
 }
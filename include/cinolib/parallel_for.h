@@ -43,18 +43,24 @@ namespace cinolib
 {
 
 /* OpenMP-like parallel for loop realized in plain C++11
- * Thanks to Jeremy Dumas for his code (https://ideone.com/Z7zldb)
+ * Thanks to Jeremy Dumas for the original code (https://ideone.com/Z7zldb)
  *
- * DISCLAIMER: this routine is as good as OpenMP with STATIC scheduling.
- * That is, it works best when computational cost is equally distributed
- * across all threads. In case of unbalanced distribution, performances
- * may degrade, and using the DYNAMIC scheduling of a library such as OpenMP
- * will greatly benefit performances.
+ * Loops are executed by a persistent pool of threads (see thread_pool.h),
+ * which is started the first time a loop is parallelized. Scheduling is
+ * dynamic: the range is processed in chunks of grain size, and threads that
+ * run out of work steal chunks from the others. Therefore, small loops called
+ * repeatedly do not pay thread creation, and loops with unbalanced bodies keep
+ * all cores busy. A PARALLEL_FOR called from inside the body of another
+ * parallel loop is executed serially.
  *
- * PARALLEL_FOR has three arguments
+ * PARALLEL_FOR has the following arguments
  *
  *     beg,end             : define a range of indices
  *     serial_if_less_than : avoid paying the overhead if the range is smaller than...
+ *     n_threads_hint      : (optional) max number of threads to use (0 => all)
+ *     grain               : (optional) number of consecutive indices that a thread
+ *                           processes at once (0 => automatic). Use bigger grains
+ *                           for cheap bodies, smaller grains for unbalanced ones
  *     func                : is the function that implements the body of the loop.
  *                           It takes as unique argument the loop index. This will
  *                           typically be a lambda function inlined in the call
@@ -75,6 +81,13 @@ namespace cinolib
  *    m.update_p_normal(pid);
  * });
  *
+ * NOTE: loop bodies should only write data that is private to the current index.
+ * To accumulate results across the whole range (min/max, sums, lists of items...)
+ * use PARALLEL_REDUCE, which avoids both data races and locks.
+ *
+ * NOTE: if func throws, iterations not yet started are skipped and the first
+ * exception is rethrown to the caller, once all threads are done with the loop.
+ *
  * NOTE: if symbol SERIALIZE_PARALLEL_FOR is defined at compilation time,
  * the loop will be executed in standard serial mode.
 */
@@ -93,6 +106,52 @@ static void PARALLEL_FOR(      uint   beg,
                          const uint   serial_if_less_than,
                          const uint   n_threads_hint,
                          const Func & func);
+
+template<typename Func>
+CINO_INLINE
+static void PARALLEL_FOR(      uint   beg,
+                               uint   end,
+                         const uint   serial_if_less_than,
+                         const uint   n_threads_hint,
+                         const uint   grain,
+                         const Func & func);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Parallel reduction over a range of indices. Each thread accumulates into a
+ * private copy of the result, initialized with identity, and copies are merged
+ * at the end with the reduce operator. This avoids data races on shared
+ * variables without paying for locks or atomics inside the loop.
+ *
+ *     func   : void(uint i, T & acc), accumulates the i-th element into acc
+ *     reduce : T(const T & a, const T & b), merges two partial results
+ *
+ * Example of usage: compute the range of a scalar field f.
+ *
+ * typedef std::pair<float,float> range;
+ * range r = PARALLEL_REDUCE(0, f.size(), 1000, range(FLT_MAX,-FLT_MAX),
+ *           [&](uint i, range & acc)
+ *           {
+ *               acc.first  = std::min(acc.first,  f[i]);
+ *               acc.second = std::max(acc.second, f[i]);
+ *           },
+ *           [](const range & a, const range & b)
+ *           {
+ *               return range(std::min(a.first,b.first), std::max(a.second,b.second));
+ *           });
+ *
+ * NOTE: reduce must be associative. Since the assignment of indices to threads
+ * is dynamic, floating point sums may differ in the last bits across runs.
+*/
+
+template<typename T, typename Func, typename Reduce>
+CINO_INLINE
+static T PARALLEL_REDUCE(      uint     beg,
+                               uint     end,
+                         const uint     serial_if_less_than,
+                         const T      & identity,
+                         const Func   & func,
+                         const Reduce & reduce);
 }
 
 #ifndef  CINO_STATIC_LIB
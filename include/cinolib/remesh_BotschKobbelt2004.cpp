@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/remesh_BotschKobbelt2004.h>
 #include <cinolib/tangential_smoothing.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -55,19 +56,22 @@ void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
 {
     double l = (target_edge_length>0) ? target_edge_length : m.edge_avg_length();
 
+    // deferred deletion (see AbstractPolygonMesh::deferred_delete_begin)
+    bool deferred = m.deferred_delete_is_active();
+    if(!deferred) m.deferred_delete_begin();
+
     // 1) split too long edges
     //
-    uint count = 0;
     uint ne = m.num_edges();
     for(uint eid=0; eid<ne; ++eid)
     {
+        if (m.edge_is_dead(eid)) continue;
         if (m.edge_length(eid) > 4./3.*l)
         {
             bool mark_children = (preserve_marked_features && m.edge_data(eid).flags[MARKED]);
             uint vid0 = m.edge_vert_id(eid, 0);
             uint vid1 = m.edge_vert_id(eid, 1);
             uint vid  = m.edge_split(eid, 0.5);
-            ++count;
 
             if(mark_children)
             {
@@ -78,13 +82,13 @@ void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
             }
         }
     }
-    std::cout << "\t" << count << " edges longer than " << 4./3.*l << " were split." << std::endl;
 
     // 2) collapse too short edges
     //
-    count = 0;
     for(uint eid=0; eid<m.num_edges(); ++eid)
     {
+        if (m.edge_is_dead(eid)) continue;
+
         bool inc_to_marked = false;
         if(preserve_marked_features)
         {
@@ -98,16 +102,14 @@ void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
         if (m.edge_length(eid) < 4./5.*l)
         {
             m.edge_collapse(eid, 0.5);
-            ++count;
         }
     }
-    std::cout << "\t" << count << " edges shorter than " << 4./5.*l << " were collapsed." << std::endl;
 
     // 3) optimize per vert valence
     //
-    count = 0;
     for(uint eid=0; eid<m.num_edges(); ++eid)
     {
+        if (m.edge_is_dead(eid)) continue;
         if (preserve_marked_features && m.edge_data(eid).flags[MARKED]) continue;
 
         std::vector<uint> vopp = m.verts_opposite_to(eid);
@@ -156,16 +158,15 @@ void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
                 m.update_v_normal(m.edge_vert_id(new_eid,0));
                 m.update_v_normal(m.edge_vert_id(new_eid,1));
             }
-            ++count;
         }
     }
-    std::cout << "\t" << count << " edge flip were performed to normalize vertex valence to 6" << std::endl;
-
 
     // 4) relocate vertices by tangential smoothing
     //
     for(uint vid=0; vid<m.num_verts(); ++vid)
     {
+        if (m.vert_is_dead(vid)) continue;
+
         bool anchored = false;
         for(uint eid : m.adj_v2e(vid))
         {
@@ -173,7 +174,290 @@ void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
         }
         if (!anchored) tangential_smoothing(m,vid);
     }
-    std::cout << "\ttangential smoothing" << std::endl;
+
+    if(!deferred) m.deferred_delete_end();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if some edge incident to the endpoints of eid is MARKED
+template<class M, class V, class E, class P>
+CINO_INLINE
+static bool BK04_touches_marked(const Trimesh<M,V,E,P> & m, const uint eid)
+{
+    for(uint i=0; i<2; ++i)
+    {
+        for(uint nbr : m.adj_v2e(m.edge_vert_id(eid,i)))
+        {
+            if(m.edge_data(nbr).flags[MARKED]) return true;
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// valence change (squared deviation from the ideal valence) produced by flipping eid.
+// Negative values are improvements
+template<class M, class V, class E, class P>
+CINO_INLINE
+static int BK04_flip_gain(const Trimesh<M,V,E,P> & m, const uint eid)
+{
+    std::vector<uint> vopp = m.verts_opposite_to(eid);
+    if(vopp.size()!=2) return 0;
+
+    uint vids[4] = { m.edge_vert_id(eid,0), m.edge_vert_id(eid,1), vopp.at(0), vopp.at(1) };
+    int  delta[4] = { -1, -1, +1, +1 };
+    int  gain = 0;
+    for(uint i=0; i<4; ++i)
+    {
+        int val = m.vert_valence(vids[i]);
+        int opt = m.vert_is_boundary(vids[i]) ? 4 : 6;
+        gain += (val+delta[i]-opt)*(val+delta[i]-opt) - (val-opt)*(val-opt);
+    }
+    return gain;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P>    & m,
+                                const RemeshOptions & opt)
+{
+    double l = (opt.target_edge_length>0) ? opt.target_edge_length : m.edge_avg_length();
+    auto target_at = [&](const vec3d & p) -> double
+    {
+        return opt.target_length_field ? opt.target_length_field(p) : l;
+    };
+    auto target = [&](const uint eid) -> double
+    {
+        return target_at(m.edge_sample_at(eid,0.5));
+    };
+
+    auto phase_begin = [&](const std::string & name) { if(opt.profiler) opt.profiler->push("remesh_Botsch_Kobbelt_2004::" + name); };
+    auto phase_end   = [&]()                         { if(opt.profiler) opt.profiler->pop(false); };
+
+    // batched editing with deferred deletion (see AbstractPolygonMesh::deferred_delete_begin).
+    // The mesh is compacted at the end of each iteration
+    bool deferred = m.deferred_delete_is_active();
+    if(!deferred) m.deferred_delete_begin();
+
+    std::vector<uint> stamp;
+    uint              round = 0;
+    auto mark = [&](const uint vid, const bool ring)
+    {
+        stamp.at(vid) = round;
+        if(ring) for(uint nbr : m.adj_v2v(vid)) stamp.at(nbr) = round;
+    };
+    auto is_free = [&](const uint vid, const bool ring) -> bool
+    {
+        if(stamp.at(vid)==round) return false;
+        if(ring) for(uint nbr : m.adj_v2v(vid)) if(stamp.at(nbr)==round) return false;
+        return true;
+    };
+
+    std::vector<uint> cand, batch, postponed;
+    std::vector<char> ok;
+
+    for(uint it=0; it<opt.iterations; ++it)
+    {
+        // 1) split too long edges. Splits do not move vertices, hence edge lengths
+        //    can all be tested upfront
+        //
+        phase_begin("split");
+        uint ne = m.num_edges();
+        ok.assign(ne,false);
+        PARALLEL_FOR(0, ne, 1000, [&](const uint eid)
+        {
+            ok.at(eid) = !m.edge_is_dead(eid) && m.edge_length(eid) > 4./3.*target(eid);
+        });
+        for(uint eid=0; eid<ne; ++eid)
+        {
+            if(!ok.at(eid)) continue;
+            bool mark_children = (opt.preserve_marked_features && m.edge_data(eid).flags[MARKED]);
+            uint vid0 = m.edge_vert_id(eid, 0);
+            uint vid1 = m.edge_vert_id(eid, 1);
+            uint vid  = m.edge_split(eid, 0.5);
+            if(mark_children)
+            {
+                int e0 = m.edge_id(vid,vid0); assert(e0>=0);
+                int e1 = m.edge_id(vid,vid1); assert(e1>=0);
+                m.edge_data(e0).flags[MARKED] = true;
+                m.edge_data(e1).flags[MARKED] = true;
+            }
+        }
+        phase_end();
+
+        // 2) collapse too short edges, in batches of edges with disjoint 1-rings.
+        //    A collapse is discarded if it touches a feature, changes the topology,
+        //    flips some triangle or generates edges longer than the split threshold
+        //
+        phase_begin("collapse");
+        ne = m.num_edges();
+        ok.assign(ne,false);
+        PARALLEL_FOR(0, ne, 1000, [&](const uint eid)
+        {
+            ok.at(eid) = !m.edge_is_dead(eid) && m.edge_length(eid) < 4./5.*target(eid);
+        });
+        cand.clear();
+        for(uint eid=0; eid<ne; ++eid) if(ok.at(eid)) cand.push_back(eid);
+        stamp.assign(m.num_verts(),0);
+        round = 0;
+        while(!cand.empty())
+        {
+            ++round;
+            batch.clear();
+            postponed.clear();
+            for(uint eid : cand)
+            {
+                if(m.edge_is_dead(eid)) continue;
+                uint v0 = m.edge_vert_id(eid,0);
+                uint v1 = m.edge_vert_id(eid,1);
+                if(is_free(v0,true) && is_free(v1,true))
+                {
+                    mark(v0,true);
+                    mark(v1,true);
+                    batch.push_back(eid);
+                }
+                else postponed.push_back(eid);
+            }
+            ok.resize(batch.size());
+            PARALLEL_FOR(0, batch.size(), 64, [&](const uint i)
+            {
+                uint  eid = batch.at(i);
+                vec3d mid = m.edge_sample_at(eid,0.5);
+                ok.at(i) = false;
+                if(m.edge_length(eid) >= 4./5.*target(eid)) return; // endpoints moved by a previous batch
+                if(opt.preserve_marked_features && BK04_touches_marked(m,eid)) return;
+                for(uint j=0; j<2; ++j)
+                {
+                    for(uint nbr : m.adj_v2v(m.edge_vert_id(eid,j)))
+                    {
+                        vec3d p = m.vert(nbr);
+                        if(mid.dist(p) > 4./3.*target_at((mid+p)*0.5)) return;
+                    }
+                }
+                ok.at(i) = m.edge_is_topologically_collapsible(eid) &&
+                           m.edge_is_geometrically_collapsible(eid, mid);
+            });
+            for(uint i=0; i<batch.size(); ++i)
+            {
+                if(ok.at(i)) m.edge_collapse(batch.at(i), m.edge_sample_at(batch.at(i),0.5), false, false);
+            }
+            cand.swap(postponed);
+        }
+        phase_end();
+
+        // 3) flip edges to normalize vertex valence (6 inside, 4 on the boundary),
+        //    in batches of edges whose quads do not share any vertex
+        //
+        phase_begin("flip");
+        ne = m.num_edges();
+        ok.assign(ne,false);
+        PARALLEL_FOR(0, ne, 1000, [&](const uint eid)
+        {
+            if(m.edge_is_dead(eid)) return;
+            if(opt.preserve_marked_features && m.edge_data(eid).flags[MARKED]) return;
+            ok.at(eid) = BK04_flip_gain(m,eid)<0;
+        });
+        cand.clear();
+        for(uint eid=0; eid<ne; ++eid) if(ok.at(eid)) cand.push_back(eid);
+        stamp.assign(m.num_verts(),0);
+        round = 0;
+        while(!cand.empty())
+        {
+            ++round;
+            batch.clear();
+            postponed.clear();
+            for(uint eid : cand)
+            {
+                if(m.edge_is_dead(eid)) continue;
+                std::vector<uint> vopp = m.verts_opposite_to(eid);
+                if(vopp.size()!=2) continue;
+                uint vids[4] = { m.edge_vert_id(eid,0), m.edge_vert_id(eid,1), vopp.at(0), vopp.at(1) };
+                bool free = true;
+                for(uint vid : vids) if(!is_free(vid,false)) free = false;
+                if(free)
+                {
+                    for(uint vid : vids) mark(vid,false);
+                    batch.push_back(eid);
+                }
+                else postponed.push_back(eid);
+            }
+            ok.resize(batch.size());
+            PARALLEL_FOR(0, batch.size(), 64, [&](const uint i)
+            {
+                uint eid = batch.at(i);
+                std::vector<uint> vopp = m.verts_opposite_to(eid);
+                ok.at(i) = BK04_flip_gain(m,eid)<0        && // valences may have changed in previous batches
+                           m.edge_id(vopp.at(0),vopp.at(1))<0 && // the flipped edge would be duplicated
+                           m.edge_is_flippable(eid);
+            });
+            for(uint i=0; i<batch.size(); ++i)
+            {
+                if(!ok.at(i)) continue;
+                uint eid     = batch.at(i);
+                P    data    = m.poly_data(m.adj_e2p(eid).front());
+                int  new_eid = m.edge_flip(eid,false);
+                assert(new_eid>=0);
+                for(uint pid : m.adj_e2p(new_eid))
+                {
+                    m.poly_data(pid) = data;
+                    m.update_p_normal(pid);
+                }
+            }
+            cand.swap(postponed);
+        }
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+        {
+            if(!m.vert_is_dead(vid)) m.update_v_normal(vid);
+        });
+        phase_end();
+
+        // 4) relocate vertices by tangential smoothing. All new positions are
+        //    computed from the current ones, and then applied at once
+        //
+        phase_begin("smooth");
+        std::vector<vec3d> pos(m.num_verts());
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+        {
+            pos.at(vid) = m.vert(vid);
+            if(m.vert_is_dead(vid) || m.vert_is_boundary(vid) || m.adj_v2v(vid).empty()) return;
+            if(opt.preserve_marked_features)
+            {
+                for(uint eid : m.adj_v2e(vid)) if(m.edge_data(eid).flags[MARKED]) return;
+            }
+            vec3d delta(0,0,0);
+            for(uint nbr : m.adj_v2v(vid)) delta += m.vert(nbr);
+            delta /= static_cast<double>(m.adj_v2v(vid).size());
+            delta -= m.vert(vid);
+            delta -= m.vert_data(vid).normal * delta.dot(m.vert_data(vid).normal);
+            pos.at(vid) += delta;
+        });
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+        {
+            m.vert(vid) = pos.at(vid);
+        });
+        PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+        {
+            if(!m.poly_is_dead(pid)) m.update_p_normal(pid);
+        });
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+        {
+            if(!m.vert_is_dead(vid)) m.update_v_normal(vid);
+        });
+        phase_end();
+
+        if(!deferred)
+        {
+            phase_begin("compact");
+            m.compact();
+            phase_end();
+        }
+    }
+
+    if(!deferred) m.deferred_delete_end();
 }
 
 }
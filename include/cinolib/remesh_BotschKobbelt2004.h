@@ -37,6 +37,8 @@
 #define CINO_REMESH_BOTSCH_KOBBELT_2004_H
 
 #include <cinolib/meshes/drawable_trimesh.h>
+#include <cinolib/profiler.h>
+#include <functional>
 
 namespace cinolib
 {
@@ -54,6 +56,33 @@ CINO_INLINE
 void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P> & m,
                                 const double       target_edge_length = -1,
                                 const bool         preserve_marked_features = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct RemeshOptions
+{
+    uint   iterations               = 5;
+    double target_edge_length       = -1;      // uniform target length (if negative, the average edge length is used)
+    std::function<double(const vec3d &)> target_length_field; // optional, spatially varying target length. Must be thread safe
+    bool   preserve_marked_features = true;
+    Profiler * profiler             = nullptr; // if set, per phase timings are logged here (and not printed)
+};
+
+/* Multiple iterations of the same remeshing algorithm, scheduled for
+ * multithreading. Splits only depend on edge lengths, and are decided in
+ * parallel. Collapses and flips are grouped in batches of edges with disjoint
+ * neighborhoods (i.e., a greedy coloring of their conflict graph), as explained
+ * in AbstractPolygonMesh::deferred_delete_begin.
+ * Tangential smoothing is computed in parallel, Jacobi style. The output
+ * does not depend on the number of threads. Collapses that would create edges
+ * longer than the split threshold are discarded, and the mesh is compacted at
+ * the end of each iteration (unless deferred deletion was already active).
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void remesh_Botsch_Kobbelt_2004(Trimesh<M,V,E,P>    & m,
+                                const RemeshOptions & opt);
 }
 
 #ifndef  CINO_STATIC_LIB
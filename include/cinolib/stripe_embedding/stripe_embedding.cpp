@@ -214,7 +214,7 @@ std::vector<uint> make_chain(SE_data & data, const uint pivot)
     int i = chain_starting_index(data,pivot);
     if(i<0) return chain;
 
-    auto & ring = data.m.adj_v2v(pivot);
+    auto ring = data.m.adj_v2v(pivot);
     chain.push_back(ring.at(i));
     do
     {
@@ -266,7 +266,8 @@ void tetgen_wrap(const AbstractPolygonMesh<M,V,E,F> & m_srf,
                  const std::string                  & flags,
                        Tetmesh<M,V,E,F,P>           & m)
 {
-    tetgen_wrap(m_srf.vector_verts(), m_srf.vector_polys(), {}, flags, m);
+    std::vector<std::vector<uint>> buf;
+    tetgen_wrap(m_srf.vector_verts(), m_srf.vector_polys(buf), {}, flags, m);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -278,7 +279,8 @@ void tetgen_wrap(const AbstractPolygonMesh<M,V,E,F> & m_srf,
                  const std::string                  & flags,
                        Tetmesh<M,V,E,F,P>           & m)
 {
-    tetgen_wrap(m_srf.vector_verts(), m_srf.vector_polys(), {}, holes, flags, m);
+    std::vector<std::vector<uint>> buf;
+    tetgen_wrap(m_srf.vector_verts(), m_srf.vector_polys(buf), {}, holes, flags, m);
 }
 
 }
@@ -0,0 +1,206 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/thread_pool.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+ThreadPool & ThreadPool::instance()
+{
+    // the calling thread takes part in each loop, hence one worker less than
+    // the available cores. Local statics are initialized lazily and thread-safely
+    static const unsigned n_cores = std::thread::hardware_concurrency();
+    static ThreadPool pool((n_cores==0u) ? 7u : n_cores-1);
+    return pool;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool::ThreadPool(const uint n_workers)
+{
+    workers.reserve(n_workers);
+    for(uint i=0; i<n_workers; ++i)
+    {
+        workers.emplace_back(&ThreadPool::worker_loop, this, i+1); // tid 0 is the caller
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv_start.notify_all();
+    for(std::thread & t : workers) if(t.joinable()) t.join();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool & ThreadPool::region_flag()
+{
+    thread_local bool in_region = false;
+    return in_region;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ThreadPool::in_parallel_region()
+{
+    return region_flag();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::run(const uint        beg,
+                     const uint        end,
+                     const uint        n_threads,
+                     const uint        grain,
+                     const RangeBody & body)
+{
+    if(beg>=end) return;
+    uint n  = end - beg;
+    uint nt = (n_threads==0) ? num_threads() : std::min(n_threads, num_threads());
+    nt = std::min(nt, n);
+
+    // nested loops (and loops too small to be split) run on the calling thread
+    if(nt<=1 || in_parallel_region())
+    {
+        body(beg, end, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job.body   = &body;
+        job.failed = false;
+        job.error  = nullptr;
+        job.grain  = (grain>0) ? grain : std::max(1u, n/(8*nt)); // ~8 chunks per thread
+        job.blocks = std::vector<Block>(nt);
+        for(uint i=0; i<nt; ++i)
+        {
+            job.blocks[i].next = beg + size_t(n)* i   /nt;
+            job.blocks[i].end  = beg + size_t(n)*(i+1)/nt;
+        }
+        pending = uint(workers.size());
+        ++job_id;
+    }
+    cv_start.notify_all();
+
+    {
+        // the flag is reset even if something below throws
+        struct RegionGuard
+        {
+             RegionGuard() { region_flag() = true;  }
+            ~RegionGuard() { region_flag() = false; }
+        } guard;
+        process(0);
+    }
+
+    // workers may still be processing their last chunk (body lives in the caller's frame)
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv_done.wait(lock, [this]{ return pending==0; });
+        job.body = nullptr;
+        std::swap(error, job.error);
+    }
+    if(error) std::rethrow_exception(error);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::process(const uint tid)
+{
+    // consume the own block first, then steal from the others
+    const uint nb = uint(job.blocks.size());
+    for(uint k=0; k<nb; ++k)
+    {
+        Block & b = job.blocks[(tid+k)%nb];
+        while(!job.failed.load(std::memory_order_relaxed))
+        {
+            size_t i = b.next.fetch_add(job.grain, std::memory_order_relaxed);
+            if(i>=b.end) break;
+            try
+            {
+                (*job.body)(uint(i), uint(std::min(i+job.grain, b.end)), tid);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!job.error) job.error = std::current_exception();
+                job.failed = true;
+                return;
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::worker_loop(const uint tid)
+{
+    region_flag() = true;
+    uint last_job = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_start.wait(lock, [&]{ return stop || job_id!=last_job; });
+            if(stop) return;
+            last_job = job_id;
+        }
+
+        if(tid<job.blocks.size()) process(tid);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--pending==0) cv_done.notify_one();
+    }
+}
+
+}
@@ -0,0 +1,143 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_THREAD_POOL_H
+#define CINO_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Persistent pool of worker threads backing PARALLEL_FOR and PARALLEL_REDUCE.
+ * The pool is started lazily the first time it is used, and it is shared by
+ * the whole program (see ThreadPool::instance). Workers are joined at exit.
+ *
+ * Scheduling is dynamic: the index range is split into one block per thread,
+ * and each thread consumes its own block in chunks of grain size. Threads that
+ * finish early steal chunks from the blocks of the others, so that unbalanced
+ * loop bodies (e.g. ray casting) do not leave cores idle. The calling thread
+ * takes part in the loop as well.
+ *
+ * Parallel loops nested inside a parallel loop (e.g. a PARALLEL_FOR called by
+ * a loop body) are executed serially by the thread that encounters them.
+ * Loops issued concurrently by different user threads are serialized.
+*/
+
+class ThreadPool
+{
+    public:
+
+        // body(beg, end, tid) processes the sub range [beg,end) on behalf of
+        // the tid-th participant to the loop (0 <= tid < num_participants)
+        typedef std::function<void(uint,uint,uint)> RangeBody;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        static ThreadPool & instance();
+
+        explicit ThreadPool(const uint n_workers);
+                ~ThreadPool();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // number of threads that can take part in a loop (workers + caller)
+        uint num_threads() const { return uint(workers.size()) + 1; }
+
+        // true if the calling thread is currently executing a parallel loop
+        static bool in_parallel_region();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // runs body over [beg,end) using at most n_threads threads (0 => all),
+        // and chunks of at most grain indices (0 => automatic). The tid passed
+        // to body is always smaller than num_threads(). If body throws, chunks
+        // not yet started are skipped, and the first exception is rethrown on
+        // the calling thread once all participants are done
+        void run(const uint        beg,
+                 const uint        end,
+                 const uint        n_threads,
+                 const uint        grain,
+                 const RangeBody & body);
+
+    private:
+
+        struct Block
+        {
+            std::atomic<size_t> next; // size_t: fetch_add past the end must not wrap
+            size_t              end;
+            char                pad[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)]; // avoid false sharing
+        };
+
+        struct Job
+        {
+            const RangeBody  * body = nullptr;
+            std::vector<Block> blocks;
+            uint               grain = 1;
+            std::atomic<bool>  failed{false}; // set by the first body that throws. Stops all participants
+            std::exception_ptr error;   // exception thrown by that body (guarded by mutex)
+        };
+
+        void worker_loop(const uint tid);
+        void process    (const uint tid);
+
+        static bool & region_flag(); // thread local
+
+        std::vector<std::thread> workers;
+        std::mutex               submit_mutex; // serializes loops issued by different threads
+        std::mutex               mutex;
+        std::condition_variable  cv_start;
+        std::condition_variable  cv_done;
+        Job                      job;
+        uint                     job_id   = 0;
+        uint                     pending  = 0; // workers that did not check in yet
+        bool                     stop     = false;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "thread_pool.cpp"
+#endif
+
+#endif // CINO_THREAD_POOL_H
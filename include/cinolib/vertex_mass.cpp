@@ -34,34 +34,54 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vertex_mass.h>
+#include <cinolib/operator_cache.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m, const int n)
+static std::vector<double> mass_coeffs(const AbstractMesh<M,V,E,P> & m)
 {
-    typedef Eigen::Triplet<double> Entry;
+    std::vector<double> mass(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+    {
+        mass[vid] = m.vert_mass(vid);
+    });
+    return mass;
+}
 
-    uint nv = m.num_verts();
-    std::vector<uint> base(n);
-    for(int i=0; i<n; ++i) base[i] = nv*i;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    std::vector<Entry>  entries;
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+// diagonal matrix: one entry per column, directly in compressed form
+CINO_INLINE
+static Eigen::SparseMatrix<double> mass_assemble(const std::vector<double> & mass)
+{
+    int nv = int(mass.size());
+    Eigen::SparseMatrix<double> MM(nv, nv);
+    MM.resizeNonZeros(nv);
+    for(int vid=0; vid<nv; ++vid)
     {
-        double mass = m.vert_mass(vid);
-        for(int i=0; i<n; ++i) entries.push_back(Entry(base[i] + vid, base[i] + vid, mass));
+        MM.outerIndexPtr()[vid] = vid;
+        MM.innerIndexPtr()[vid] = vid;
+        MM.valuePtr()[vid]      = mass[vid];
     }
-
-    nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> MM(nv, nv);
-    MM.setFromTriplets(entries.begin(), entries.end());
-
+    MM.outerIndexPtr()[nv] = nv;
     return MM;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m, const int n)
+{
+    OperatorCache::Coeffs mass = m.operator_cache().get(&OperatorCache::Slots::vert_mass, [&]()
+    {
+        return mass_coeffs(m);
+    });
+    return replicate_diagonally(mass_assemble(*mass), n);
 }
 
+}
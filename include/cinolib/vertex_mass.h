@@ -42,6 +42,7 @@
 namespace cinolib
 {
 
+// vertex masses can be cached within the mesh (see operator_cache.h)
 template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m,
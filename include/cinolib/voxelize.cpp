@@ -36,7 +36,7 @@
 #include <cinolib/voxelize.h>
 #include <cinolib/serialize_index.h>
 #include <cinolib/parallel_for.h>
-#include <mutex>
+#include <atomic>
 
 namespace cinolib
 {
@@ -71,7 +71,9 @@ void voxelize(const AbstractPolygonMesh<M,V,E,P> & m,
     uint size = g.dim[0]*g.dim[1]*g.dim[2];
     g.voxels = new int[size];
     std::fill_n(g.voxels, size, VOXEL_UNKNOWN); // initialize grid
-    std::mutex mutex;
+    // threads flag boundary voxels with atomics (so that a voxel already flagged by
+    // any thread is not tested again) and the grid is updated after the loop
+    std::vector<std::atomic<bool>> is_boundary(size);
     PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
     {
         AABB  box = m.poly_aabb(pid);
@@ -83,7 +85,7 @@ void voxelize(const AbstractPolygonMesh<M,V,E,P> & m,
         for(uint k=uint(floor(beg[2])); k<uint(ceil(end[2])); ++k)
         {
             uint index = serialize_3D_index(i,j,k,g.dim[1],g.dim[2]);
-            if(g.voxels[index]==VOXEL_UNKNOWN)
+            if(!is_boundary[index].load(std::memory_order_relaxed))
             {
                 vec3u ijk(i,j,k);
                 AABB voxel = voxel_bbox(g,ijk.ptr());
@@ -95,14 +97,17 @@ void voxelize(const AbstractPolygonMesh<M,V,E,P> & m,
 
                     if(voxel.intersects_triangle(t))
                     {
-                        std::lock_guard<std::mutex> guard(mutex);
-                        g.voxels[index] = VOXEL_BOUNDARY;
+                        is_boundary[index].store(true, std::memory_order_relaxed);
                         break; // do not test other triangles for this boundary voxel...
                     }
                 }
             }
         }
     });
+    for(uint index=0; index<size; ++index)
+    {
+        if(is_boundary[index]) g.voxels[index] = VOXEL_BOUNDARY;
+    }
 
     // flood the outside
     std::queue<uint> q;
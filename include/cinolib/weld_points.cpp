@@ -0,0 +1,282 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/weld_points.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+namespace cinolib
+{
+
+typedef std::array<uint64_t,3> WeldKey;
+
+CINO_INLINE
+static uint64_t weld_hash(const WeldKey & k)
+{
+    uint64_t h = 0x9e3779b97f4a7c15ull;
+    for(uint64_t w : k)
+    {
+        h ^= w;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+    }
+    return h;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// bit pattern of the coordinates (adding 0.0 turns -0 into +0)
+CINO_INLINE
+static WeldKey weld_key_exact(const vec3d & p)
+{
+    WeldKey k;
+    for(int i=0; i<3; ++i)
+    {
+        double c = p.ptr()[i] + 0.0;
+        std::memcpy(&k[i], &c, sizeof(double));
+    }
+    return k;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static WeldKey weld_key_cell(const int64_t x, const int64_t y, const int64_t z)
+{
+    WeldKey k = {{ uint64_t(x), uint64_t(y), uint64_t(z) }};
+    return k;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// grid cell of coordinate c. Converting a double out of the int64_t range (or NaN) is undefined
+// behavior, hence cells are clamped to +/-2^62 (leaving room for the +/-1 of neighbor cells), and
+// NaN goes to cell zero. Clamping is monotone, so points within distance eps stay in adjacent cells
+CINO_INLINE
+static int64_t weld_cell_coord(const double c, const double eps)
+{
+    const double lim = 4611686018427387904.0; // 2^62
+    double f = std::floor(c/eps);
+    if(std::isnan(f)) return 0;
+    if(f < -lim)      return -(int64_t(1)<<62);
+    if(f >  lim)      return  int64_t(1)<<62;
+    return int64_t(f);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Open addressing hash table with linear probing, filled concurrently. Items
+ * with the same key share a slot, which stores the smallest of their indices.
+ * Slots are only ever written with compare and swap: an empty slot is taken
+ * by the first item that reaches it, and a taken slot can only be replaced by
+ * a smaller index with the same key.
+*/
+template<class KeyOf>
+CINO_INLINE
+static void weld_table_fill(std::vector<std::atomic<uint>> & table, const uint n, const KeyOf & key_of)
+{
+    uint mask = uint(table.size()-1);
+    PARALLEL_FOR(0, uint(table.size()), 100000, [&](const uint s)
+    {
+        table[s].store(max_uint, std::memory_order_relaxed);
+    });
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        WeldKey k = key_of(i);
+        uint    s = uint(weld_hash(k)) & mask;
+        while(true)
+        {
+            uint cur = table[s].load();
+            if(cur==max_uint && table[s].compare_exchange_strong(cur,i)) return;
+            // here cur is the item occupying the slot
+            if(key_of(cur)==k)
+            {
+                while(i<cur && !table[s].compare_exchange_weak(cur,i)) {}
+                return;
+            }
+            s = (s+1) & mask;
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// smallest index of the items with key k (max_uint if there are none)
+template<class KeyOf>
+CINO_INLINE
+static uint weld_table_find(const std::vector<std::atomic<uint>> & table, const WeldKey & k, const KeyOf & key_of)
+{
+    uint mask = uint(table.size()-1);
+    uint s    = uint(weld_hash(k)) & mask;
+    while(true)
+    {
+        uint cur = table[s].load(std::memory_order_relaxed);
+        if(cur==max_uint || key_of(cur)==k) return cur;
+        s = (s+1) & mask;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Pos>
+CINO_INLINE
+uint weld_points(const uint                n,
+                 const Pos               & pos,
+                       std::vector<uint> & remap,
+                       std::vector<uint> & reps,
+                 const double              eps)
+{
+    assert(eps>=0);
+
+    // load factor <= 2/3
+    size_t size = 16;
+    while(size < size_t(n) + n/2) size <<= 1;
+    assert(size <= size_t(max_uint));
+    std::vector<std::atomic<uint>> table(size);
+
+    std::vector<uint> rep(n); // representative of each point (index in [0,n))
+
+    if(eps==0)
+    {
+        auto key_of = [&](const uint i) { return weld_key_exact(pos(i)); };
+        weld_table_fill(table, n, key_of);
+        PARALLEL_FOR(0, n, 10000, [&](const uint i)
+        {
+            rep[i] = weld_table_find(table, key_of(i), key_of);
+        });
+    }
+    else
+    {
+        auto cell_of = [&](const vec3d & p)
+        {
+            return std::array<int64_t,3>{{ weld_cell_coord(p.x(),eps),
+                                           weld_cell_coord(p.y(),eps),
+                                           weld_cell_coord(p.z(),eps) }};
+        };
+        auto key_of = [&](const uint i)
+        {
+            std::array<int64_t,3> c = cell_of(pos(i));
+            return weld_key_cell(c[0], c[1], c[2]);
+        };
+        weld_table_fill(table, n, key_of);
+
+        // bucket points by grid cell (counting sort, indices within a cell stay sorted)
+        std::vector<uint> cell(n);
+        PARALLEL_FOR(0, n, 10000, [&](const uint i)
+        {
+            cell[i] = weld_table_find(table, key_of(i), key_of);
+        });
+        std::vector<uint> b_off(n+1,0);
+        for(uint i=0; i<n; ++i) ++b_off[cell[i]+1];
+        for(uint i=0; i<n; ++i) b_off[i+1] += b_off[i];
+        std::vector<uint> b_items(n);
+        {
+            std::vector<uint> b_pos(b_off.begin(), b_off.end()-1);
+            for(uint i=0; i<n; ++i) b_items[b_pos[cell[i]]++] = i;
+        }
+
+        // greedy clustering in input order
+        double sq_eps = eps*eps;
+        for(uint i=0; i<n; ++i)
+        {
+            vec3d p = pos(i);
+            std::array<int64_t,3> c = cell_of(p);
+            rep[i] = i;
+            for(int dx=-1; dx<=1; ++dx)
+            for(int dy=-1; dy<=1; ++dy)
+            for(int dz=-1; dz<=1; ++dz)
+            {
+                uint r = weld_table_find(table, weld_key_cell(c[0]+dx, c[1]+dy, c[2]+dz), key_of);
+                if(r==max_uint) continue;
+                for(uint k=b_off[r]; k<b_off[r+1]; ++k)
+                {
+                    uint j = b_items[k];
+                    if(j>=rep[i]) break;
+                    if(rep[j]==j && pos(j).dist_sqrd(p)<=sq_eps)
+                    {
+                        rep[i] = j;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // number representatives in input order
+    std::vector<uint> id(n);
+    reps.clear();
+    for(uint i=0; i<n; ++i)
+    {
+        if(rep[i]==i)
+        {
+            id[i] = uint(reps.size());
+            reps.push_back(i);
+        }
+    }
+    remap.resize(n);
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        remap[i] = id[rep[i]];
+    });
+
+    return uint(reps.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint weld_points(const std::vector<vec3d> & points,
+                       std::vector<vec3d> & unique_points,
+                       std::vector<uint>  & remap,
+                 const double               eps)
+{
+    std::vector<uint> reps;
+    weld_points(uint(points.size()), [&](const uint i) { return points[i]; }, remap, reps, eps);
+
+    unique_points.resize(reps.size());
+    PARALLEL_FOR(0, uint(reps.size()), 10000, [&](const uint i)
+    {
+        unique_points[i] = points[reps[i]];
+    });
+    return uint(reps.size());
+}
+
+}
@@ -0,0 +1,91 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WELD_POINTS_H
+#define CINO_WELD_POINTS_H
+
+#include <vector>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+/* Merges coincident points (e.g. the corners of triangle soups read from
+ * STL files). Each point is mapped to a representative, which is the first
+ * point (in input order) it has been merged with. Representatives are numbered
+ * in input order too, so that the output is the same that one would obtain by
+ * scanning the points and inserting them in a std::map, but points are bucketed
+ * with a concurrent hash table in linear time.
+ *
+ *     n      : number of points
+ *     pos    : vec3d(uint i), returns the position of the i-th point
+ *     remap  : for each point, the id of its representative in [0,#reps)
+ *     reps   : the representatives, as indices in [0,n)
+ *     eps    : if zero, only points with exactly the same coordinates are
+ *              merged (0 and -0 are considered the same). Otherwise, points are
+ *              scanned in input order and merged with the first representative
+ *              within distance eps, if any. Neighbors are found with a uniform
+ *              grid of spacing eps. This pass is serial, as its output depends
+ *              on the order of the points. Points with non finite coordinates
+ *              are never merged, and huge coordinates are clamped to the
+ *              outermost grid cells (correct, but slower if there are many).
+ *
+ * Returns the number of representatives.
+*/
+
+template<class Pos>
+CINO_INLINE
+uint weld_points(const uint                n,
+                 const Pos               & pos,
+                       std::vector<uint> & remap,
+                       std::vector<uint> & reps,
+                 const double              eps = 0.0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint weld_points(const std::vector<vec3d> & points,
+                       std::vector<vec3d> & unique_points,
+                       std::vector<uint>  & remap,
+                 const double               eps = 0.0);
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "weld_points.cpp"
+#endif
+
+#endif // CINO_WELD_POINTS_H
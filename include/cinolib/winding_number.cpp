@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/winding_number.h>
 #include <cinolib/solid_angle.h>
+#include <cinolib/fast_winding_number.h>
 
 namespace cinolib
 {
@@ -77,5 +78,36 @@ int winding_number(const AbstractPolygonMesh<M,V,E,P> & m,
     return static_cast<int>(round(w));
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void winding_number(const std::vector<vec3d> & verts,
+                    const std::vector<uint>  & tris,
+                    const std::vector<vec3d> & points,
+                          std::vector<int>   & wn)
+{
+    FastWindingNumber fwn;
+    fwn.build(verts, tris);
+    std::vector<double> w;
+    fwn.eval(points, w);
+    wn.resize(w.size());
+    for(uint i=0; i<w.size(); ++i) wn[i] = static_cast<int>(round(w[i]));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void winding_number(const AbstractPolygonMesh<M,V,E,P> & m,
+                    const std::vector<vec3d>           & points,
+                          std::vector<int>             & wn)
+{
+    FastWindingNumber fwn;
+    fwn.build(m);
+    std::vector<double> w;
+    fwn.eval(points, w);
+    wn.resize(w.size());
+    for(uint i=0; i<w.size(); ++i) wn[i] = static_cast<int>(round(w[i]));
 }
 
+}
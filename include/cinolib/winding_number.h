@@ -33,8 +33,8 @@
 *     16149 Genoa,                                                              *
 *     Italy                                                                     *
 *********************************************************************************/
-#ifndef CINO_VERTEX_MASS_H
-#define CINO_VERTEX_MASS_H
+#ifndef CINO_WINDING_NUMBER_H
+#define CINO_WINDING_NUMBER_H
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
 
@@ -65,10 +65,28 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int winding_number(const AbstractPolygonMesh<M,V,E,P> & m,
                    const vec3d                        & p);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// batched versions, for large sets of query points (e.g. inside/outside
+// classification of voxels). They use the fast winding number, which is exact
+// close to the surface and approximated far from it (see fast_winding_number.h)
+
+CINO_INLINE
+void winding_number(const std::vector<vec3d> & verts,
+                    const std::vector<uint>  & tris,
+                    const std::vector<vec3d> & points,
+                          std::vector<int>   & wn);
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void winding_number(const AbstractPolygonMesh<M,V,E,P> & m,
+                    const std::vector<vec3d>           & points,
+                          std::vector<int>             & wn);
 }
 
 #ifndef  CINO_STATIC_LIB
 #include "winding_number.cpp"
 #endif
 
-#endif // CINO_VERTEX_MASS_H
+#endif // CINO_WINDING_NUMBER_H